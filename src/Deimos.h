@@ -12,6 +12,12 @@
 #include "Deimos/Renderer/OrthographicCameraController.h"
 
 #include "Deimos/Core/Timestep.h"
+#include "Deimos/Core/FrameClock.h"
+#include "Deimos/Core/JobSystem.h"
+
+#include "Deimos/Debug/FrameStats.h"
+#include "Deimos/Debug/AllocationTracker.h"
+#include "Deimos/Debug/Replay.h"
 
 #include "Deimos/Renderer/Renderer.h"
 #include "Deimos/Renderer/Renderer2D.h"
@@ -22,5 +28,16 @@
 #include "Deimos/Renderer/VertexArray.h"
 
 #include "Deimos/Renderer/Texture.h"
+#include "Deimos/Renderer/SubTexture2D.h"
+#include "Deimos/Renderer/Image.h"
+#include "Deimos/Renderer/CompressedImage.h"
+#include "Deimos/Renderer/TextureAtlasBuilder.h"
+#include "Deimos/Renderer/TextureAtlas.h"
+#include "Deimos/Renderer/TextureLoader.h"
+#include "Deimos/Renderer/TextureCache.h"
+#include "Deimos/Renderer/UploadQueue.h"
+#include "Deimos/Renderer/Framebuffer.h"
+
+#include "Deimos/Assets/AssetPack.h"
 
 #endif //ENGINE_DEIMOS_H
@@ -0,0 +1,129 @@
+#include "dmpch.h"
+#include "AssetPack.h"
+
+#include "Deimos/Core/Hash.h"
+#include "Deimos/Renderer/CompressedImage.h"
+#include "Deimos/Renderer/MipmapGenerator.h"
+
+namespace Deimos {
+    AssetPack::AssetPack(Scope<MappedFile> file) : m_file(std::move(file)) {
+        m_header = (const AssetPackFormat::Header*) m_file->getData();
+        m_entries = (const AssetPackFormat::Entry*) (m_file->getData() + m_header->tocOffset);
+    }
+
+    Scope<AssetPack> AssetPack::open(const std::string &path) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        Scope<MappedFile> file = MappedFile::open(path);
+        if (!file)
+            return nullptr;
+
+        if (file->getSize() < sizeof(AssetPackFormat::Header)
+            || memcmp(file->getData(), AssetPackFormat::magic, sizeof(AssetPackFormat::magic)) != 0) {
+            DM_CORE_ERROR("'{0}' is not an asset pack", path);
+            return nullptr;
+        }
+
+        Scope<AssetPack> pack = createScope<AssetPack>(std::move(file));
+        if (!pack->validate(path))
+            return nullptr;
+
+        DM_CORE_INFO("Opened asset pack '{0}' with {1} entries", path, pack->getEntryCount());
+        return pack;
+    }
+
+    // format, width, height and level count, the view is taken of them without further checks
+    static bool isValidTexture(const AssetPackFormat::Entry &entry) {
+        uint32_t format = entry.params[0], width = entry.params[1], height = entry.params[2], levelCount = entry.params[3];
+        return format > (uint32_t) TextureFormat::None && format <= (uint32_t) TextureFormat::ETC2RGBA && width && height
+               && levelCount >= 1 && levelCount <= MipmapGenerator::getLevelCount(width, height);
+    }
+
+    // bounds are checked once here, lookups trust the table afterwards
+    bool AssetPack::validate(const std::string &path) const {
+        size_t fileSize = m_file->getSize();
+        if (m_header->version != AssetPackFormat::version) {
+            DM_CORE_ERROR("Asset pack '{0}' has version {1}, expected {2}", path, m_header->version, AssetPackFormat::version);
+            return false;
+        }
+
+        uint64_t tocSize = (uint64_t) m_header->entryCount * sizeof(AssetPackFormat::Entry);
+        if (m_header->tocOffset % alignof(AssetPackFormat::Entry) || m_header->tocOffset > fileSize
+            || tocSize > fileSize - m_header->tocOffset || m_header->namesOffset > fileSize) {
+            DM_CORE_ERROR("Asset pack '{0}' is truncated", path);
+            return false;
+        }
+
+        // written so none of the sums can overflow, the name needs its terminator inside the file
+        size_t namesSize = fileSize - m_header->namesOffset;
+        for (uint32_t i = 0; i < m_header->entryCount; ++i) {
+            const AssetPackFormat::Entry &entry = m_entries[i];
+            if (entry.offset > fileSize || entry.size > fileSize - entry.offset || entry.nameOffset >= namesSize
+                || !memchr(getName(entry), '\0', namesSize - entry.nameOffset)
+                || (i > 0 && m_entries[i - 1].nameHash >= entry.nameHash)) {
+                DM_CORE_ERROR("Asset pack '{0}' has a broken table of contents at entry {1}", path, i);
+                return false;
+            }
+            if (entry.type == AssetPackFormat::EntryType::Texture && !isValidTexture(entry)) {
+                DM_CORE_ERROR("Asset pack '{0}' has an invalid texture '{1}'", path, getName(entry));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const AssetPackFormat::Entry *AssetPack::find(const std::string &name) const {
+        uint64_t hash = fnv1a(name);
+        const AssetPackFormat::Entry *end = m_entries + m_header->entryCount;
+        const AssetPackFormat::Entry *it = std::lower_bound(m_entries, end, hash,
+            [](const AssetPackFormat::Entry &entry, uint64_t hash) { return entry.nameHash < hash; });
+
+        // the cooker rejects colliding names, but a name that isn't in the pack can still hit another's hash
+        if (it == end || it->nameHash != hash || strcmp(getName(*it), name.c_str()) != 0)
+            return nullptr;
+        return it;
+    }
+
+    const char *AssetPack::getName(const AssetPackFormat::Entry &entry) const {
+        return (const char*) m_file->getData() + m_header->namesOffset + entry.nameOffset;
+    }
+
+    Ref<Texture2D> AssetPack::loadTexture(const std::string &name, const TextureSpecification &spec) const {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        const AssetPackFormat::Entry *entry = find(name);
+        if (!entry || entry->type != AssetPackFormat::EntryType::Texture) {
+            DM_CORE_ERROR("Asset pack has no texture '{0}'", name);
+            return nullptr;
+        }
+
+        CompressedImage image = CompressedImage::view((TextureFormat) entry->params[0], entry->params[1], entry->params[2],
+                                                      entry->params[3], getData(*entry), (size_t) entry->size);
+        if (!image.isValid())
+            return nullptr;
+
+        Ref<Texture2D> texture = Texture2D::create(1, 1, spec);
+        texture->setCompressedImage(image);
+        return texture;
+    }
+
+    Ref<Shader> AssetPack::loadShader(const std::string &name) const {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        const AssetPackFormat::Entry *entry = find(name);
+        if (!entry || entry->type != AssetPackFormat::EntryType::Shader
+            || (uint64_t) entry->params[0] + entry->params[1] > entry->size) {
+            DM_CORE_ERROR("Asset pack has no shader '{0}'", name);
+            return nullptr;
+        }
+
+        // same naming as shaders loaded from files: "shaders/Texture.glsl" -> "Texture"
+        size_t begin = name.find_last_of('/') + 1;
+        size_t end = name.find_last_of('.');
+        std::string shaderName = name.substr(begin, end == std::string::npos || end < begin ? std::string::npos : end - begin);
+
+        const char *source = (const char*) getData(*entry);
+        return Shader::create(shaderName, std::string(source, entry->params[0]),
+                              std::string(source + entry->params[0], entry->params[1]));
+    }
+}
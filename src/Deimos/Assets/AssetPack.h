@@ -0,0 +1,42 @@
+#ifndef ENGINE_ASSETPACK_H
+#define ENGINE_ASSETPACK_H
+
+#include "AssetPackFormat.h"
+#include "Deimos/Core/MappedFile.h"
+#include "Deimos/Renderer/Texture.h"
+#include "Deimos/Renderer/Shader.h"
+
+namespace Deimos {
+    // Archive cooked by DeimosAssetCooker, mapped into memory as a whole. Lookups are a binary search over the
+    // name hashes, entry data is used in place: textures upload straight from the mapping without decoding
+    class AssetPack {
+    public:
+        AssetPack(Scope<MappedFile> file);
+
+        // nullptr if the file is missing or not a valid pack
+        static Scope<AssetPack> open(const std::string& path);
+
+        const AssetPackFormat::Entry* find(const std::string& name) const;
+        inline bool contains(const std::string& name) const { return find(name) != nullptr; }
+
+        // the bytes of the entry inside the mapping, valid as long as the pack is open
+        inline const uint8_t* getData(const AssetPackFormat::Entry& entry) const { return m_file->getData() + entry.offset; }
+        const char* getName(const AssetPackFormat::Entry& entry) const;
+
+        inline uint32_t getEntryCount() const { return m_header->entryCount; }
+        inline const AssetPackFormat::Entry& getEntry(uint32_t index) const { return m_entries[index]; }
+
+        // nullptr if the name is missing or not of that type
+        Ref<Texture2D> loadTexture(const std::string& name, const TextureSpecification& spec = TextureSpecification()) const;
+        Ref<Shader> loadShader(const std::string& name) const;
+    private:
+        bool validate(const std::string& path) const;
+    private:
+        Scope<MappedFile> m_file;
+        const AssetPackFormat::Header* m_header;
+        const AssetPackFormat::Entry* m_entries;
+    };
+}
+
+
+#endif //ENGINE_ASSETPACK_H
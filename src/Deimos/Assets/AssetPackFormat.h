@@ -0,0 +1,48 @@
+#ifndef ENGINE_ASSETPACKFORMAT_H
+#define ENGINE_ASSETPACKFORMAT_H
+
+#include <cstdint>
+
+// On disk layout of a .dmpak archive, written by DeimosAssetCooker and read by AssetPack.
+// Little endian, the header is followed by the entry data, then the table of contents and the names.
+// Every entry starts at a multiple of the alignment in the header
+namespace Deimos {
+    namespace AssetPackFormat {
+        static const char magic[4] = { 'D', 'M', 'P', 'K' };
+        static const uint32_t version = 1;
+        static const uint32_t defaultAlignment = 64;
+
+        enum class EntryType : uint32_t {
+            Raw = 0,
+            // levels of a TextureFormat one after another, level 0 first, bottom row first
+            Texture = 1,
+            // vertex source followed by fragment source, preprocessed and without terminators
+            Shader = 2
+        };
+
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t alignment;
+            uint64_t tocOffset; // Entry[entryCount], sorted by nameHash
+            uint64_t namesOffset; // null terminated names, Entry::nameOffset is relative to here
+        };
+
+        struct Entry {
+            uint64_t nameHash; // fnv1a of the name, names are paths relative to the cooked directory with '/'
+            uint64_t offset;
+            uint64_t size;
+            uint32_t nameOffset;
+            EntryType type;
+            // Texture: TextureFormat, width, height, level count. Shader: vertex source size, fragment source size
+            uint32_t params[4];
+        };
+
+        static_assert(sizeof(Header) == 32, "AssetPackFormat::Header must be packed");
+        static_assert(sizeof(Entry) == 48, "AssetPackFormat::Entry must be packed");
+    }
+}
+
+
+#endif //ENGINE_ASSETPACKFORMAT_H
@@ -5,8 +5,13 @@
 #include "spdlog/sinks/stdout_sinks.h"
 
 #include "Deimos/Renderer/Renderer.h"
+#include "Deimos/Renderer/TextureLoader.h"
+#include "Deimos/Renderer/TextureCache.h"
+#include "Deimos/Renderer/UploadQueue.h"
+#include "Deimos/Debug/FrameStats.h"
+#include "Deimos/Debug/AllocationTracker.h"
+#include "Deimos/Core/JobSystem.h"
 
-#include "GLFW/glfw3.h"
 #include <memory>
 
 namespace Deimos {
@@ -14,40 +19,72 @@ namespace Deimos {
 
     Application *Application::s_instance = nullptr;
 
-    Application::Application() {
-        DM_PROFILE_FUNCTION();
+    Application::Application(const WindowProps &props) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         DM_CORE_ASSERT(!s_instance, "Application already exists!");
         s_instance = this;
 
-        m_window = std::unique_ptr<Window>(Window::create());
+        m_window = std::unique_ptr<Window>(Window::create(props));
         m_window->setEventCallback(BIND_EVENT_FN(onEvent)); // set onEvent as the callback fun
         //m_window->setVSync(false);
+        JobSystem::init(); // first, the asset code splits its work over it
         Renderer::init();
+        UploadQueue::init(m_window->getContext());
+        FrameStats::init();
 
-        m_ImGuiLayer = new ImGuiLayer();
-        pushOverlay(m_ImGuiLayer);
+        // ImGui needs a GLFW window to attach to
+        if (!props.headless) {
+            m_ImGuiLayer = new ImGuiLayer();
+            pushOverlay(m_ImGuiLayer);
+        }
     }
 
     Application::~Application() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        // layers go first, they may still wait on jobs or use the renderer while detaching
+        m_layerStack.clear();
+        m_ImGuiLayer = nullptr;
+
+        FrameStats::shutdown();
+        AllocationTracker::logReport();
+        UploadQueue::shutdown();
+        Renderer::shutdown();
+        JobSystem::shutdown(); // last, the loader threads are joined by now
     }
 
     void Application::pushLayer(Layer *layer) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         m_layerStack.pushLayer(layer);
     }
 
     void Application::pushOverlay(Layer *overlay) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         m_layerStack.pushOverlay(overlay);
     }
 
+    void Application::setReplay(const ReplaySettings &settings) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        m_replay = createScope<ReplaySession>(settings);
+        if (!m_replay->isValid()) {
+            m_replay.reset();
+            m_exitCode = 2;
+            m_running = false;
+            return;
+        }
+        m_window->setVSync(false); // the timings are of the CPU, not the display
+    }
+
     // whenever event occurs, it calls this function
     void Application::onEvent(Event &e) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        if (m_replay && !m_replay->onLiveEvent(e))
+            return;
 
         EventDispatcher dispatcher(e);
         dispatcher.dispatch<WindowCloseEvent>(BIND_EVENT_FN(onWindowClose));
@@ -62,33 +99,88 @@ namespace Deimos {
     }
 
     void Application::run() {
-        DM_PROFILE_FUNCTION();
-
-        double currentTime = glfwGetTime();
-        double deltaTime = currentTime - m_lastFrameTime;
-        m_lastFrameTime = currentTime;
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
+        m_frameClock.reset();
         while (m_running) {
-            DM_PROFILE_SCOPE("RunLoop");
+            DM_PROFILE_CATEGORY_SCOPE(Core, "RunLoop");
+            FrameStats::beginFrame();
+            if (m_replay)
+                m_replay->beginFrame(*this);
+            Timestep deltaTime = m_replay ? m_frameClock.tick(m_replay->getTimestep()) : m_frameClock.tick();
+
+            JobSystem::update();
+            TextureLoader::update();
+            UploadQueue::update();
+            TextureCache::trim();
 
             if (!m_isMinimized) {
+                if (m_frameClock.getSubstepCount()) {
+                    DM_PROFILE_CATEGORY_SCOPE(Core, "LayerStack onFixedUpdate");
+                    m_fixedUpdateMs.assign(m_layerStack.end() - m_layerStack.begin(), 0.f);
+                    for (uint32_t step = 0; step < m_frameClock.getSubstepCount(); step++) {
+                        size_t index = 0;
+                        for (Layer *layer : m_layerStack) {
+                            FrameStats::Clock::time_point start = FrameStats::Clock::now();
+                            layer->onFixedUpdate(m_frameClock.getFixedStep());
+                            m_fixedUpdateMs[index++] += FrameStats::elapsedMilliseconds(start);
+                        }
+                    }
+                } else {
+                    m_fixedUpdateMs.clear();
+                }
+
                 {
-                    DM_PROFILE_SCOPE("LayerStack onUpdate");
-                    for (Layer *layer : m_layerStack)
+                    DM_PROFILE_CATEGORY_SCOPE(Core, "LayerStack onUpdate");
+                    DM_PROFILE_GPU_SCOPE("LayerStack onUpdate");
+                    size_t index = 0;
+                    for (Layer *layer : m_layerStack) {
+                        FrameStats::Clock::time_point start = FrameStats::Clock::now();
                         layer->onUpdate(deltaTime);
+                        // the layer's fixed steps count towards its update
+                        float fixedMs = index < m_fixedUpdateMs.size() ? m_fixedUpdateMs[index] : 0.f;
+                        FrameStats::recordLayerUpdate(layer, FrameStats::elapsedMilliseconds(start) + fixedMs);
+                        index++;
+                    }
                 }
             }
             
-            m_ImGuiLayer->begin();
-            {
-                DM_PROFILE_SCOPE("LayerStack onImGuiRender");
-                for (Layer *layer : m_layerStack)
-                    layer->onImGuiRender();
+            if (m_ImGuiLayer) {
+                m_ImGuiLayer->begin();
+                {
+                    DM_PROFILE_CATEGORY_SCOPE(Core, "LayerStack onImGuiRender");
+                    for (Layer *layer : m_layerStack) {
+                        FrameStats::Clock::time_point start = FrameStats::Clock::now();
+                        layer->onImGuiRender();
+                        FrameStats::recordLayerImGuiRender(layer, FrameStats::elapsedMilliseconds(start));
+                    }
+                }
+                m_ImGuiLayer->end();
             }
-            m_ImGuiLayer->end();
 
+            // polls events and swaps, with vsync mostly waiting for the swap
+            FrameStats::Clock::time_point swapStart = FrameStats::Clock::now();
             m_window->onUpdate();
+            FrameStats::recordSwapWait(FrameStats::elapsedMilliseconds(swapStart));
+
+            GPUProfiler::collect();
+            FrameStats::endFrame();
+            AllocationTracker::endFrame();
+            if (m_replay && !m_replay->endFrame())
+                m_running = false;
+            DM_PROFILE_FRAME();
+
+            // vsync already paces the swap, a replay runs as fast as it can
+            if (!m_window->isVSync() && !m_replay)
+                m_frameClock.limit();
+        }
+
+        if (m_replay) {
+            m_exitCode = m_replay->finish();
+            m_replay.reset();
         }
+
+        GPUProfiler::flush(); // the session ends right after run returns
     }
 
     bool Application::onWindowClose(WindowCloseEvent &e) {
@@ -97,7 +189,7 @@ namespace Deimos {
     }
 
     bool Application::onWindowResize(WindowResizeEvent &e) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
         if(e.getWidth() == 0 || e.getHeight() == 0) {
             m_isMinimized = true;
             return false;
@@ -10,6 +10,8 @@
 #include "Deimos/Renderer/VertexArray.h"
 #include "Deimos/Renderer/OrthographicCamera.h"
 #include "Deimos/Core/Timestep.h"
+#include "Deimos/Core/FrameClock.h"
+#include "Deimos/Debug/Replay.h"
 
 extern int main(int argc, char** argv);
 
@@ -17,7 +19,7 @@ namespace Deimos {
 
     class DM_API Application {
     public:
-        Application();
+        Application(const WindowProps& props = WindowProps());
         virtual ~Application();
 
         void onEvent(Event& e);
@@ -25,7 +27,13 @@ namespace Deimos {
         void pushLayer(Layer* layer);
         void pushOverlay(Layer* overlay);
 
+        // runs the next run() from a script with a fixed timestep, see ReplaySession
+        void setReplay(const ReplaySettings& settings);
+        inline int getExitCode() const { return m_exitCode; }
+
         inline Window& getWindow() { return *m_window; }
+        // fixed step, interpolation alpha and frame rate limit
+        inline FrameClock& getFrameClock() { return m_frameClock; }
         inline static Application& get() { return *s_instance; }
     private:
         friend int ::main(int argc, char** argv);
@@ -37,12 +45,16 @@ namespace Deimos {
         std::unique_ptr<Window> m_window;
 
         LayerStack m_layerStack;
-        ImGuiLayer* m_ImGuiLayer;
+        ImGuiLayer* m_ImGuiLayer = nullptr; // not created for headless windows
 
-        Timestep m_lastFrameTime = 0.f;
+        FrameClock m_frameClock;
+        std::vector<float> m_fixedUpdateMs; // per layer, this frame
 
         bool m_running = true;
         bool m_isMinimized = false;
+
+        Scope<ReplaySession> m_replay;
+        int m_exitCode = 0;
     private:
         static Application* s_instance;
     };
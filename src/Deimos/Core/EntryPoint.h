@@ -7,18 +7,34 @@ extern Deimos::Application* Deimos::createApplication();
 
 int main(int argc, char **argv) {
     Deimos::Log::init();
+    DM_PROFILE_THREAD_NAME("Main");
 
     DM_PROFILE_BEGIN_SESSION("Startup",  std::string(DEBUG_DIR) + "/DebugInfo/DeimosProfile-Startup.json");
     auto app = Deimos::createApplication();
     DM_PROFILE_END_SESSION();
 
+    Deimos::ReplaySettings replay;
+    if (Deimos::ReplaySettings::parseCommandLine(argc, argv, replay))
+        app->setReplay(replay);
+
+#ifdef DM_FLIGHT_RECORDER
+    // only the seconds before a hitch are kept, so it can stay on for as long as the game runs
+    Deimos::FlightRecorderSettings flightRecorder;
+    flightRecorder.directory = std::string(DEBUG_DIR) + "/DebugInfo";
+    DM_PROFILE_BEGIN_FLIGHT_RECORDER(flightRecorder);
+    app->run();
+    DM_PROFILE_END_FLIGHT_RECORDER();
+#else
     DM_PROFILE_BEGIN_SESSION("Runtime",  std::string(DEBUG_DIR) + "/DebugInfo/DeimosProfile-Runtime.json");
     app->run();
     DM_PROFILE_END_SESSION();
+#endif
 
     DM_PROFILE_BEGIN_SESSION("Shutdown",  std::string(DEBUG_DIR) + "/DebugInfo/DeimosProfile-Shutdown.json");
+    int exitCode = app->getExitCode();
     delete app;
     DM_PROFILE_END_SESSION();
+    return exitCode;
 }
 
 //#endif
@@ -0,0 +1,113 @@
+#include "dmpch.h"
+#include "FrameClock.h"
+
+#include <cmath>
+#include <thread>
+
+namespace Deimos {
+    FrameClock::FrameClock() {
+        reset();
+    }
+
+    void FrameClock::reset() {
+        m_lastTick = Clock::now();
+        m_nextFrame = m_lastTick;
+        m_delta = 0.f;
+        m_time = 0.0;
+        m_frameCount = 0;
+        m_accumulator = 0.0;
+        m_substeps = 0;
+        m_alpha = 0.f;
+    }
+
+    Timestep FrameClock::tick() {
+        Clock::time_point now = Clock::now();
+        double delta = std::chrono::duration<double>(now - m_lastTick).count();
+        m_lastTick = now;
+        return advance(std::min(delta, (double) m_maxDelta));
+    }
+
+    Timestep FrameClock::tick(Timestep delta) {
+        m_lastTick = Clock::now();
+        return advance(delta.getSeconds());
+    }
+
+    Timestep FrameClock::advance(double delta) {
+        m_delta = (float) delta;
+        m_time += delta;
+        m_frameCount++;
+
+        if (m_fixedStep <= 0.f) {
+            m_substeps = 0;
+            m_alpha = 0.f;
+            return m_delta;
+        }
+
+        m_accumulator += delta;
+        double steps = std::floor(m_accumulator / m_fixedStep);
+        m_substeps = (uint32_t) std::min(steps, (double) m_maxSubsteps);
+        m_accumulator -= m_substeps * (double) m_fixedStep;
+        if (steps > m_maxSubsteps)
+            m_accumulator = std::fmod(m_accumulator, (double) m_fixedStep); // behind, drop what didn't fit
+        m_alpha = (float) (m_accumulator / m_fixedStep);
+        return m_delta;
+    }
+
+    void FrameClock::setMaxDelta(float seconds) {
+        m_maxDelta = std::max(seconds, 1e-3f);
+    }
+
+    void FrameClock::setFixedStep(float seconds, uint32_t maxSubsteps) {
+        m_fixedStep = std::max(seconds, 0.f);
+        m_maxSubsteps = std::max(maxSubsteps, 1u);
+        m_accumulator = 0.0;
+        m_substeps = 0;
+        m_alpha = 0.f;
+    }
+
+    void FrameClock::setFrameRateLimit(float framesPerSecond) {
+        m_frameRateLimit = std::max(framesPerSecond, 0.f);
+        m_nextFrame = Clock::now();
+    }
+
+    void FrameClock::limit() {
+        if (m_frameRateLimit <= 0.f)
+            return;
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        // paced from the previous deadline rather than from now, so the rate holds on average; after a
+        // frame that took longer than a whole period the pacing starts over instead of catching up
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_frameRateLimit));
+        Clock::time_point now = Clock::now();
+        m_nextFrame += period;
+        if (m_nextFrame < now - period)
+            m_nextFrame = now;
+        if (m_nextFrame > now)
+            sleepPrecise(m_nextFrame);
+    }
+
+    // Sleeps in 1 ms slices while the remaining wait is longer than a slice is expected to take (the mean plus a
+    // standard deviation of the measured slices, schedulers overshoot), then spins the last stretch
+    void FrameClock::sleepPrecise(Clock::time_point deadline) {
+        while (true) {
+            double remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+            double estimate = m_sleepMean + std::sqrt(m_sleepVariance);
+            if (remaining <= estimate)
+                break;
+
+            Clock::time_point start = Clock::now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            double slept = std::chrono::duration<double>(Clock::now() - start).count();
+
+            // running mean and variance, weighted towards the last hundred slices once there are that many
+            m_sleepSamples = std::min(m_sleepSamples + 1, 100u);
+            double weight = 1.0 / m_sleepSamples;
+            double difference = slept - m_sleepMean;
+            m_sleepMean += weight * difference;
+            m_sleepVariance = (1.0 - weight) * (m_sleepVariance + weight * difference * difference);
+        }
+
+        while (Clock::now() < deadline)
+            std::this_thread::yield();
+    }
+}
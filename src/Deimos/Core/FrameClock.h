@@ -0,0 +1,77 @@
+#ifndef ENGINE_FRAMECLOCK_H
+#define ENGINE_FRAMECLOCK_H
+
+#include "Core.h"
+#include "Timestep.h"
+
+#include <chrono>
+
+namespace Deimos {
+    // Times the run loop on the monotonic clock. tick starts a frame and measures the delta since the previous one;
+    // with a fixed step set, the deltas are accumulated and each frame runs however many whole steps fit, the
+    // remainder becomes the interpolation alpha between the last two simulated states. The optional frame rate
+    // limit sleeps out the rest of the frame when vsync doesn't pace it
+    class FrameClock {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        FrameClock();
+
+        // the next tick measures from now
+        void reset();
+
+        Timestep tick();
+        // advances by the given delta instead of the measured one, for replays
+        Timestep tick(Timestep delta);
+
+        inline Timestep getDelta() const { return m_delta; }
+        // seconds since reset, of the current frame's start
+        inline double getTime() const { return m_time; }
+        inline uint64_t getFrameCount() const { return m_frameCount; }
+
+        // longer deltas are clamped, after a breakpoint or a dragged window (0.25 s)
+        void setMaxDelta(float seconds);
+
+        // 0 turns the fixed step off. At most maxSubsteps run per frame, time beyond them is dropped so a slow
+        // frame can't make the next ones slower still
+        void setFixedStep(float seconds, uint32_t maxSubsteps = 8);
+        inline bool isFixedStepEnabled() const { return m_fixedStep > 0.f; }
+        inline Timestep getFixedStep() const { return m_fixedStep; }
+        // steps due this frame
+        inline uint32_t getSubstepCount() const { return m_substeps; }
+        // how far the current frame is between the last simulated state and the next, in [0, 1)
+        inline float getInterpolationAlpha() const { return m_alpha; }
+
+        // 0 removes the limit
+        void setFrameRateLimit(float framesPerSecond);
+        inline float getFrameRateLimit() const { return m_frameRateLimit; }
+        // waits until the frame's period is over
+        void limit();
+    private:
+        Timestep advance(double delta);
+        void sleepPrecise(Clock::time_point deadline);
+    private:
+        Clock::time_point m_lastTick;
+        Timestep m_delta = 0.f;
+        double m_time = 0.0;
+        uint64_t m_frameCount = 0;
+        float m_maxDelta = 0.25f;
+
+        float m_fixedStep = 0.f;
+        uint32_t m_maxSubsteps = 8;
+        double m_accumulator = 0.0;
+        uint32_t m_substeps = 0;
+        float m_alpha = 0.f;
+
+        float m_frameRateLimit = 0.f;
+        Clock::time_point m_nextFrame;
+
+        // how long sleeping for a millisecond actually takes, the rest of a wait is spun
+        double m_sleepMean = 1e-3;
+        double m_sleepVariance = 0.0;
+        uint32_t m_sleepSamples = 1;
+    };
+}
+
+
+#endif //ENGINE_FRAMECLOCK_H
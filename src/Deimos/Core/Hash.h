@@ -0,0 +1,26 @@
+#ifndef ENGINE_HASH_H
+#define ENGINE_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Deimos {
+    // 64 bit FNV-1a, stable across runs and platforms so it can be stored in files. Pass a previous result
+    // as hash to continue over more data
+    inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+        const uint8_t* bytes = (const uint8_t*) data;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    inline uint64_t fnv1a(const std::string& str) {
+        return fnv1a(str.data(), str.size());
+    }
+}
+
+
+#endif //ENGINE_HASH_H
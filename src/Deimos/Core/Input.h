@@ -14,6 +14,9 @@ namespace DM_API Deimos {
         inline static std::pair<float, float> getMousePosition() { return s_instance->getMousePositionImpl(); }
         inline static float getMouseX() { return s_instance->getMouseXImpl(); }
         inline static float getMouseY() { return s_instance->getMouseYImpl(); }
+
+        // replaces the platform's implementation, e.g. with scripted input, and returns the previous one
+        inline static Scope<Input> setInstance(Scope<Input> input) { s_instance.swap(input); return input; }
     protected:
         Input() = default;
     protected:
@@ -0,0 +1,389 @@
+#include "dmpch.h"
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace Deimos {
+    struct Job {
+        JobSystem::JobFn fn;
+        JobCounter *counter;
+        bool mainThread;
+    };
+
+    // Chase-Lev deque with the memory orders of Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+    // Models". The owner pushes and pops at the bottom, thieves take from the top. Fixed size, a full deque
+    // sends jobs to the shared queue instead
+    class JobDeque {
+    public:
+        static const int64_t s_capacity = 4096; // power of two
+
+        bool push(Job *job) {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_acquire);
+            if (bottom - top >= s_capacity)
+                return false;
+
+            m_jobs[bottom & (s_capacity - 1)].store(job, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_release); // publishes the slot to thieves
+            return true;
+        }
+
+        Job *pop() {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) { // empty
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job *job = m_jobs[bottom & (s_capacity - 1)].load(std::memory_order_relaxed);
+            if (top == bottom) { // the last one, a thief may be taking it
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job *steal() {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+                return nullptr;
+
+            Job *job = m_jobs[top & (s_capacity - 1)].load(std::memory_order_relaxed);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr; // lost to the owner or another thief
+            return job;
+        }
+    private:
+        alignas(64) std::atomic<int64_t> m_top{ 0 };
+        alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+        std::atomic<Job*> m_jobs[s_capacity] = {};
+    };
+
+    // the parts that work on counters
+    struct JobScheduler {
+        static void submit(JobSystem::JobFn fn, JobCounter *counter, JobCounter *dependency, bool mainThread);
+        static void finish(Job *job);
+    };
+
+    struct JobSystemData {
+        bool initialized = false;
+        std::vector<Scope<JobDeque>> deques; // [0] belongs to the main thread
+        std::vector<std::thread> workers;
+
+        // jobs from threads without a deque, and from a full one
+        std::mutex sharedMutex;
+        std::deque<Job*> shared;
+        std::atomic<uint32_t> sharedCount{ 0 };
+
+        std::mutex mainMutex;
+        std::deque<Job*> mainThreadJobs;
+
+        // submitted and not finished, the ones waiting on a dependency included
+        std::atomic<uint32_t> outstanding{ 0 };
+
+        // idle workers sleep until a job is pushed. The epoch changes with every wake up, so a job pushed between
+        // a worker's last look and its wait isn't missed
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        uint64_t wakeEpoch = 0;
+        std::atomic<uint32_t> sleeping{ 0 };
+        bool stopping = false;
+    };
+
+    static JobSystemData s_jobData;
+    static thread_local int32_t s_threadIndex = -1;
+
+    // jobs of one parallelFor per thread and then some, so a slow chunk doesn't hold up the rest
+    static const uint32_t s_chunksPerThread = 4;
+
+    JobCounter::~JobCounter() {
+        // the job that brought the count to zero may still hold the lock
+        std::lock_guard<std::mutex> lock(m_mutex);
+        DM_CORE_ASSERT(m_pending == 0 && m_dependents.empty(), "JobCounter destroyed while its jobs are pending!");
+    }
+
+    static void wakeWorker() {
+        std::atomic_thread_fence(std::memory_order_seq_cst); // the push is visible before sleeping is read
+        if (s_jobData.sleeping.load(std::memory_order_seq_cst) == 0)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(s_jobData.sleepMutex);
+            s_jobData.wakeEpoch++;
+        }
+        s_jobData.wake.notify_one();
+    }
+
+    // the job's dependency is done, it goes where it can run
+    static void schedule(Job *job) {
+        if (job->mainThread) {
+            std::lock_guard<std::mutex> lock(s_jobData.mainMutex);
+            s_jobData.mainThreadJobs.push_back(job);
+            return;
+        }
+
+        if (s_threadIndex < 0 || !s_jobData.deques[s_threadIndex]->push(job)) {
+            std::lock_guard<std::mutex> lock(s_jobData.sharedMutex);
+            s_jobData.shared.push_back(job);
+            s_jobData.sharedCount.fetch_add(1, std::memory_order_seq_cst);
+        }
+        wakeWorker();
+    }
+
+    void JobScheduler::submit(JobSystem::JobFn fn, JobCounter *counter, JobCounter *dependency, bool mainThread) {
+        DM_CORE_ASSERT(s_jobData.initialized, "JobSystem is not initialized!");
+
+        Job *job = new Job{ std::move(fn), counter, mainThread };
+        s_jobData.outstanding.fetch_add(1, std::memory_order_relaxed);
+        if (counter)
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+        if (dependency) {
+            std::lock_guard<std::mutex> lock(dependency->m_mutex);
+            if (dependency->m_pending.load(std::memory_order_acquire) != 0) {
+                dependency->m_dependents.push_back(job);
+                return;
+            }
+        }
+        schedule(job);
+    }
+
+    void JobScheduler::finish(Job *job) {
+        JobCounter *counter = job->counter;
+        delete job;
+        if (!counter)
+            return;
+
+        // no lock while other jobs of the counter remain
+        uint32_t pending = counter->m_pending.load(std::memory_order_relaxed);
+        while (pending > 1) {
+            if (counter->m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return;
+        }
+
+        // possibly the last one. A waiter may destroy the counter as soon as it reads zero, the destructor
+        // takes the lock first, so the counter stays valid until this is done with it
+        std::vector<Job*> released;
+        {
+            std::lock_guard<std::mutex> lock(counter->m_mutex);
+            if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                released.swap(counter->m_dependents);
+        }
+        for (Job *dependent : released)
+            schedule(dependent);
+    }
+
+    static void execute(Job *job) {
+        job->fn();
+        JobScheduler::finish(job);
+        s_jobData.outstanding.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    static Job *findJob(int32_t index) {
+        if (index >= 0) {
+            if (Job *job = s_jobData.deques[index]->pop())
+                return job;
+        }
+
+        if (s_jobData.sharedCount.load(std::memory_order_seq_cst) != 0) {
+            std::lock_guard<std::mutex> lock(s_jobData.sharedMutex);
+            if (!s_jobData.shared.empty()) {
+                Job *job = s_jobData.shared.front();
+                s_jobData.shared.pop_front();
+                s_jobData.sharedCount.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        // a different first victim per thief, so they don't all crowd the same deque
+        uint32_t count = (uint32_t) s_jobData.deques.size();
+        uint32_t start = (uint32_t) (index + 1) * 0x9E3779B9u;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t victim = (start + i) % count;
+            if ((int32_t) victim == index)
+                continue;
+            if (Job *job = s_jobData.deques[victim]->steal())
+                return job;
+        }
+        return nullptr;
+    }
+
+    // main thread jobs queued up to now, the ones they queue run next time
+    static bool runMainThreadJobs() {
+        std::deque<Job*> jobs;
+        {
+            std::lock_guard<std::mutex> lock(s_jobData.mainMutex);
+            jobs.swap(s_jobData.mainThreadJobs);
+        }
+        for (Job *job : jobs)
+            execute(job);
+        return !jobs.empty();
+    }
+
+    static void workerLoop(int32_t index) {
+        s_threadIndex = index;
+        DM_PROFILE_THREAD_NAME("Job worker " + std::to_string(index));
+
+        while (true) {
+            if (Job *job = findJob(index)) {
+                execute(job);
+                continue;
+            }
+
+            // registered as sleeping before the last look, a push after it sees the worker and wakes it
+            s_jobData.sleeping.fetch_add(1, std::memory_order_seq_cst);
+            uint64_t epoch;
+            {
+                std::lock_guard<std::mutex> lock(s_jobData.sleepMutex);
+                epoch = s_jobData.wakeEpoch;
+            }
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (Job *job = findJob(index)) {
+                s_jobData.sleeping.fetch_sub(1, std::memory_order_seq_cst);
+                execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(s_jobData.sleepMutex);
+            s_jobData.wake.wait(lock, [epoch] { return s_jobData.stopping || s_jobData.wakeEpoch != epoch; });
+            s_jobData.sleeping.fetch_sub(1, std::memory_order_seq_cst);
+            if (s_jobData.stopping)
+                return;
+        }
+    }
+
+    void JobSystem::init(uint32_t workerCount) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        if (workerCount == 0)
+            workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+        s_threadIndex = 0;
+        s_jobData.stopping = false;
+        s_jobData.deques.clear();
+        for (uint32_t i = 0; i <= workerCount; i++)
+            s_jobData.deques.push_back(createScope<JobDeque>());
+        s_jobData.initialized = true;
+
+        s_jobData.workers.reserve(workerCount);
+        for (uint32_t i = 1; i <= workerCount; i++)
+            s_jobData.workers.emplace_back(workerLoop, (int32_t) i);
+        DM_CORE_INFO("JobSystem: {0} workers", workerCount);
+    }
+
+    void JobSystem::shutdown() {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        if (!s_jobData.initialized)
+            return;
+
+        // the queued jobs still run, whoever submitted them may wait on their counters. Jobs they queue in
+        // turn are counted too, so this returns once everything reachable is done
+        while (s_jobData.outstanding.load(std::memory_order_acquire) != 0) {
+            if (runMainThreadJobs())
+                continue;
+
+            if (Job *job = findJob(s_threadIndex))
+                execute(job);
+            else
+                std::this_thread::yield();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s_jobData.sleepMutex);
+            s_jobData.stopping = true;
+        }
+        s_jobData.wake.notify_all();
+        for (std::thread &worker : s_jobData.workers)
+            worker.join();
+        s_jobData.workers.clear();
+
+        DM_CORE_ASSERT(s_jobData.shared.empty() && s_jobData.mainThreadJobs.empty(), "JobSystem stopped with jobs queued!");
+        s_jobData.deques.clear();
+        s_jobData.initialized = false;
+    }
+
+    void JobSystem::run(JobFn job, JobCounter *counter, JobCounter *dependency) {
+        JobScheduler::submit(std::move(job), counter, dependency, false);
+    }
+
+    void JobSystem::runOnMainThread(JobFn job, JobCounter *counter, JobCounter *dependency) {
+        JobScheduler::submit(std::move(job), counter, dependency, true);
+    }
+
+    void JobSystem::wait(const JobCounter &counter) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        while (!counter.isDone()) {
+            // the main thread jobs have nowhere else to run
+            if (s_threadIndex == 0 && runMainThreadJobs())
+                continue;
+
+            if (Job *job = findJob(s_threadIndex))
+                execute(job);
+            else
+                std::this_thread::yield(); // the last jobs are running elsewhere
+        }
+    }
+
+    static uint32_t chunkSizeFor(uint32_t count, uint32_t minChunkSize) {
+        uint32_t chunks = std::max(1u, JobSystem::getThreadCount() * s_chunksPerThread);
+        return std::max(std::max(minChunkSize, 1u), (count + chunks - 1) / chunks);
+    }
+
+    void JobSystem::parallelFor(uint32_t count, const RangeFn &fn, uint32_t minChunkSize) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        uint32_t chunkSize = chunkSizeFor(count, minChunkSize);
+        if (count <= chunkSize) {
+            if (count)
+                fn(0, count);
+            return;
+        }
+
+        // the first chunk stays here, fn outlives the jobs since this waits for them
+        JobCounter counter;
+        for (uint32_t begin = chunkSize; begin < count; begin += chunkSize) {
+            uint32_t end = std::min(begin + chunkSize, count);
+            run([&fn, begin, end]() { fn(begin, end); }, &counter);
+        }
+        fn(0, chunkSize);
+        wait(counter);
+    }
+
+    void JobSystem::parallelFor(uint32_t count, RangeFn fn, JobCounter &counter, uint32_t minChunkSize) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        uint32_t chunkSize = chunkSizeFor(count, minChunkSize);
+        if (count == 0)
+            return;
+
+        auto shared = std::make_shared<RangeFn>(std::move(fn));
+        for (uint32_t begin = 0; begin < count; begin += chunkSize) {
+            uint32_t end = std::min(begin + chunkSize, count);
+            run([shared, begin, end]() { (*shared)(begin, end); }, &counter);
+        }
+    }
+
+    void JobSystem::update() {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        runMainThreadJobs();
+    }
+
+    uint32_t JobSystem::getThreadCount() {
+        return (uint32_t) s_jobData.deques.size();
+    }
+
+    int32_t JobSystem::getThreadIndex() {
+        return s_threadIndex;
+    }
+}
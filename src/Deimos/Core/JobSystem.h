@@ -0,0 +1,76 @@
+#ifndef ENGINE_JOBSYSTEM_H
+#define ENGINE_JOBSYSTEM_H
+
+#include "Core.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Deimos {
+    struct Job;
+    struct JobScheduler;
+
+    // Counts the unfinished jobs given to it. Jobs can wait on a counter with JobSystem::wait, or be made to start
+    // only once it reaches zero. Has to outlive its jobs
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        ~JobCounter();
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        inline bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+        inline uint32_t getPending() const { return m_pending.load(std::memory_order_acquire); }
+    private:
+        friend struct JobScheduler;
+
+        std::atomic<uint32_t> m_pending{ 0 };
+        std::mutex m_mutex;
+        std::vector<Job*> m_dependents; // released when m_pending drops to zero
+    };
+
+    // Frame work spread over every core: each worker owns a deque it pushes to and pops from, idle workers steal
+    // the oldest jobs of the others. The main thread takes part whenever it waits. Jobs that touch GL run on the
+    // main thread only, in update or in a wait there. Jobs are plain std::function, keep the captures small.
+    // The asset loaders keep their own ThreadPool, long blocking reads don't belong in here
+    class JobSystem {
+    public:
+        using JobFn = std::function<void()>;
+        using RangeFn = std::function<void(uint32_t begin, uint32_t end)>;
+
+        // from the main thread, 0 workers - one per hardware thread except the main one
+        static void init(uint32_t workerCount = 0);
+        // from the main thread, runs every queued job (the main thread ones too) to completion before the
+        // workers stop
+        static void shutdown();
+
+        // counter, when given, counts the job until it finishes. With a dependency the job starts once the
+        // dependency's jobs are all done
+        static void run(JobFn job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+        // same, but the job runs on the main thread, for anything that touches the GL context
+        static void runOnMainThread(JobFn job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+        // works on other jobs until the counter reaches zero, safe to call from inside a job
+        static void wait(const JobCounter& counter);
+
+        // fn over [0, count), split into chunks of at least minChunkSize, a few per thread so uneven chunks still
+        // balance out. The first blocks until all of them are done and runs chunks itself, the second returns
+        // right away and counts the chunks in counter
+        static void parallelFor(uint32_t count, const RangeFn& fn, uint32_t minChunkSize = 1);
+        static void parallelFor(uint32_t count, RangeFn fn, JobCounter& counter, uint32_t minChunkSize = 1);
+
+        // main thread, once per frame: runs the main thread jobs queued so far
+        static void update();
+
+        // workers plus the main thread
+        static uint32_t getThreadCount();
+        // 0 on the main thread, 1 to getThreadCount() - 1 on the workers, -1 elsewhere. For per-thread scratch data
+        static int32_t getThreadIndex();
+    };
+}
+
+
+#endif //ENGINE_JOBSYSTEM_H
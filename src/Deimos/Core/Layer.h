@@ -14,6 +14,7 @@ namespace Deimos {
         virtual void onAttach() {}; // add to LayerStack
         virtual void onDetach() {}; // remove from the LayerStack
         virtual void onUpdate(Deimos::Timestep timestep) {};
+        virtual void onFixedUpdate(Deimos::Timestep /*step*/) {}; // per fixed step, when the frame clock has one
         virtual void onImGuiRender() {};
         virtual void onEvent(Event& event) {};
 
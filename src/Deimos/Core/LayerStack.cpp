@@ -1,16 +1,25 @@
 #include "LayerStack.h"
 #include "dmpch.h"
 
+#include "Deimos/Debug/FrameStats.h"
+
 // LayerStack is like a wrapper for a vector of layers
 namespace Deimos {
     LayerStack::LayerStack() {
     }
 
     LayerStack::~LayerStack() {
+        clear();
+    }
+
+    void LayerStack::clear() {
         for (Layer *layer: m_layers){
             layer->onDetach();
+            FrameStats::removeLayer(layer);
             delete layer;
         }
+        m_layers.clear();
+        m_layerInsertIndex = 0;
     }
 
     void LayerStack::pushLayer(Layer *layer) {
@@ -30,15 +39,18 @@ namespace Deimos {
         if (it != m_layers.begin() + m_layerInsertIndex) {
             // if the element was not found - returns last
             layer->onDetach();
+            FrameStats::removeLayer(layer);
             m_layers.erase(it);
             --m_layerInsertIndex;
         }
     }
 
     void LayerStack::popOverlay(Layer *overlay) {
-        auto it = std::find(m_layers.begin(), m_layers.begin() + m_layerInsertIndex, overlay);
-        if (it != m_layers.end())
+        auto it = std::find(m_layers.begin() + m_layerInsertIndex, m_layers.end(), overlay);
+        if (it != m_layers.end()) {
             overlay->onDetach();
+            FrameStats::removeLayer(overlay);
             m_layers.erase(it);
+        }
     }
 }
@@ -16,6 +16,8 @@ namespace Deimos
         void pushOverlay(Layer* overlay);
         void popLayer(Layer* layer);
         void popOverlay(Layer* overlay);
+        // detaches and deletes every layer
+        void clear();
 
         std::vector<Layer*>::iterator begin() { return m_layers.begin(); } // to be able to use foreach
         std::vector<Layer*>::iterator end() { return m_layers.end(); }
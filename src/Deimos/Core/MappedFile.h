@@ -0,0 +1,21 @@
+#ifndef ENGINE_MAPPEDFILE_H
+#define ENGINE_MAPPEDFILE_H
+
+#include "Core.h"
+
+namespace Deimos {
+    // Read only view of a whole file in the address space, pages are loaded by the OS on first access
+    class MappedFile {
+    public:
+        virtual ~MappedFile() = default;
+
+        virtual const uint8_t* getData() const = 0;
+        virtual size_t getSize() const = 0;
+
+        // nullptr if the file can't be opened or mapped
+        static Scope<MappedFile> open(const std::string& path);
+    };
+}
+
+
+#endif //ENGINE_MAPPEDFILE_H
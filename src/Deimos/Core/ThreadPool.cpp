@@ -0,0 +1,52 @@
+#include "dmpch.h"
+#include "ThreadPool.h"
+
+namespace Deimos {
+    static const uint32_t s_defaultThreadCount = 2;
+
+    ThreadPool::ThreadPool(uint32_t threadCount) {
+        if (threadCount == 0)
+            threadCount = std::min(std::max(2u, std::thread::hardware_concurrency()) - 1, s_defaultThreadCount);
+
+        m_workers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i)
+            m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+
+        for (std::thread &worker : m_workers)
+            worker.join();
+    }
+
+    void ThreadPool::submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_condition.notify_one();
+    }
+
+    void ThreadPool::workerLoop(uint32_t index) {
+        DM_PROFILE_THREAD_NAME("Worker " + std::to_string(index));
+
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if (m_stopping) // tasks still queued are dropped
+                    return;
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+}
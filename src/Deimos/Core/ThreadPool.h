@@ -0,0 +1,40 @@
+#ifndef ENGINE_THREADPOOL_H
+#define ENGINE_THREADPOOL_H
+
+#include "Core.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Deimos {
+    // Fixed set of worker threads consuming a FIFO of tasks. Meant for work that blocks, file reads and the decodes
+    // that follow them; CPU-bound splits go to JobSystem::parallelFor, which already has a thread per core
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        // 0 - a couple of threads, enough to keep reads going without competing with the job system for the cores
+        ThreadPool(uint32_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void submit(Task task);
+
+        inline uint32_t getThreadCount() const { return (uint32_t) m_workers.size(); }
+    private:
+        void workerLoop(uint32_t index);
+    private:
+        std::vector<std::thread> m_workers;
+        std::deque<Task> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopping = false;
+    };
+}
+
+
+#endif //ENGINE_THREADPOOL_H
@@ -3,6 +3,7 @@
 
 #include "Core.h"
 #include "Deimos/Events/Event.h"
+#include "Deimos/Renderer/GraphicsContext.h"
 
 namespace Deimos {
 
@@ -10,9 +11,11 @@ namespace Deimos {
         std::string title;
         unsigned int width;
         unsigned int height;
+        bool headless; // render offscreen without a display, e.g. for benchmarks on CI machines. Linux only (EGL)
 
-        WindowProps(const std::string &title = "Deimos Engine", unsigned int width = 1280, unsigned int height = 720)
-                : title(title), width(width), height(height) {
+        WindowProps(const std::string &title = "Deimos Engine", unsigned int width = 1280, unsigned int height = 720,
+                    bool headless = false)
+                : title(title), width(width), height(height), headless(headless) {
         }
     };
 
@@ -36,7 +39,11 @@ namespace Deimos {
         // return void pointer to not depend on GLFW library
         virtual void* getNativeWindow() const = 0;
 
+        virtual GraphicsContext& getContext() = 0;
+
         static Window* create(const WindowProps& props = WindowProps());
+        // whether a headless window can be created, so callers (tests, CI tools) can skip GL work instead of failing
+        static bool isHeadlessAvailable();
     };
 }
 
@@ -0,0 +1,260 @@
+#include "dmpch.h"
+#include "AllocationTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace Deimos {
+    const char *AllocationTracker::getTagName(uint32_t tagIndex) {
+        if (tagIndex == 0 || tagIndex >= s_allocationTagCount)
+            return "untagged";
+        return getProfileCategoryName((ProfileCategory) (1u << (tagIndex - 1)));
+    }
+}
+
+#ifdef DM_TRACK_ALLOCATIONS
+namespace Deimos {
+    // Everything below runs inside operator new, so none of it may allocate: the counters are fixed arrays of
+    // atomics, constant initialized before any constructor can call new
+
+    struct TagCounters {
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> bytes{ 0 };
+    };
+
+    // keyed by the scope name pointer, every profile scope name is a literal or interned
+    struct ScopeSlot {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<uint8_t> tag{ 0 };
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> bytes{ 0 };
+    };
+
+    static const uint32_t s_scopeSlotCount = 4096; // power of two
+    static const uint32_t s_maxProbes = 64;
+
+    static TagCounters s_frameTags[s_allocationTagCount]; // since the last endFrame
+    static std::atomic<uint64_t> s_frameFrees{ 0 };
+    static std::atomic<int64_t> s_liveBytes{ 0 };
+    static ScopeSlot s_scopeSlots[s_scopeSlotCount];
+    static ScopeSlot s_unscoped;  // no scope active
+    static ScopeSlot s_overflow;  // the table is full
+
+    // main thread, endFrame
+    static AllocationFrameStats s_lastFrame;
+    static int64_t s_frameStart = 0;
+
+    static const char *s_tagCounterNames[s_allocationTagCount] = {
+        "Heap allocations [untagged]", "Heap allocations [core]", "Heap allocations [renderer]",
+        "Heap allocations [gl]", "Heap allocations [assets]", "Heap allocations [user]"
+    };
+
+    // sits right before the pointer handed out
+    struct AllocationHeader {
+        void *block; // what malloc returned
+        size_t size;
+    };
+
+    static inline uint32_t tagIndexOf(uint8_t tag) {
+        if (tag == 0)
+            return 0;
+        uint32_t bit = 0; // the lowest set bit, tags are a handful of bits wide
+        while (!(tag & (1u << bit)))
+            bit++;
+        return std::min<uint32_t>(bit + 1, s_allocationTagCount - 1);
+    }
+
+    static ScopeSlot &findSlot(const char *name, uint8_t tag) {
+        if (!name)
+            return s_unscoped;
+
+        uint32_t index = (uint32_t) (((uintptr_t) name >> 3) * 0x9E3779B97F4A7C15ull >> 52) & (s_scopeSlotCount - 1);
+        for (uint32_t probe = 0; probe < s_maxProbes; probe++) {
+            ScopeSlot &slot = s_scopeSlots[(index + probe) & (s_scopeSlotCount - 1)];
+            const char *current = slot.name.load(std::memory_order_acquire);
+            if (current == name)
+                return slot;
+            if (!current) {
+                slot.tag.store(tag, std::memory_order_relaxed);
+                if (slot.name.compare_exchange_strong(current, name, std::memory_order_acq_rel) || current == name)
+                    return slot;
+            }
+        }
+        return s_overflow;
+    }
+
+    static void countAllocation(size_t size) {
+        AllocationScope *scope = AllocationScope::s_current;
+        const char *name = scope ? scope->name : nullptr;
+        uint8_t tag = scope ? scope->tag : 0;
+
+        TagCounters &counters = s_frameTags[tagIndexOf(tag)];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(size, std::memory_order_relaxed);
+        s_liveBytes.fetch_add((int64_t) size, std::memory_order_relaxed);
+
+        ScopeSlot &slot = findSlot(name, tag);
+        slot.allocations.fetch_add(1, std::memory_order_relaxed);
+        slot.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    static void *trackedAllocate(size_t size, size_t alignment) {
+        alignment = std::max(alignment, (size_t) __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        void *block = std::malloc(size + sizeof(AllocationHeader) + alignment - 1);
+        if (!block)
+            return nullptr;
+
+        uintptr_t user = ((uintptr_t) block + sizeof(AllocationHeader) + alignment - 1) & ~(uintptr_t) (alignment - 1);
+        AllocationHeader *header = (AllocationHeader*) user - 1;
+        header->block = block;
+        header->size = size;
+
+        countAllocation(size);
+        return (void*) user;
+    }
+
+    static void trackedFree(void *pointer) {
+        if (!pointer)
+            return;
+
+        AllocationHeader *header = (AllocationHeader*) pointer - 1;
+        s_frameFrees.fetch_add(1, std::memory_order_relaxed);
+        s_liveBytes.fetch_sub((int64_t) header->size, std::memory_order_relaxed);
+        std::free(header->block);
+    }
+
+    static void *trackedAllocateOrThrow(size_t size, size_t alignment) {
+        while (true) {
+            if (void *pointer = trackedAllocate(size, alignment))
+                return pointer;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void AllocationTracker::endFrame() {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        AllocationFrameStats frame;
+        for (uint32_t i = 0; i < s_allocationTagCount; i++) {
+            frame.tags[i].allocations = s_frameTags[i].allocations.exchange(0, std::memory_order_relaxed);
+            frame.tags[i].bytes = s_frameTags[i].bytes.exchange(0, std::memory_order_relaxed);
+            frame.total.allocations += frame.tags[i].allocations;
+            frame.total.bytes += frame.tags[i].bytes;
+        }
+        frame.frees = s_frameFrees.exchange(0, std::memory_order_relaxed);
+        frame.liveBytes = s_liveBytes.load(std::memory_order_relaxed);
+        s_lastFrame = frame;
+
+        // stamped at the frame's start, so each value spans the frame it describes
+        int64_t now = Instrumentor::now();
+        int64_t start = s_frameStart ? s_frameStart : now;
+        s_frameStart = now;
+
+        Instrumentor &instrumentor = Instrumentor::get();
+        if (!instrumentor.isCategoryActive(ProfileCategory::Core))
+            return;
+        instrumentor.recordCounter("Heap allocations", ProfileCategory::Core, (double) frame.total.allocations, start);
+        instrumentor.recordCounter("Heap bytes allocated", ProfileCategory::Core, (double) frame.total.bytes, start);
+        instrumentor.recordCounter("Heap frees", ProfileCategory::Core, (double) frame.frees, start);
+        instrumentor.recordCounter("Heap live bytes", ProfileCategory::Core, (double) frame.liveBytes, start);
+        for (uint32_t i = 0; i < s_allocationTagCount; i++)
+            instrumentor.recordCounter(s_tagCounterNames[i], ProfileCategory::Core, (double) frame.tags[i].allocations, start);
+    }
+
+    const AllocationFrameStats &AllocationTracker::getLastFrame() {
+        return s_lastFrame;
+    }
+
+    std::vector<ScopeAllocationStats> AllocationTracker::getScopeTotals() {
+        std::vector<ScopeAllocationStats> scopes;
+        std::unordered_map<std::string, size_t> byName; // one name may be several literals
+        auto add = [&](const char *name, const ScopeSlot &slot) {
+            uint64_t allocations = slot.allocations.load(std::memory_order_relaxed);
+            if (allocations == 0)
+                return;
+
+            auto [it, inserted] = byName.try_emplace(name, scopes.size());
+            if (inserted)
+                scopes.push_back({ name, getTagName(tagIndexOf(slot.tag.load(std::memory_order_relaxed))), {} });
+            AllocationTotals &totals = scopes[it->second].totals;
+            totals.allocations += allocations;
+            totals.bytes += slot.bytes.load(std::memory_order_relaxed);
+        };
+
+        for (const ScopeSlot &slot : s_scopeSlots) {
+            if (const char *name = slot.name.load(std::memory_order_acquire))
+                add(name, slot);
+        }
+        add("(no scope)", s_unscoped);
+        add("(other scopes)", s_overflow);
+
+        std::sort(scopes.begin(), scopes.end(), [](const ScopeAllocationStats &a, const ScopeAllocationStats &b) {
+            return a.totals.bytes > b.totals.bytes;
+        });
+        return scopes;
+    }
+
+    void AllocationTracker::logReport(uint32_t maxScopes) {
+        [[maybe_unused]] const AllocationFrameStats &frame = s_lastFrame;
+        DM_CORE_INFO("Heap: {0} allocations ({1} bytes) and {2} frees in the last frame, {3} bytes live",
+                     frame.total.allocations, frame.total.bytes, frame.frees, frame.liveBytes);
+
+        std::vector<ScopeAllocationStats> scopes = getScopeTotals();
+        for (size_t i = 0; i < std::min<size_t>(scopes.size(), maxScopes); i++) {
+            [[maybe_unused]] const ScopeAllocationStats &scope = scopes[i];
+            DM_CORE_INFO("  {0:>12} bytes {1:>9} allocations  [{2}] {3}",
+                         scope.totals.bytes, scope.totals.allocations, scope.tag, scope.scope);
+        }
+    }
+}
+
+// the replaceable allocation functions, every form so none of them pairs with the library's own
+
+void *operator new(std::size_t size) {
+    return Deimos::trackedAllocateOrThrow(size, 0);
+}
+
+void *operator new[](std::size_t size) {
+    return Deimos::trackedAllocateOrThrow(size, 0);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return Deimos::trackedAllocateOrThrow(size, (size_t) alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return Deimos::trackedAllocateOrThrow(size, (size_t) alignment);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return Deimos::trackedAllocate(size, 0);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return Deimos::trackedAllocate(size, 0);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return Deimos::trackedAllocate(size, (size_t) alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return Deimos::trackedAllocate(size, (size_t) alignment);
+}
+
+void operator delete(void *pointer) noexcept { Deimos::trackedFree(pointer); }
+void operator delete[](void *pointer) noexcept { Deimos::trackedFree(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { Deimos::trackedFree(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { Deimos::trackedFree(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { Deimos::trackedFree(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { Deimos::trackedFree(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { Deimos::trackedFree(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { Deimos::trackedFree(pointer); }
+void operator delete(void *pointer, const std::nothrow_t&) noexcept { Deimos::trackedFree(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t&) noexcept { Deimos::trackedFree(pointer); }
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t&) noexcept { Deimos::trackedFree(pointer); }
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t&) noexcept { Deimos::trackedFree(pointer); }
+#endif
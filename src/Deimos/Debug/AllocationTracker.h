@@ -0,0 +1,84 @@
+#ifndef ENGINE_ALLOCATIONTRACKER_H
+#define ENGINE_ALLOCATIONTRACKER_H
+
+#include "Instrumentor.h"
+
+namespace Deimos {
+    // untagged first, then one per ProfileCategory bit
+    static const uint32_t s_allocationTagCount = 6;
+
+    struct AllocationTotals {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    struct AllocationFrameStats {
+        AllocationTotals total;
+        AllocationTotals tags[s_allocationTagCount];
+        uint64_t frees = 0;
+        int64_t liveBytes = 0; // everything allocated through the hooks and not yet freed
+    };
+
+    struct ScopeAllocationStats {
+        std::string scope;
+        const char* tag;
+        AllocationTotals totals; // since start
+    };
+
+    // Counts heap allocations made through the global operator new, opt in with the DM_TRACK_ALLOCATIONS CMake
+    // option, which replaces it. Every allocation is attributed to the innermost profile scope of the calling
+    // thread and its category, or an explicit DM_ALLOCATION_TAG. Per-frame totals are kept for the last frame
+    // and written to the trace as counter tracks. Without the option every function is a no-op
+    class AllocationTracker {
+    public:
+#ifdef DM_TRACK_ALLOCATIONS
+        static constexpr bool enabled = true;
+
+        // once per frame from the main loop, closes the frame's totals and records the counters
+        static void endFrame();
+
+        static const AllocationFrameStats& getLastFrame();
+        // every scope that allocated, most bytes first
+        static std::vector<ScopeAllocationStats> getScopeTotals();
+
+        static void logReport(uint32_t maxScopes = 20);
+#else
+        static constexpr bool enabled = false;
+
+        static void endFrame() {}
+        static const AllocationFrameStats& getLastFrame() { static AllocationFrameStats empty; return empty; }
+        static std::vector<ScopeAllocationStats> getScopeTotals() { return {}; }
+        static void logReport(uint32_t /*maxScopes*/ = 20) {}
+#endif
+        static const char* getTagName(uint32_t tagIndex);
+    };
+
+#ifdef DM_TRACK_ALLOCATIONS
+    // for code without a profile scope of its own, or when its category is stripped by DM_PROFILE_LEVEL
+    class AllocationTagScope {
+    public:
+        AllocationTagScope(const char* name, ProfileCategory tag) : m_scope{ name, (uint8_t) tag } {
+            m_parent = AllocationScope::s_current;
+            AllocationScope::s_current = &m_scope;
+        }
+
+        ~AllocationTagScope() {
+            AllocationScope::s_current = m_parent;
+        }
+    private:
+        AllocationScope m_scope;
+        AllocationScope* m_parent;
+    };
+#endif
+}
+
+#ifdef DM_TRACK_ALLOCATIONS
+    // category is one of the ProfileCategory names, e.g. DM_ALLOCATION_TAG(Renderer, "Batch vertices")
+    #define DM_ALLOCATION_TAG(category, name) \
+        ::Deimos::AllocationTagScope allocationTag##__LINE__(name, ::Deimos::ProfileCategory::category);
+#else
+    #define DM_ALLOCATION_TAG(category, name)
+#endif
+
+
+#endif //ENGINE_ALLOCATIONTRACKER_H
@@ -0,0 +1,289 @@
+#include "dmpch.h"
+#include "FrameStats.h"
+
+#include "Deimos/Core/Layer.h"
+
+namespace Deimos {
+    FrameHistogram::FrameHistogram(uint32_t windowSize)
+        : m_samples(std::clamp<uint32_t>(windowSize, 1, UINT16_MAX)), m_buckets(bucketCount + 1, 0) {
+    }
+
+    uint32_t FrameHistogram::bucketOf(float milliseconds) {
+        if (!(milliseconds > 0.f)) // negative and NaN go to the first bucket
+            return 0;
+        return std::min((uint32_t) (milliseconds / bucketWidth), bucketCount);
+    }
+
+    void FrameHistogram::add(float milliseconds) {
+        if (m_count == m_samples.size()) {
+            float oldest = m_samples[m_next];
+            m_buckets[bucketOf(oldest)]--;
+            m_sum -= oldest;
+        } else {
+            m_count++;
+        }
+
+        m_samples[m_next] = milliseconds;
+        m_buckets[bucketOf(milliseconds)]++;
+        m_sum += milliseconds;
+        m_next = (m_next + 1) % (uint32_t) m_samples.size();
+    }
+
+    void FrameHistogram::reset() {
+        std::fill(m_buckets.begin(), m_buckets.end(), 0);
+        m_next = 0;
+        m_count = 0;
+        m_sum = 0.0;
+    }
+
+    float FrameHistogram::getPercentile(float percentile) const {
+        if (m_count == 0)
+            return 0.f;
+
+        uint32_t rank = std::max<uint32_t>(1, (uint32_t) std::ceil(std::clamp(percentile, 0.f, 1.f) * m_count));
+        uint32_t seen = 0;
+        for (uint32_t bucket = 0; bucket < bucketCount; bucket++) {
+            seen += m_buckets[bucket];
+            if (seen >= rank)
+                return std::min((bucket + 0.5f) * bucketWidth, getMax());
+        }
+        return getMax(); // in the overflow bucket
+    }
+
+    float FrameHistogram::getMax() const {
+        if (m_count == 0)
+            return 0.f;
+        return *std::max_element(m_samples.begin(), m_samples.begin() + m_count);
+    }
+
+    FrameTimeSummary FrameHistogram::getSummary() const {
+        FrameTimeSummary summary;
+        summary.p50 = getPercentile(0.5f);
+        summary.p95 = getPercentile(0.95f);
+        summary.p99 = getPercentile(0.99f);
+        summary.max = getMax();
+        summary.mean = getMean();
+        summary.samples = m_count;
+        return summary;
+    }
+
+    // over-budget frames are gathered and logged at most once per second
+    struct BudgetState {
+        float budget = 0.f;
+        uint32_t overruns = 0;
+        float worst = 0.f;
+        FrameStats::Clock::time_point lastLog;
+    };
+
+    struct LayerTrack {
+        std::string name;
+        FrameHistogram update;
+        FrameHistogram imGuiRender;
+        float frameTotal = 0.f; // both callbacks in the current frame
+        BudgetState budget;
+
+        LayerTrack(const std::string &name, uint32_t window) : name(name), update(window), imGuiRender(window) {}
+    };
+
+    struct FrameStatsData {
+        bool initialized = false;
+        uint32_t window = 0;
+
+        FrameHistogram frameTime;
+        FrameHistogram swapWait;
+        std::unordered_map<const Layer*, LayerTrack> layers;
+
+        FrameStats::Clock::time_point frameStart;
+        bool inFrame = false;
+
+        float stutterThreshold = 2.f;
+        uint64_t stutters = 0;
+        uint32_t recentStutters = 0;
+        std::vector<uint8_t> stutterFlags; // ring in step with frameTime
+        uint32_t stutterNext = 0;
+
+        BudgetState frameBudget;
+    };
+
+    static FrameStatsData s_statsData;
+
+    // the median needs some history before stutters mean anything
+    static const uint32_t s_stutterWarmupFrames = 30;
+
+    static LayerTrack &getTrack(const Layer *layer) {
+        auto it = s_statsData.layers.find(layer);
+        if (it == s_statsData.layers.end())
+            it = s_statsData.layers.try_emplace(layer, layer->getName(), s_statsData.window).first;
+        return it->second;
+    }
+
+    // layer is the layer's name, null for the frame itself
+    static void checkBudget(BudgetState &state, float milliseconds, const char *layer, FrameStats::Clock::time_point now) {
+        if (state.budget <= 0.f || milliseconds <= state.budget)
+            return;
+
+        state.overruns++;
+        state.worst = std::max(state.worst, milliseconds);
+        if (now - state.lastLog < std::chrono::seconds(1))
+            return;
+
+        if (!layer) {
+            DM_CORE_WARN("Frame went over its {0:.2f} ms budget in {1} frame(s), worst {2:.2f} ms",
+                         state.budget, state.overruns, state.worst);
+        } else {
+            DM_CORE_WARN("Layer '{0}' went over its {1:.2f} ms budget in {2} frame(s), worst {3:.2f} ms",
+                         layer, state.budget, state.overruns, state.worst);
+        }
+        state.overruns = 0;
+        state.worst = 0.f;
+        state.lastLog = now;
+    }
+
+    void FrameStats::init(uint32_t windowFrames) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        windowFrames = std::clamp<uint32_t>(windowFrames, 1, UINT16_MAX);
+        s_statsData = FrameStatsData();
+        s_statsData.window = windowFrames;
+        s_statsData.frameTime = FrameHistogram(windowFrames);
+        s_statsData.swapWait = FrameHistogram(windowFrames);
+        s_statsData.stutterFlags.assign(windowFrames, 0);
+        s_statsData.initialized = true;
+    }
+
+    void FrameStats::shutdown() {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        logReport();
+        s_statsData = FrameStatsData();
+    }
+
+    void FrameStats::beginFrame() {
+        s_statsData.frameStart = Clock::now();
+        s_statsData.inFrame = s_statsData.initialized;
+    }
+
+    void FrameStats::endFrame() {
+        if (!s_statsData.inFrame)
+            return;
+        s_statsData.inFrame = false;
+
+        Clock::time_point now = Clock::now();
+        float frameMs = std::chrono::duration<float, std::milli>(now - s_statsData.frameStart).count();
+
+        // judged against the window before this frame joins it
+        FrameHistogram &frameTime = s_statsData.frameTime;
+        bool stutter = frameTime.getCount() >= s_stutterWarmupFrames &&
+                       frameMs >= s_statsData.stutterThreshold * frameTime.getPercentile(0.5f);
+
+        uint8_t &flag = s_statsData.stutterFlags[s_statsData.stutterNext];
+        s_statsData.recentStutters -= flag;
+        flag = stutter;
+        s_statsData.recentStutters += flag;
+        s_statsData.stutters += flag;
+        s_statsData.stutterNext = (s_statsData.stutterNext + 1) % s_statsData.window;
+
+        frameTime.add(frameMs);
+
+        checkBudget(s_statsData.frameBudget, frameMs, nullptr, now);
+        for (auto &[layer, track] : s_statsData.layers) {
+            checkBudget(track.budget, track.frameTotal, track.name.c_str(), now);
+            track.frameTotal = 0.f;
+        }
+    }
+
+    void FrameStats::recordLayerUpdate(const Layer *layer, float milliseconds) {
+        if (!s_statsData.initialized)
+            return;
+
+        LayerTrack &track = getTrack(layer);
+        track.update.add(milliseconds);
+        track.frameTotal += milliseconds;
+    }
+
+    void FrameStats::recordLayerImGuiRender(const Layer *layer, float milliseconds) {
+        if (!s_statsData.initialized)
+            return;
+
+        LayerTrack &track = getTrack(layer);
+        track.imGuiRender.add(milliseconds);
+        track.frameTotal += milliseconds;
+    }
+
+    void FrameStats::recordSwapWait(float milliseconds) {
+        if (s_statsData.initialized)
+            s_statsData.swapWait.add(milliseconds);
+    }
+
+    void FrameStats::removeLayer(const Layer *layer) {
+        s_statsData.layers.erase(layer);
+    }
+
+    FrameTimeSummary FrameStats::getFrameTime() {
+        return s_statsData.frameTime.getSummary();
+    }
+
+    FrameTimeSummary FrameStats::getSwapWait() {
+        return s_statsData.swapWait.getSummary();
+    }
+
+    FrameTimeSummary FrameStats::getLayerUpdate(const Layer *layer) {
+        auto it = s_statsData.layers.find(layer);
+        return it != s_statsData.layers.end() ? it->second.update.getSummary() : FrameTimeSummary();
+    }
+
+    FrameTimeSummary FrameStats::getLayerImGuiRender(const Layer *layer) {
+        auto it = s_statsData.layers.find(layer);
+        return it != s_statsData.layers.end() ? it->second.imGuiRender.getSummary() : FrameTimeSummary();
+    }
+
+    uint64_t FrameStats::getStutterCount() {
+        return s_statsData.stutters;
+    }
+
+    uint32_t FrameStats::getRecentStutterCount() {
+        return s_statsData.recentStutters;
+    }
+
+    void FrameStats::setStutterThreshold(float medianMultiplier) {
+        s_statsData.stutterThreshold = std::max(medianMultiplier, 1.f);
+    }
+
+    void FrameStats::setLayerBudget(const Layer *layer, float milliseconds) {
+        if (!s_statsData.initialized) {
+            DM_CORE_WARN("FrameStats: budget for layer '{0}' set before init, ignored", layer->getName());
+            return;
+        }
+        BudgetState budget;
+        budget.budget = std::max(milliseconds, 0.f);
+        getTrack(layer).budget = budget;
+    }
+
+    void FrameStats::setFrameBudget(float milliseconds) {
+        BudgetState budget;
+        budget.budget = std::max(milliseconds, 0.f);
+        s_statsData.frameBudget = budget;
+    }
+
+    static void logSummary([[maybe_unused]] const std::string &name, [[maybe_unused]] const FrameTimeSummary &summary) {
+        DM_CORE_INFO("  {0:<32} p50 {1:6.2f}  p95 {2:6.2f}  p99 {3:6.2f}  max {4:6.2f}  mean {5:6.2f} ms ({6} samples)",
+                     name, summary.p50, summary.p95, summary.p99, summary.max, summary.mean, summary.samples);
+    }
+
+    void FrameStats::logReport() {
+        if (!s_statsData.initialized || s_statsData.frameTime.getCount() == 0)
+            return;
+
+        DM_CORE_INFO("Frame stats over the last {0} frames, {1} stutters ({2} since start):",
+                     s_statsData.frameTime.getCount(), s_statsData.recentStutters, s_statsData.stutters);
+        logSummary("Frame", getFrameTime());
+        if (s_statsData.swapWait.getCount())
+            logSummary("Swap wait", getSwapWait());
+        for (auto &[layer, track] : s_statsData.layers) {
+            if (track.update.getCount())
+                logSummary(track.name + " onUpdate", track.update.getSummary());
+            if (track.imGuiRender.getCount())
+                logSummary(track.name + " onImGuiRender", track.imGuiRender.getSummary());
+        }
+    }
+}
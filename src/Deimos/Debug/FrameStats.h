@@ -0,0 +1,95 @@
+#ifndef ENGINE_FRAMESTATS_H
+#define ENGINE_FRAMESTATS_H
+
+#include "Deimos/Core/Core.h"
+
+#include <chrono>
+#include <vector>
+
+namespace Deimos {
+    class Layer;
+
+    struct FrameTimeSummary {
+        float p50 = 0.f; // all in milliseconds
+        float p95 = 0.f;
+        float p99 = 0.f;
+        float max = 0.f;
+        float mean = 0.f;
+        uint32_t samples = 0;
+    };
+
+    // Distribution of the last windowSize samples in fixed 0.05 ms buckets up to 100 ms, slower samples share
+    // an overflow bucket. Percentiles are accurate to half a bucket, max and mean are exact
+    class FrameHistogram {
+    public:
+        static constexpr float bucketWidth = 0.05f;
+        static constexpr uint32_t bucketCount = 2000;
+
+        FrameHistogram(uint32_t windowSize = 600);
+
+        void add(float milliseconds);
+        void reset();
+
+        // percentile in [0, 1], 0 while empty
+        float getPercentile(float percentile) const;
+        float getMax() const;
+        float getMean() const { return m_count ? (float) (m_sum / m_count) : 0.f; }
+        uint32_t getCount() const { return m_count; }
+
+        FrameTimeSummary getSummary() const;
+    private:
+        static uint32_t bucketOf(float milliseconds);
+    private:
+        std::vector<float> m_samples; // ring, the oldest sample at m_next once full
+        std::vector<uint16_t> m_buckets; // the last one is the overflow bucket
+        uint32_t m_next = 0;
+        uint32_t m_count = 0;
+        double m_sum = 0.0;
+    };
+
+    // Rolling frame timings of the run loop: CPU frame time, swap wait and each layer's onUpdate and
+    // onImGuiRender. A frame is a stutter when it takes stutterThreshold times the rolling median or longer.
+    // Layers and the frame can be given budgets, going over one logs a warning at most once a second.
+    // Main thread only
+    class FrameStats {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // window is the number of frames the percentiles cover
+        static void init(uint32_t windowFrames = 600);
+        static void shutdown();
+
+        static void beginFrame();
+        static void endFrame();
+
+        static void recordLayerUpdate(const Layer* layer, float milliseconds);
+        static void recordLayerImGuiRender(const Layer* layer, float milliseconds);
+        static void recordSwapWait(float milliseconds);
+        // forgets the layer's timings and budget, called when the layer leaves the stack
+        static void removeLayer(const Layer* layer);
+
+        inline static float elapsedMilliseconds(Clock::time_point start) {
+            return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+        }
+
+        static FrameTimeSummary getFrameTime();
+        static FrameTimeSummary getSwapWait();
+        static FrameTimeSummary getLayerUpdate(const Layer* layer);
+        static FrameTimeSummary getLayerImGuiRender(const Layer* layer);
+
+        // stutters since init, and within the current window
+        static uint64_t getStutterCount();
+        static uint32_t getRecentStutterCount();
+        static void setStutterThreshold(float medianMultiplier);
+
+        // onUpdate plus onImGuiRender in milliseconds, 0 removes the budget
+        static void setLayerBudget(const Layer* layer, float milliseconds);
+        static void setFrameBudget(float milliseconds);
+
+        // logs the summary of every track
+        static void logReport();
+    };
+}
+
+
+#endif //ENGINE_FRAMESTATS_H
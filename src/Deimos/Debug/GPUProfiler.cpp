@@ -0,0 +1,21 @@
+#include "dmpch.h"
+#include "GPUProfiler.h"
+
+#include "Deimos/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLGPUProfiler.h"
+
+namespace Deimos {
+    Scope<GPUProfiler> GPUProfiler::s_instance;
+
+    void GPUProfiler::init() {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None: DM_ASSERT(false, "Deimos currently does not support RendererAPI::None!"); return;
+            case RendererAPI::API::OpenGL: s_instance = createScope<OpenGLGPUProfiler>(); return;
+        }
+        DM_ASSERT(false, "Unknown RendererAPI!");
+    }
+
+    void GPUProfiler::shutdown() {
+        s_instance.reset();
+    }
+}
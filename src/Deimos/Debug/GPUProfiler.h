@@ -0,0 +1,68 @@
+#ifndef ENGINE_GPUPROFILER_H
+#define ENGINE_GPUPROFILER_H
+
+#include "Deimos/Core/Core.h"
+#include "Instrumentor.h"
+
+namespace Deimos {
+
+    // Times GPU work with timestamp queries. Results are read back a few frames later without stalling
+    // and recorded by the Instrumentor on a separate "GPU" track, aligned to CPU time.
+    class GPUProfiler {
+    public:
+        static const uint32_t invalidScope = UINT32_MAX;
+
+        virtual ~GPUProfiler() = default;
+
+        // must be called with a current context
+        static void init();
+        static void shutdown();
+
+        // name must outlive the readback, string literals only
+        inline static uint32_t beginScope(const char* name) { return s_instance ? s_instance->beginScopeImpl(name) : invalidScope; }
+        inline static void endScope(uint32_t scope) { if (s_instance && scope != invalidScope) s_instance->endScopeImpl(scope); }
+
+        // once per frame, writes every finished scope to the trace
+        inline static void collect() { if (s_instance) s_instance->collectImpl(false); }
+        // blocks until all scopes in flight are written, e.g. before a session ends
+        inline static void flush() { if (s_instance) s_instance->collectImpl(true); }
+    protected:
+        virtual uint32_t beginScopeImpl(const char* name) = 0;
+        virtual void endScopeImpl(uint32_t scope) = 0;
+        virtual void collectImpl(bool wait) = 0;
+    private:
+        static Scope<GPUProfiler> s_instance;
+    };
+
+    // GPU scopes belong to the GLWrapper category, like the CPU scopes they are compiled out with it
+    template<bool Enabled = getProfileCategoryLevel(ProfileCategory::GLWrapper) <= DM_PROFILE_LEVEL>
+    class GPUInstrumentationTimer {
+    public:
+        GPUInstrumentationTimer(const char* name) {
+            Instrumentor &instrumentor = Instrumentor::get();
+            if (instrumentor.isRecording() && instrumentor.isCategoryActive(ProfileCategory::GLWrapper))
+                m_scope = GPUProfiler::beginScope(name);
+        }
+
+        ~GPUInstrumentationTimer() {
+            GPUProfiler::endScope(m_scope);
+        }
+    private:
+        uint32_t m_scope = GPUProfiler::invalidScope;
+    };
+
+    template<>
+    class GPUInstrumentationTimer<false> {
+    public:
+        GPUInstrumentationTimer(const char*) {
+        }
+    };
+}
+
+#if DM_PROFILE
+	#define DM_PROFILE_GPU_SCOPE(name) ::Deimos::GPUInstrumentationTimer<> gpuTimer##__LINE__(name);
+#else
+	#define DM_PROFILE_GPU_SCOPE(name)
+#endif
+
+#endif //ENGINE_GPUPROFILER_H
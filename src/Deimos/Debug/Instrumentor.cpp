@@ -0,0 +1,508 @@
+#include "dmpch.h"
+#include "Instrumentor.h"
+
+#include <cctype>
+#include <cinttypes>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Deimos {
+    // how often the writer wakes up to empty the buffers, well below the time a busy thread needs to fill one
+    static const std::chrono::milliseconds s_writerInterval(5);
+    static const size_t s_chunkSize = 64 * 1024;
+
+    // set once the thread's buffer owner is destroyed, scopes recorded after that (from other thread_local
+    // destructors) are ignored instead of registering a new buffer or reaching the retired one
+    static thread_local bool s_threadExited = false;
+    // from setThreadName, the buffer may be registered later
+    static thread_local const char *s_threadName = nullptr;
+
+    // set by the signal handler, picked up by the writer thread
+    static volatile std::sig_atomic_t s_signalDumpRequested = 0;
+
+    static void onDumpSignal(int) {
+        s_signalDumpRequested = 1;
+    }
+
+    // names are written as JSON strings, quotes become apostrophes
+    static void appendEscaped(std::string &chunk, const char *text) {
+        for (const char *c = text; *c; ++c) {
+            if (*c == '"')
+                chunk += '\'';
+            else if (*c == '\\')
+                chunk += "\\\\";
+            else
+                chunk += *c;
+        }
+    }
+
+    struct ThreadBufferOwner {
+        std::shared_ptr<ProfileEventBuffer> buffer;
+
+        ~ThreadBufferOwner() {
+            // the writer frees the buffer once it is retired and drained
+            Instrumentor::s_threadBuffer = nullptr;
+            if (buffer)
+                buffer->retire();
+            s_threadExited = true;
+        }
+    };
+
+    static const struct { ProfileCategory category; const char* name; } s_categoryNames[] = {
+        { ProfileCategory::Core, "core" },
+        { ProfileCategory::Renderer, "renderer" },
+        { ProfileCategory::GLWrapper, "gl" },
+        { ProfileCategory::Assets, "assets" },
+        { ProfileCategory::User, "user" },
+    };
+
+    const char *getProfileCategoryName(ProfileCategory category) {
+        for (const auto &entry : s_categoryNames) {
+            if (entry.category == category)
+                return entry.name;
+        }
+        return "all";
+    }
+
+    Instrumentor::Instrumentor() {
+        if (const char *categories = std::getenv("DM_PROFILE_CATEGORIES"))
+            m_categoryMask = parseCategories(categories);
+    }
+
+    Instrumentor::~Instrumentor() {
+        endSession();
+        endFlightRecorder();
+    }
+
+    void Instrumentor::beginSession(const std::string &name, const std::string &filepath) {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (isSessionActive()) {
+            DM_CORE_WARN("Profile session '{0}' begins before the previous one ended", name);
+            finishSession();
+        }
+
+        {
+            std::lock_guard<std::mutex> fileLock(m_fileMutex);
+            m_outputStream.open(filepath);
+            m_outputStream << "{\"traceEvents\":[";
+            m_fileOutput = TraceOutput();
+        }
+
+        // events still buffered from an earlier session are not written to this one
+        m_sessionID.fetch_add(1, std::memory_order_relaxed);
+        m_sessionActive.store(true, std::memory_order_relaxed);
+        updateRecording();
+    }
+
+    void Instrumentor::endSession() {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (isSessionActive())
+            finishSession();
+    }
+
+    void Instrumentor::finishSession() {
+        waitForDrain();
+
+        uint64_t dropped;
+        {
+            std::lock_guard<std::mutex> writerLock(m_writerMutex);
+            dropped = m_droppedCount;
+            m_droppedCount = 0;
+        }
+        {
+            // drains from here on see the file closed
+            std::lock_guard<std::mutex> fileLock(m_fileMutex);
+            m_outputStream.write(m_fileOutput.chunk.data(), (std::streamsize) m_fileOutput.chunk.size());
+            m_fileOutput = TraceOutput();
+            // after the events, the count is only known now
+            m_outputStream << "],\"otherData\":{\"droppedEvents\":" << dropped << "}}";
+            m_outputStream.close();
+        }
+        if (dropped) {
+            DM_CORE_WARN("Profiler dropped {0} events, a thread recorded faster than the writer could keep up", dropped);
+        }
+
+        m_sessionActive.store(false, std::memory_order_relaxed);
+        updateRecording();
+    }
+
+    void Instrumentor::beginFlightRecorder(const FlightRecorderSettings &settings) {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        {
+            std::lock_guard<std::mutex> flightLock(m_flightMutex);
+            m_flightSettings = settings;
+            m_flightEvents.assign(std::max(1u, settings.capacity), RecordedEvent());
+            m_flightNext = 0;
+            m_flightWrapped = false;
+        }
+#ifdef SIGUSR1
+        std::signal(SIGUSR1, onDumpSignal);
+#endif
+
+        m_lastFrameNanoseconds = 0;
+        m_lastHitchDumpNanoseconds = 0;
+        m_flightRecorderActive.store(true, std::memory_order_relaxed);
+        updateRecording();
+    }
+
+    void Instrumentor::endFlightRecorder() {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (!isFlightRecorderActive())
+            return;
+
+#ifdef SIGUSR1
+        std::signal(SIGUSR1, SIG_DFL);
+#endif
+        // dumps asked for before still go out
+        waitForDrain();
+        m_flightRecorderActive.store(false, std::memory_order_relaxed);
+        updateRecording();
+
+        std::lock_guard<std::mutex> flightLock(m_flightMutex);
+        m_flightEvents.clear();
+        m_flightEvents.shrink_to_fit();
+    }
+
+    void Instrumentor::dumpFlightRecorder(const std::string &reason) {
+        if (!isFlightRecorderActive())
+            return;
+
+        {
+            std::lock_guard<std::mutex> flightLock(m_flightMutex);
+            m_pendingDumps.push_back(reason);
+        }
+        m_writerCondition.notify_one();
+    }
+
+    void Instrumentor::markFrame() {
+        int64_t now = steadyNanoseconds();
+        int64_t frameTime = now - m_lastFrameNanoseconds;
+        bool first = m_lastFrameNanoseconds == 0;
+        m_lastFrameNanoseconds = now;
+        if (first || !isFlightRecorderActive() || m_flightSettings.hitchThresholdMs <= 0.0f)
+            return;
+
+        if (frameTime <= (int64_t) (m_flightSettings.hitchThresholdMs * 1e6))
+            return;
+        recordInstant("Hitch", ProfileCategory::Core);
+
+        // one dump covers the whole window, a run of slow frames doesn't need more
+        int64_t windowNanoseconds = (int64_t) (m_flightSettings.windowSeconds * 1e9);
+        if (now - m_lastHitchDumpNanoseconds > windowNanoseconds) {
+            DM_CORE_WARN("Frame took {0:.2f} ms, dumping the flight recorder", (double) frameTime / 1e6);
+            m_lastHitchDumpNanoseconds = now;
+            dumpFlightRecorder("hitch");
+        }
+    }
+
+    void Instrumentor::setCategoryMask(uint32_t mask) {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        m_categoryMask = mask & (uint32_t) ProfileCategory::All;
+        m_activeCategories.store(isRecording() ? m_categoryMask : 0, std::memory_order_relaxed);
+    }
+
+    uint32_t Instrumentor::parseCategories(const std::string &list) {
+        uint32_t mask = 0;
+        size_t begin = 0;
+        while (begin <= list.size()) {
+            size_t end = std::min(list.find(',', begin), list.size());
+            std::string name = list.substr(begin, end - begin);
+            name.erase(0, name.find_first_not_of(' '));
+            name.erase(name.find_last_not_of(' ') + 1);
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char) std::tolower(c); });
+
+            if (name == "all") {
+                mask |= (uint32_t) ProfileCategory::All;
+            } else if (!name.empty() && name != "none") {
+                auto it = std::find_if(std::begin(s_categoryNames), std::end(s_categoryNames), [&](const auto &entry) {
+                    return name == entry.name;
+                });
+                if (it != std::end(s_categoryNames)) {
+                    mask |= (uint32_t) it->category;
+                } else {
+                    DM_CORE_WARN("Unknown profile category '{0}'", name);
+                }
+            }
+            begin = end + 1;
+        }
+        return mask;
+    }
+
+    const char *Instrumentor::internName(const std::string &name) {
+        std::lock_guard<std::mutex> lock(m_namesMutex);
+        return m_names.insert(name).first->c_str();
+    }
+
+    void Instrumentor::setThreadName(const std::string &name) {
+        s_threadName = internName(name);
+        if (ProfileEventBuffer *buffer = s_threadBuffer) {
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+            m_threadNames[buffer->getThreadIndex()] = s_threadName;
+        }
+    }
+
+    ProfileEventBuffer *Instrumentor::registerThread() {
+        if (s_threadExited)
+            return nullptr;
+
+        static thread_local ThreadBufferOwner owner;
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        owner.buffer = std::make_shared<ProfileEventBuffer>(m_nextThreadIndex++);
+        m_buffers.push_back(owner.buffer);
+        m_threadNames.push_back(s_threadName);
+        s_threadBuffer = owner.buffer.get();
+        return s_threadBuffer;
+    }
+
+    void Instrumentor::updateRecording() {
+        bool recording = isSessionActive() || isFlightRecorderActive();
+        m_recording.store(recording, std::memory_order_relaxed);
+        m_activeCategories.store(recording ? m_categoryMask : 0, std::memory_order_relaxed);
+
+        if (recording && !m_writer.joinable()) {
+            if (!m_clockCalibrated) {
+                m_baseTicks = now();
+                m_baseNanoseconds = steadyNanoseconds();
+            }
+            m_stopWriter = false;
+            m_writer = std::thread([this]() { writerLoop(); });
+        } else if (!recording && m_writer.joinable()) {
+            {
+                std::lock_guard<std::mutex> writerLock(m_writerMutex);
+                m_stopWriter = true;
+            }
+            m_writerCondition.notify_one();
+            m_writer.join();
+        }
+    }
+
+    void Instrumentor::waitForDrain() {
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        uint64_t target = ++m_drainsRequested;
+        m_writerCondition.notify_one();
+        m_writerCondition.wait(lock, [this, target]() { return m_drainsCompleted >= target; });
+    }
+
+    void Instrumentor::writerLoop() {
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        while (true) {
+            m_writerCondition.wait_for(lock, s_writerInterval, [this]() {
+                return m_stopWriter || m_drainsRequested > m_drainsCompleted;
+            });
+            bool stopping = m_stopWriter;
+            uint64_t requested = m_drainsRequested;
+            lock.unlock();
+
+            drainBuffers();
+            writeDumps();
+
+            lock.lock();
+            m_drainsCompleted = requested;
+            m_writerCondition.notify_all();
+            if (stopping)
+                break;
+        }
+    }
+
+    void Instrumentor::drainBuffers() {
+        std::vector<std::shared_ptr<ProfileEventBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+            // the retired flag is read before draining, so an exited thread's last events are still written
+            m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(), [](const auto &buffer) {
+                return buffer->isRetired() && buffer->isEmpty();
+            }), m_buffers.end());
+            buffers = m_buffers;
+            m_writerThreadNames = m_threadNames;
+        }
+
+        calibrateClock();
+        const uint32_t session = m_sessionID.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        std::lock_guard<std::mutex> flightLock(m_flightMutex);
+        const bool toFile = m_outputStream.is_open();
+        const bool toFlight = !m_flightEvents.empty();
+        uint64_t dropped = 0;
+        for (const auto &buffer : buffers) {
+            const uint32_t threadIndex = buffer->getThreadIndex();
+            buffer->drain([&](const ProfileEvent &event) {
+                if (toFile && event.session == session)
+                    appendEvent(m_fileOutput, event, threadIndex);
+                if (toFlight) {
+                    m_flightEvents[m_flightNext] = { event, threadIndex };
+                    if (++m_flightNext == m_flightEvents.size()) {
+                        m_flightNext = 0;
+                        m_flightWrapped = true;
+                    }
+                }
+            });
+            dropped += buffer->takeDropped();
+        }
+
+        if (m_fileOutput.chunk.size() >= s_chunkSize) {
+            m_outputStream.write(m_fileOutput.chunk.data(), (std::streamsize) m_fileOutput.chunk.size());
+            m_fileOutput.chunk.clear();
+        }
+
+        std::lock_guard<std::mutex> writerLock(m_writerMutex);
+        m_droppedCount += dropped;
+    }
+
+    void Instrumentor::writeDumps() {
+        std::vector<std::string> reasons;
+        {
+            std::lock_guard<std::mutex> flightLock(m_flightMutex);
+            reasons.swap(m_pendingDumps);
+        }
+        if (s_signalDumpRequested) {
+            s_signalDumpRequested = 0;
+            reasons.emplace_back("signal");
+        }
+
+        for (const std::string &reason : reasons)
+            writeDump(reason);
+    }
+
+    void Instrumentor::writeDump(const std::string &reason) {
+        std::string path;
+        TraceOutput output;
+        {
+            std::lock_guard<std::mutex> flightLock(m_flightMutex);
+            if (m_flightEvents.empty())
+                return;
+
+            path = m_flightSettings.directory + "/DeimosFlight-" + reason + "-" + std::to_string(m_dumpCount++) + ".json";
+            double windowStartUs = (double) steadyNanoseconds() / 1000.0 - m_flightSettings.windowSeconds * 1e6;
+
+            // oldest first
+            size_t count = m_flightWrapped ? m_flightEvents.size() : m_flightNext;
+            size_t first = m_flightWrapped ? m_flightNext : 0;
+            for (size_t i = 0; i < count; ++i) {
+                const RecordedEvent &recorded = m_flightEvents[(first + i) % m_flightEvents.size()];
+                double startUs, durationUs;
+                toMicroseconds(recorded.event, startUs, durationUs);
+                if (startUs + durationUs >= windowStartUs)
+                    appendEvent(output, recorded.event, recorded.threadIndex);
+            }
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            DM_CORE_ERROR("Could not open '{0}' for writing", path);
+            return;
+        }
+        file << "{\"traceEvents\":[";
+        file.write(output.chunk.data(), (std::streamsize) output.chunk.size());
+        file << "]}";
+        DM_CORE_INFO("Flight recorder wrote {0} events to '{1}'", output.eventCount, path);
+    }
+
+    void Instrumentor::calibrateClock() {
+#if DM_PROFILE_TSC
+        int64_t ticks = now() - m_baseTicks;
+        int64_t nanoseconds = steadyNanoseconds() - m_baseNanoseconds;
+        // both clocks are read back to back, over a millisecond the error is well under a tick per event. Shorter
+        // spans are only used until the first good measurement, later sessions keep that one
+        if (ticks > 0 && (nanoseconds > 1000000 || !m_clockCalibrated)) {
+            m_nanosecondsPerTick = (double) nanoseconds / (double) ticks;
+            m_clockCalibrated = nanoseconds > 1000000;
+        }
+#endif
+    }
+
+    void Instrumentor::toMicroseconds(const ProfileEvent &event, double &startUs, double &durationUs) const {
+        if (event.type == ProfileEventType::GPUScope) {
+            startUs = (double) event.start / 1000.0;
+            durationUs = (double) event.duration / 1000.0;
+            return;
+        }
+
+        startUs = ((double) m_baseNanoseconds + (double) (event.start - m_baseTicks) * m_nanosecondsPerTick) / 1000.0;
+        // only scopes have a duration, the field holds something else for the rest
+        durationUs = event.type == ProfileEventType::Scope ? (double) event.duration * m_nanosecondsPerTick / 1000.0 : 0.0;
+    }
+
+    void Instrumentor::appendThreadName(TraceOutput &output, uint32_t threadIndex) const {
+        const char *name = threadIndex < m_writerThreadNames.size() ? m_writerThreadNames[threadIndex] : nullptr;
+        if (threadIndex >= output.threadNames.size())
+            output.threadNames.resize(threadIndex + 1, nullptr);
+        // "" marks the default name as written
+        const char *written = name ? name : "";
+        if (output.threadNames[threadIndex] == written)
+            return;
+        output.threadNames[threadIndex] = written;
+
+        std::string &chunk = output.chunk;
+        if (output.eventCount++ > 0)
+            chunk += ',';
+        char number[64];
+        snprintf(number, sizeof(number), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%" PRIu32 ",", threadIndex);
+        chunk += number;
+        chunk += "\"args\":{\"name\":\"";
+        if (name) {
+            appendEscaped(chunk, name);
+        } else {
+            snprintf(number, sizeof(number), "Thread %" PRIu32, threadIndex);
+            chunk += number;
+        }
+        chunk += "\"}}";
+    }
+
+    void Instrumentor::appendEvent(TraceOutput &output, const ProfileEvent &event, uint32_t threadIndex) const {
+        std::string &chunk = output.chunk;
+        bool gpu = event.type == ProfileEventType::GPUScope;
+        if (gpu && !output.gpuTrackNamed) {
+            if (output.eventCount++ > 0)
+                chunk += ',';
+            chunk += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}";
+            output.gpuTrackNamed = true;
+        }
+        if (!gpu)
+            appendThreadName(output, threadIndex);
+
+        if (output.eventCount++ > 0)
+            chunk += ',';
+        chunk += "{\"cat\":\"";
+        chunk += gpu ? "gpu" : getProfileCategoryName(event.category);
+        chunk += "\",";
+
+        double startUs, durationUs;
+        toMicroseconds(event, startUs, durationUs);
+
+        char number[64];
+        if (event.type == ProfileEventType::Scope || gpu) {
+            snprintf(number, sizeof(number), "\"dur\":%.3f,", durationUs);
+            chunk += number;
+        }
+
+        chunk += "\"name\":\"";
+        appendEscaped(chunk, event.name);
+        chunk += "\",";
+
+        switch (event.type) {
+            case ProfileEventType::Scope:
+            case ProfileEventType::GPUScope:
+                chunk += "\"ph\":\"X\",";
+                break;
+            case ProfileEventType::Counter:
+                // counter tracks belong to the process, the series is named after the event
+                snprintf(number, sizeof(number), "\"ph\":\"C\",\"args\":{\"value\":%.17g},", event.value);
+                chunk += number;
+                break;
+            case ProfileEventType::Instant:
+                chunk += "\"ph\":\"i\",\"s\":\"t\",";
+                break;
+            case ProfileEventType::AsyncBegin:
+            case ProfileEventType::AsyncEnd:
+                snprintf(number, sizeof(number), "\"ph\":\"%c\",\"id\":\"0x%" PRIx64 "\",",
+                         event.type == ProfileEventType::AsyncBegin ? 'b' : 'e', event.id);
+                chunk += number;
+                break;
+        }
+
+        snprintf(number, sizeof(number), "\"pid\":%d,\"tid\":%" PRIu32 ",\"ts\":%.3f}", gpu ? 1 : 0, gpu ? 0 : threadIndex, startUs);
+        chunk += number;
+    }
+}
@@ -1,119 +1,411 @@
 #pragma once
 
-#include <algorithm>
-#include <string>
+#include <atomic>
 #include <chrono>
-#include <iomanip>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
-
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_set>
+#include <vector>
+
+// set by CMake from the build type, see getProfileCategoryLevel
+#ifndef DM_PROFILE_LEVEL
+	#define DM_PROFILE_LEVEL 3
+#endif
+#define DM_PROFILE (DM_PROFILE_LEVEL > 0)
+
+// timestamps are raw TSC ticks where the CPU has one, the writer thread converts them to steady clock time
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define DM_PROFILE_TSC 1
+	#include <x86intrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#define DM_PROFILE_TSC 1
+	#include <intrin.h>
+#else
+	#define DM_PROFILE_TSC 0
+#endif
 
 namespace Deimos {
 	using FloatingPointMicroseconds = std::chrono::duration<double, std::micro>;
 
-	struct ProfileResult {
-		std::string name;
-		FloatingPointMicroseconds start;
-		std::chrono::microseconds elapsedTime;
-		std::thread::id threadID;
+	// Subsystems scopes belong to, a bit each so they combine into masks
+	enum class ProfileCategory : uint8_t {
+		Core      = 1 << 0, // application, windows, the run loop
+		Renderer  = 1 << 1, // Renderer2D, cameras, ImGui
+		GLWrapper = 1 << 2, // the OpenGL classes, binds and draws
+		Assets    = 1 << 3, // decoding, caching and uploading resources
+		User      = 1 << 4, // DM_PROFILE_FUNCTION / DM_PROFILE_SCOPE from the client
+		All       = 0x1F
+	};
+
+	// How fine grained the scopes of a category are. DM_PROFILE_LEVEL strips the categories above it at compile time:
+	// 0 - nothing is profiled, 1 - core and user, 2 - + renderer and assets, 3 - + every GL call
+	constexpr uint32_t getProfileCategoryLevel(ProfileCategory category) {
+		switch (category) {
+			case ProfileCategory::Core: return 1;
+			case ProfileCategory::User: return 1;
+			case ProfileCategory::Renderer: return 2;
+			case ProfileCategory::Assets: return 2;
+			case ProfileCategory::GLWrapper: return 3;
+			case ProfileCategory::All: return 3;
+		}
+		return 3;
+	}
+
+	const char* getProfileCategoryName(ProfileCategory category);
+
+	enum class ProfileEventType : uint8_t {
+		Scope = 0,
+		GPUScope,   // on the separate "GPU" track
+		Counter,    // a sample of a counter track, holds until the next sample
+		Instant,    // a point in time on the thread's track
+		AsyncBegin, // a span that may end on another thread, paired by name and id
+		AsyncEnd
 	};
 
-	struct InstrumentationSession {
-		std::string name;
+	// One recorded event, kept raw until the writer thread formats it. name is not copied, it has to be
+	// a string literal or come from Instrumentor::internName
+	struct ProfileEvent {
+		const char* name;
+		int64_t start;    // Instrumentor::now() ticks, steady clock nanoseconds for GPU scopes
+		union {
+			int64_t duration; // same unit as start
+			double value;     // counters
+			uint64_t id;      // async spans
+		};
+		uint32_t session;
+		ProfileEventType type;
+		ProfileCategory category;
 	};
 
-	class Instrumentor {
-	private:
-		InstrumentationSession* m_currentSession;
-		std::ofstream m_outputStream;
-		int m_profileCount;
+	// Single producer / single consumer ring owned by one thread. The thread pushes without locking, the writer
+	// thread drains. Events pushed while the ring is full are dropped and counted
+	class ProfileEventBuffer {
 	public:
-		Instrumentor() : m_currentSession(nullptr), m_profileCount(0) {
+		static const uint32_t capacity = 1 << 14; // power of two
+
+		ProfileEventBuffer(uint32_t threadIndex) : m_events(new ProfileEvent[capacity]), m_threadIndex(threadIndex) {
 		}
 
-		void beginSession(const std::string& name, const std::string& filepath = "results.json") {
-			m_outputStream.open(filepath);
-			writeHeader();
-			m_currentSession = new InstrumentationSession{ name };
+		inline void push(const ProfileEvent& event) {
+			uint32_t head = m_head.load(std::memory_order_relaxed);
+			if (head - m_tail.load(std::memory_order_acquire) == capacity) {
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			m_events[head & (capacity - 1)] = event;
+			m_head.store(head + 1, std::memory_order_release);
 		}
 
-		void endSession() {
-			writeFooter();
-			m_outputStream.close();
-			delete m_currentSession;
-			m_currentSession = nullptr;
-			m_profileCount = 0;
+		// consumer side, calls fn for every event pushed so far in order
+		template<typename Fn>
+		void drain(Fn&& fn) {
+			uint32_t tail = m_tail.load(std::memory_order_relaxed);
+			uint32_t head = m_head.load(std::memory_order_acquire);
+			for (; tail != head; ++tail)
+				fn(m_events[tail & (capacity - 1)]);
+			m_tail.store(tail, std::memory_order_release);
 		}
 
-		void writeProfile(const ProfileResult& result) {
-			if (m_profileCount++ > 0)
-				m_outputStream << ",";
+		inline bool isEmpty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed); }
+		inline uint32_t getThreadIndex() const { return m_threadIndex; }
+		inline uint64_t takeDropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+
+		// set when the owning thread exits, the writer frees the buffer once it is drained
+		inline void retire() { m_retired.store(true, std::memory_order_release); }
+		inline bool isRetired() const { return m_retired.load(std::memory_order_acquire); }
+	private:
+		alignas(64) std::atomic<uint32_t> m_head{ 0 };
+		alignas(64) std::atomic<uint32_t> m_tail{ 0 };
+		alignas(64) std::atomic<uint64_t> m_dropped{ 0 };
+		std::atomic<bool> m_retired{ false };
+		std::unique_ptr<ProfileEvent[]> m_events;
+		uint32_t m_threadIndex;
+	};
+
+	struct ThreadBufferOwner;
+
+	struct FlightRecorderSettings {
+		float windowSeconds = 10.0f;   // how far back a dump reaches
+		uint32_t capacity = 1 << 18;   // events kept in memory (40 bytes each), the oldest are overwritten first
+		float hitchThresholdMs = 50.0f; // a longer frame (see markFrame) dumps the recorder, 0 - never
+		std::string directory = ".";   // dumps are named DeimosFlight-<reason>-<n>.json
+	};
+
+	// Writes Chrome trace files (chrome://tracing, ui.perfetto.dev). Recording an event only appends it to a buffer
+	// of the calling thread, a background thread formats and writes them.
+	// Besides a session, which writes everything to one file, the flight recorder keeps the last few seconds in a
+	// fixed size ring and writes them out only when asked to: through dumpFlightRecorder, a frame over the hitch
+	// threshold, or SIGUSR1 where the platform has it. Both can be active at once
+	class Instrumentor {
+	public:
+		Instrumentor();
+		~Instrumentor();
+
+		void beginSession(const std::string& name, const std::string& filepath = "results.json");
+		// waits until every event recorded so far is in the file
+		void endSession();
+		inline bool isSessionActive() const { return m_sessionActive.load(std::memory_order_relaxed); }
+
+		void beginFlightRecorder(const FlightRecorderSettings& settings = FlightRecorderSettings());
+		void endFlightRecorder();
+		inline bool isFlightRecorderActive() const { return m_flightRecorderActive.load(std::memory_order_relaxed); }
+		// doesn't block, the writer thread writes the file
+		void dumpFlightRecorder(const std::string& reason = "manual");
+		// once per frame from the main loop, checks the frame time against the hitch threshold
+		void markFrame();
+
+		// events are kept by a session or the flight recorder
+		inline bool isRecording() const { return m_recording.load(std::memory_order_relaxed); }
+
+		// categories recorded at runtime, all by default or as listed in the DM_PROFILE_CATEGORIES environment
+		// variable (e.g. "renderer,gl")
+		void setCategoryMask(uint32_t mask);
+		inline uint32_t getCategoryMask() const { return m_categoryMask; }
+		// recording and not masked out, one load for the scopes to check before reading the clock
+		inline bool isCategoryActive(ProfileCategory category) const {
+			return (m_activeCategories.load(std::memory_order_relaxed) & (uint32_t) category) != 0;
+		}
+		// comma separated category names, "all" or "none"
+		static uint32_t parseCategories(const std::string& list);
 
-			std::string name = result.name;
-			std::replace(name.begin(), name.end(), '"', '\'');
+		inline void recordScope(const char* name, ProfileCategory category, int64_t start, int64_t end) {
+			record({ name, start, end - start, 0, ProfileEventType::Scope, category });
+		}
+		// GPU timestamps converted to the steady clock (see OpenGLGPUProfiler)
+		void writeGPUProfile(const char* name, double startUs, double durationUs) {
+			if (!isCategoryActive(ProfileCategory::GLWrapper))
+				return;
+			record({ name, (int64_t) (startUs * 1000.0), (int64_t) (durationUs * 1000.0), 0, ProfileEventType::GPUScope,
+					 ProfileCategory::GLWrapper });
+		}
 
-			m_outputStream << std::setprecision(3) << std::fixed;
-			m_outputStream << "{";
-			m_outputStream << "\"cat\":\"function\",";
-			m_outputStream << "\"dur\":" << (result.elapsedTime.count()) << ',';
-			m_outputStream << "\"name\":\"" << name << "\",";
-			m_outputStream << "\"ph\":\"X\",";
-			m_outputStream << "\"pid\":0,";
-			m_outputStream << "\"tid\":" << result.threadID << ",";
-			m_outputStream << "\"ts\":" << result.start.count();
-			m_outputStream << "}";
+		// time is when the value starts to hold, now by default
+		inline void recordCounter(const char* name, ProfileCategory category, double value, int64_t time = now()) {
+			if (!isCategoryActive(category))
+				return;
+			ProfileEvent event{ name, time, 0, 0, ProfileEventType::Counter, category };
+			event.value = value;
+			record(event);
+		}
 
-			m_outputStream.flush();
+		inline void recordInstant(const char* name, ProfileCategory category) {
+			if (isCategoryActive(category))
+				record({ name, now(), 0, 0, ProfileEventType::Instant, category });
 		}
 
-		void writeHeader() {
-			m_outputStream << "{\"otherData\": {},\"traceEvents\":[";
-			m_outputStream.flush();
+		// begin and end are matched by name and id, any thread may end what another began
+		inline void recordAsyncBegin(const char* name, ProfileCategory category, uint64_t id) {
+			recordAsync(name, category, id, ProfileEventType::AsyncBegin);
+		}
+		inline void recordAsyncEnd(const char* name, ProfileCategory category, uint64_t id) {
+			recordAsync(name, category, id, ProfileEventType::AsyncEnd);
 		}
 
-		void writeFooter() {
-			m_outputStream << "]}";
-			m_outputStream.flush();
+		// shown for the calling thread's track instead of its index, kept across sessions
+		void setThreadName(const std::string& name);
+
+		// a copy of name that lives as long as the program, for scope names built at runtime
+		const char* internName(const std::string& name);
+
+		// the cheapest timestamp available, not in any particular unit
+		inline static int64_t now() {
+#if DM_PROFILE_TSC
+			return (int64_t) __rdtsc();
+#else
+			return steadyNanoseconds();
+#endif
+		}
+		inline static int64_t steadyNanoseconds() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 		}
 
 		static Instrumentor& get() {
 			static Instrumentor instance;
 			return instance;
 		}
+	private:
+		// events of a buffer together with the thread that recorded them
+		struct RecordedEvent {
+			ProfileEvent event;
+			uint32_t threadIndex;
+		};
+
+		// JSON being built, either the session file or a dump
+		struct TraceOutput {
+			std::string chunk;
+			uint64_t eventCount = 0;
+			bool gpuTrackNamed = false;
+			std::vector<const char*> threadNames; // by thread index, as last written
+		};
+
+		inline void recordAsync(const char* name, ProfileCategory category, uint64_t id, ProfileEventType type) {
+			if (!isCategoryActive(category))
+				return;
+			ProfileEvent event{ name, now(), 0, 0, type, category };
+			event.id = id;
+			record(event);
+		}
+
+		inline void record(ProfileEvent event) {
+			if (!isRecording())
+				return;
+
+			ProfileEventBuffer* buffer = s_threadBuffer;
+			if (!buffer && !(buffer = registerThread()))
+				return;
+			event.session = m_sessionID.load(std::memory_order_relaxed);
+			buffer->push(event);
+		}
+
+		ProfileEventBuffer* registerThread();
+
+		// with m_controlMutex held: starts or stops the writer to match what is active
+		void updateRecording();
+		// with m_controlMutex held
+		void finishSession();
+		// returns once the writer has drained every buffer after this call
+		void waitForDrain();
+
+		void writerLoop();
+		// moves the events from every buffer to the session file and the flight recorder, writer thread only
+		void drainBuffers();
+		void writeDumps();
+		void writeDump(const std::string& reason);
+		// measures the tick rate against the steady clock
+		void calibrateClock();
+		void toMicroseconds(const ProfileEvent& event, double& startUs, double& durationUs) const;
+		void appendThreadName(TraceOutput& output, uint32_t threadIndex) const;
+		void appendEvent(TraceOutput& output, const ProfileEvent& event, uint32_t threadIndex) const;
+	private:
+		friend struct ThreadBufferOwner;
+
+		inline static thread_local ProfileEventBuffer* s_threadBuffer = nullptr;
+
+		std::atomic<bool> m_recording{ false };
+		std::atomic<uint32_t> m_activeCategories{ 0 }; // m_categoryMask while recording, 0 otherwise
+		uint32_t m_categoryMask = (uint32_t) ProfileCategory::All;
+		std::atomic<bool> m_sessionActive{ false };
+		std::atomic<bool> m_flightRecorderActive{ false };
+		std::atomic<uint32_t> m_sessionID{ 0 };
+		std::mutex m_controlMutex; // begin / end of both
+
+		std::mutex m_buffersMutex;
+		std::vector<std::shared_ptr<ProfileEventBuffer>> m_buffers;
+		std::vector<const char*> m_threadNames; // by thread index, null until named
+		uint32_t m_nextThreadIndex = 0;
+
+		std::mutex m_namesMutex;
+		std::unordered_set<std::string> m_names;
+
+		// writer thread
+		std::thread m_writer;
+		std::mutex m_writerMutex;
+		std::condition_variable m_writerCondition;
+		bool m_stopWriter = false;
+		uint64_t m_drainsRequested = 0, m_drainsCompleted = 0;
+		uint64_t m_droppedCount = 0;
+		std::vector<const char*> m_writerThreadNames; // m_threadNames as of the last drain
+		int64_t m_baseTicks = 0, m_baseNanoseconds = 0;
+		double m_nanosecondsPerTick = 1.0;
+		bool m_clockCalibrated = false;
+
+		// session file, written by the writer thread between begin and end
+		std::mutex m_fileMutex;
+		std::ofstream m_outputStream;
+		TraceOutput m_fileOutput;
+
+		// flight recorder ring, filled and dumped by the writer thread
+		std::mutex m_flightMutex;
+		FlightRecorderSettings m_flightSettings;
+		std::vector<RecordedEvent> m_flightEvents;
+		size_t m_flightNext = 0; // where the next event goes
+		bool m_flightWrapped = false;
+		std::vector<std::string> m_pendingDumps;
+		uint32_t m_dumpCount = 0;
+
+		// main thread, markFrame
+		int64_t m_lastFrameNanoseconds = 0;
+		int64_t m_lastHitchDumpNanoseconds = 0;
 	};
 
+#ifdef DM_TRACK_ALLOCATIONS
+	// What the calling thread's heap allocations are attributed to (see AllocationTracker): the innermost profile
+	// scope, or an AllocationTagScope. tag is a ProfileCategory bit, 0 when untagged
+	struct AllocationScope {
+		const char* name;
+		uint8_t tag;
+
+		inline static thread_local AllocationScope* s_current = nullptr;
+	};
+#endif
+
 	class InstrumentationTimer {
 	public:
-		InstrumentationTimer(const char* name) : m_name(name), m_stopped(false) {
-			m_startTimepoint = std::chrono::steady_clock::now();
+		InstrumentationTimer(const char* name, ProfileCategory category = ProfileCategory::User)
+			: m_name(name), m_category(category) {
+#ifdef DM_TRACK_ALLOCATIONS
+			// attributed whether recording or not, the tracker reports on its own
+			m_allocationScope = { name, (uint8_t) category };
+			m_parentAllocationScope = AllocationScope::s_current;
+			AllocationScope::s_current = &m_allocationScope;
+#endif
+			// nothing is recorded for a masked out category, not even the clock is read
+			m_stopped = !Instrumentor::get().isCategoryActive(category);
+			if (!m_stopped)
+				m_start = Instrumentor::now();
 		}
 
 		~InstrumentationTimer() {
 			if (!m_stopped)
 				stop();
+#ifdef DM_TRACK_ALLOCATIONS
+			AllocationScope::s_current = m_parentAllocationScope;
+#endif
 		}
 
 		void stop() {
-			auto endTimepoint = std::chrono::steady_clock::now();
-
-			auto highResStart = FloatingPointMicroseconds{ m_startTimepoint.time_since_epoch() };
-			auto elapsedTime = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch() - std::chrono::time_point_cast<std::chrono::microseconds>(m_startTimepoint).time_since_epoch();			std::thread::id id = std::this_thread::get_id();
-
-			Instrumentor::get().writeProfile({ m_name, highResStart, elapsedTime, id });
-
+			Instrumentor::get().recordScope(m_name, m_category, m_start, Instrumentor::now());
 			m_stopped = true;
 		}
 	private:
 		const char* m_name;
-		std::chrono::time_point<std::chrono::steady_clock> m_startTimepoint;
+		int64_t m_start = 0;
+		ProfileCategory m_category;
 		bool m_stopped;
+#ifdef DM_TRACK_ALLOCATIONS
+		AllocationScope m_allocationScope;
+		AllocationScope* m_parentAllocationScope;
+#endif
+	};
+
+	// a scope of a category stripped by DM_PROFILE_LEVEL is an empty object
+	template<ProfileCategory Category, bool Enabled = getProfileCategoryLevel(Category) <= DM_PROFILE_LEVEL>
+	class CategoryInstrumentationTimer : public InstrumentationTimer {
+	public:
+		CategoryInstrumentationTimer(const char* name) : InstrumentationTimer(name, Category) {
+		}
+	};
+
+	template<ProfileCategory Category>
+	class CategoryInstrumentationTimer<Category, false> {
+	public:
+		CategoryInstrumentationTimer(const char*) {
+		}
 	};
 }
 
-#define DM_PROFILE 1
 #if DM_PROFILE
 	#define DM_PROFILE_BEGIN_SESSION(name, filepath) ::Deimos::Instrumentor::get().beginSession(name, filepath)
 	#define DM_PROFILE_END_SESSION() ::Deimos::Instrumentor::get().endSession()
+	#define DM_PROFILE_BEGIN_FLIGHT_RECORDER(settings) ::Deimos::Instrumentor::get().beginFlightRecorder(settings)
+	#define DM_PROFILE_END_FLIGHT_RECORDER() ::Deimos::Instrumentor::get().endFlightRecorder()
+	#define DM_PROFILE_DUMP_FLIGHT_RECORDER(reason) ::Deimos::Instrumentor::get().dumpFlightRecorder(reason)
+	#define DM_PROFILE_FRAME() ::Deimos::Instrumentor::get().markFrame()
 
 	#if defined(__GNUC__) || (defined(__MWERKS__) && (__MWERKS__ >= 0x3000)) || (defined(__ICC) && (__ICC >= 600)) || defined(__ghs__)
 		#define DM_FUNC_SIG __PRETTY_FUNCTION__
@@ -133,11 +425,59 @@ namespace Deimos {
 		#define DM_FUNC_SIG "DM_FUNC_SIG unknown!"
 	#endif
 
-	#define DM_PROFILE_SCOPE(name) ::Deimos::InstrumentationTimer timer##__LINE__(name);
+	// category is one of the ProfileCategory names, e.g. DM_PROFILE_CATEGORY_FUNCTION(Renderer)
+	#define DM_PROFILE_CATEGORY_SCOPE(category, name) \
+		::Deimos::CategoryInstrumentationTimer<::Deimos::ProfileCategory::category> timer##__LINE__(name);
+	#define DM_PROFILE_CATEGORY_FUNCTION(category) DM_PROFILE_CATEGORY_SCOPE(category, DM_FUNC_SIG)
+	#define DM_PROFILE_SCOPE(name) DM_PROFILE_CATEGORY_SCOPE(User, name)
 	#define DM_PROFILE_FUNCTION() DM_PROFILE_SCOPE(DM_FUNC_SIG)
+
+	// value is only evaluated while the category is recorded
+	#define DM_PROFILE_CATEGORY_COUNTER(category, name, value) \
+		do { \
+			if constexpr (::Deimos::getProfileCategoryLevel(::Deimos::ProfileCategory::category) <= DM_PROFILE_LEVEL) { \
+				if (::Deimos::Instrumentor::get().isCategoryActive(::Deimos::ProfileCategory::category)) \
+					::Deimos::Instrumentor::get().recordCounter(name, ::Deimos::ProfileCategory::category, (double) (value)); \
+			} \
+		} while (0)
+	#define DM_PROFILE_CATEGORY_INSTANT(category, name) \
+		do { \
+			if constexpr (::Deimos::getProfileCategoryLevel(::Deimos::ProfileCategory::category) <= DM_PROFILE_LEVEL) \
+				::Deimos::Instrumentor::get().recordInstant(name, ::Deimos::ProfileCategory::category); \
+		} while (0)
+	#define DM_PROFILE_CATEGORY_ASYNC_BEGIN(category, name, id) \
+		do { \
+			if constexpr (::Deimos::getProfileCategoryLevel(::Deimos::ProfileCategory::category) <= DM_PROFILE_LEVEL) \
+				::Deimos::Instrumentor::get().recordAsyncBegin(name, ::Deimos::ProfileCategory::category, (uint64_t) (id)); \
+		} while (0)
+	#define DM_PROFILE_CATEGORY_ASYNC_END(category, name, id) \
+		do { \
+			if constexpr (::Deimos::getProfileCategoryLevel(::Deimos::ProfileCategory::category) <= DM_PROFILE_LEVEL) \
+				::Deimos::Instrumentor::get().recordAsyncEnd(name, ::Deimos::ProfileCategory::category, (uint64_t) (id)); \
+		} while (0)
+	#define DM_PROFILE_COUNTER(name, value) DM_PROFILE_CATEGORY_COUNTER(User, name, value)
+	#define DM_PROFILE_INSTANT(name) DM_PROFILE_CATEGORY_INSTANT(User, name)
+	#define DM_PROFILE_ASYNC_BEGIN(name, id) DM_PROFILE_CATEGORY_ASYNC_BEGIN(User, name, id)
+	#define DM_PROFILE_ASYNC_END(name, id) DM_PROFILE_CATEGORY_ASYNC_END(User, name, id)
+	#define DM_PROFILE_THREAD_NAME(name) ::Deimos::Instrumentor::get().setThreadName(name)
 #else
 	#define DM_PROFILE_BEGIN_SESSION(name, filepath)
 	#define DM_PROFILE_END_SESSION()
+	#define DM_PROFILE_BEGIN_FLIGHT_RECORDER(settings)
+	#define DM_PROFILE_END_FLIGHT_RECORDER()
+	#define DM_PROFILE_DUMP_FLIGHT_RECORDER(reason)
+	#define DM_PROFILE_FRAME()
+	#define DM_PROFILE_CATEGORY_SCOPE(category, name)
+	#define DM_PROFILE_CATEGORY_FUNCTION(category)
 	#define DM_PROFILE_SCOPE(name)
 	#define DM_PROFILE_FUNCTION()
+	#define DM_PROFILE_CATEGORY_COUNTER(category, name, value)
+	#define DM_PROFILE_CATEGORY_INSTANT(category, name)
+	#define DM_PROFILE_CATEGORY_ASYNC_BEGIN(category, name, id)
+	#define DM_PROFILE_CATEGORY_ASYNC_END(category, name, id)
+	#define DM_PROFILE_COUNTER(name, value)
+	#define DM_PROFILE_INSTANT(name)
+	#define DM_PROFILE_ASYNC_BEGIN(name, id)
+	#define DM_PROFILE_ASYNC_END(name, id)
+	#define DM_PROFILE_THREAD_NAME(name)
 #endif
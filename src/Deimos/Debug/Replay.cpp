@@ -0,0 +1,480 @@
+#include "dmpch.h"
+#include "Replay.h"
+
+#include "Deimos/Core/Application.h"
+#include "Deimos/Core/Input.h"
+#include "Deimos/Events/ApplicationEvent.h"
+#include "Deimos/Events/KeyEvent.h"
+#include "Deimos/Events/MouseEvent.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace Deimos {
+    // answers polling from the scripted events, so layers see the same state the recording did
+    class ReplayInput : public Input {
+    public:
+        void apply(const ReplayEvent &event) {
+            switch (event.type) {
+                case EventType::KeyPressed:          m_keys.insert(event.code); break;
+                case EventType::KeyReleased:         m_keys.erase(event.code); break;
+                case EventType::MouseButtonPressed:  m_buttons.insert(event.code); break;
+                case EventType::MouseButtonReleased: m_buttons.erase(event.code); break;
+                case EventType::MouseMoved:          m_mouseX = event.x; m_mouseY = event.y; break;
+                default: break;
+            }
+        }
+    protected:
+        bool isKeyPressedImpl(int keycode) override { return m_keys.count(keycode); }
+        bool isMouseButtonPressedImpl(int button) override { return m_buttons.count(button); }
+        std::pair<float, float> getMousePositionImpl() override { return { m_mouseX, m_mouseY }; }
+        float getMouseXImpl() override { return m_mouseX; }
+        float getMouseYImpl() override { return m_mouseY; }
+    private:
+        std::unordered_set<int> m_keys;
+        std::unordered_set<int> m_buttons;
+        float m_mouseX = 0.f, m_mouseY = 0.f;
+    };
+
+    static ReplayInput *s_replayInput = nullptr; // owned by Input while a script plays
+
+    struct ReplaySummary {
+        float p50 = 0.f, p95 = 0.f, p99 = 0.f, max = 0.f, mean = 0.f;
+        uint64_t drawCalls = 0, quads = 0, shapes = 0;
+    };
+
+    // timings leave out the warm-up frames, counters cover every frame
+    static ReplaySummary summarize(const std::vector<ReplayFrame> &frames, uint32_t warmupFrames) {
+        ReplaySummary summary;
+        std::vector<float> times;
+        for (size_t i = 0; i < frames.size(); i++) {
+            summary.drawCalls += frames[i].renderer.drawCalls;
+            summary.quads += frames[i].renderer.quads;
+            summary.shapes += frames[i].renderer.shapes;
+            if (i >= warmupFrames)
+                times.push_back(frames[i].milliseconds);
+        }
+        if (times.empty())
+            return summary;
+
+        std::sort(times.begin(), times.end());
+        auto percentile = [&](float p) { // nearest rank
+            size_t rank = (size_t) std::ceil(p * (float) times.size());
+            return times[std::clamp<size_t>(rank, 1, times.size()) - 1];
+        };
+        summary.p50 = percentile(0.50f);
+        summary.p95 = percentile(0.95f);
+        summary.p99 = percentile(0.99f);
+        summary.max = times.back();
+        double sum = 0.0;
+        for (float time : times)
+            sum += time;
+        summary.mean = (float) (sum / (double) times.size());
+        return summary;
+    }
+
+    bool ReplaySettings::parseCommandLine(int argc, char **argv, ReplaySettings &settings) {
+        // other arguments belong to the application
+        for (int i = 1; i < argc; i++) {
+            const char *arg = argv[i];
+            const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+            bool used = true;
+            if (!std::strcmp(arg, "--replay-write-baseline")) {
+                settings.writeBaseline = true;
+                continue;
+            } else if (!value) {
+                used = false;
+            } else if (!std::strcmp(arg, "--replay")) {
+                settings.scriptPath = value;
+            } else if (!std::strcmp(arg, "--record")) {
+                settings.recordPath = value;
+            } else if (!std::strcmp(arg, "--replay-frames")) {
+                settings.frames = (uint32_t) std::strtoul(value, nullptr, 10);
+            } else if (!std::strcmp(arg, "--replay-timestep")) {
+                settings.timestep = std::max(0.f, std::strtof(value, nullptr));
+            } else if (!std::strcmp(arg, "--replay-warmup")) {
+                settings.warmupFrames = (uint32_t) std::strtoul(value, nullptr, 10);
+            } else if (!std::strcmp(arg, "--replay-results")) {
+                settings.resultsPath = value;
+            } else if (!std::strcmp(arg, "--replay-baseline")) {
+                settings.baselinePath = value;
+            } else if (!std::strcmp(arg, "--replay-time-tolerance")) {
+                settings.timeTolerance = std::max(0.f, std::strtof(value, nullptr));
+            } else if (!std::strcmp(arg, "--replay-counter-tolerance")) {
+                settings.counterTolerance = std::max(0.f, std::strtof(value, nullptr));
+            } else {
+                used = false;
+            }
+            if (used)
+                i++;
+        }
+
+        if (!settings.scriptPath.empty() && !settings.recordPath.empty()) {
+            DM_CORE_WARN("Replay: both --replay and --record given, only replaying '{0}'", settings.scriptPath);
+            settings.recordPath.clear();
+        }
+        return !settings.scriptPath.empty() || !settings.recordPath.empty();
+    }
+
+    static bool parseEventType(const std::string &name, EventType &type) {
+        static const std::pair<const char*, EventType> s_types[] = {
+            { "KeyPressed", EventType::KeyPressed }, { "KeyReleased", EventType::KeyReleased },
+            { "KeyTyped", EventType::KeyTyped },
+            { "MouseButtonPressed", EventType::MouseButtonPressed },
+            { "MouseButtonReleased", EventType::MouseButtonReleased },
+            { "MouseMoved", EventType::MouseMoved }, { "MouseScrolled", EventType::MouseScrolled },
+            { "WindowsResize", EventType::WindowsResize }, { "WindowsClose", EventType::WindowsClose }
+        };
+        for (auto &[typeName, value] : s_types) {
+            if (name == typeName) {
+                type = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReplaySession::loadScript(const std::string &path, std::vector<ReplayEvent> &events, float &timestep) {
+        std::ifstream in(path);
+        if (!in) {
+            DM_CORE_ERROR("Replay: could not open script '{0}'", path);
+            return false;
+        }
+
+        std::string line;
+        for (uint32_t lineNumber = 1; std::getline(in, line); lineNumber++) {
+            line = line.substr(0, line.find('#'));
+            std::istringstream fields(line);
+            std::string first, name;
+            if (!(fields >> first))
+                continue;
+
+            if (first == "timestep") {
+                fields >> timestep;
+                continue;
+            }
+
+            ReplayEvent event{};
+            event.frame = (uint32_t) std::strtoul(first.c_str(), nullptr, 10);
+            if (!(fields >> name) || !parseEventType(name, event.type)) {
+                DM_CORE_ERROR("Replay: {0}:{1}: unknown event '{2}'", path, lineNumber, name);
+                return false;
+            }
+
+            switch (event.type) {
+                case EventType::KeyPressed:
+                case EventType::WindowsResize:
+                    fields >> event.code >> event.repeat;
+                    break;
+                case EventType::KeyReleased:
+                case EventType::KeyTyped:
+                case EventType::MouseButtonPressed:
+                case EventType::MouseButtonReleased:
+                    fields >> event.code;
+                    break;
+                case EventType::MouseMoved:
+                case EventType::MouseScrolled:
+                    fields >> event.x >> event.y;
+                    break;
+                default:
+                    break;
+            }
+            if (fields.fail()) {
+                DM_CORE_ERROR("Replay: {0}:{1}: missing arguments for {2}", path, lineNumber, name);
+                return false;
+            }
+            events.push_back(event);
+        }
+
+        // events of one frame keep their order
+        std::stable_sort(events.begin(), events.end(), [](const ReplayEvent &a, const ReplayEvent &b) {
+            return a.frame < b.frame;
+        });
+        return true;
+    }
+
+    std::string ReplaySession::formatEvent(uint32_t frame, Event &e) {
+        std::ostringstream line;
+        line << frame << ' ' << e.getName();
+        switch (e.getEventType()) {
+            case EventType::KeyPressed: {
+                auto &key = static_cast<KeyPressedEvent&>(e);
+                line << ' ' << key.getKeyCode() << ' ' << key.getRepeatCount();
+                break;
+            }
+            case EventType::KeyReleased:
+            case EventType::KeyTyped:
+                line << ' ' << static_cast<KeyEvent&>(e).getKeyCode();
+                break;
+            case EventType::MouseButtonPressed:
+            case EventType::MouseButtonReleased:
+                line << ' ' << static_cast<MouseButtonEvent&>(e).getMouseButton();
+                break;
+            case EventType::MouseMoved: {
+                auto &moved = static_cast<MouseMovedEvent&>(e);
+                line << ' ' << moved.getX() << ' ' << moved.getY();
+                break;
+            }
+            case EventType::MouseScrolled: {
+                auto &scrolled = static_cast<MouseScrolledEvent&>(e);
+                line << ' ' << scrolled.getXOffset() << ' ' << scrolled.getYOffset();
+                break;
+            }
+            case EventType::WindowsResize: {
+                auto &resize = static_cast<WindowResizeEvent&>(e);
+                line << ' ' << resize.getWidth() << ' ' << resize.getHeight();
+                break;
+            }
+            case EventType::WindowsClose:
+                break;
+            default:
+                return {}; // focus and the like don't change what is drawn
+        }
+        return line.str();
+    }
+
+    ReplaySession::ReplaySession(const ReplaySettings &settings) : m_settings(settings) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        float timestep = 0.f;
+        if (!isRecording()) {
+            m_valid = loadScript(settings.scriptPath, m_events, timestep);
+            if (!m_valid)
+                return;
+        }
+        if (settings.timestep > 0.f)
+            timestep = settings.timestep;
+        m_timestep = timestep > 0.f ? timestep : 1.f / 60.f;
+
+        m_frameCount = settings.frames;
+        if (m_frameCount == 0 && !isRecording()) {
+            if (m_events.empty()) {
+                DM_CORE_ERROR("Replay: '{0}' has no events, give the length with --replay-frames", settings.scriptPath);
+                m_valid = false;
+                return;
+            }
+            m_frameCount = m_events.back().frame + 1;
+        }
+        m_frames.reserve(m_frameCount);
+
+        if (!isRecording()) {
+            auto input = createScope<ReplayInput>();
+            s_replayInput = input.get();
+            m_liveInput = Input::setInstance(std::move(input));
+        }
+
+        if (isRecording()) {
+            DM_CORE_INFO("Replay: recording to '{0}' with a {1} ms timestep", settings.recordPath, m_timestep.getMilliseconds());
+        } else {
+            DM_CORE_INFO("Replay: playing '{0}' for {1} frames with a {2} ms timestep", settings.scriptPath,
+                         m_frameCount, m_timestep.getMilliseconds());
+        }
+    }
+
+    ReplaySession::~ReplaySession() {
+        if (m_liveInput) {
+            Input::setInstance(std::move(m_liveInput));
+            s_replayInput = nullptr;
+        }
+    }
+
+    void ReplaySession::beginFrame(Application &app) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        m_frameStart = std::chrono::steady_clock::now();
+        m_inFrame = true;
+        Renderer2D::resetStats();
+
+        m_dispatching = true;
+        for (; m_nextEvent < m_events.size() && m_events[m_nextEvent].frame <= m_frame; m_nextEvent++) {
+            const ReplayEvent &event = m_events[m_nextEvent];
+            s_replayInput->apply(event);
+            switch (event.type) {
+                case EventType::KeyPressed:          { KeyPressedEvent e(event.code, event.repeat); app.onEvent(e); break; }
+                case EventType::KeyReleased:         { KeyReleasedEvent e(event.code); app.onEvent(e); break; }
+                case EventType::KeyTyped:            { KeyTypedEvent e(event.code); app.onEvent(e); break; }
+                case EventType::MouseButtonPressed:  { MouseButtonPressedEvent e(event.code); app.onEvent(e); break; }
+                case EventType::MouseButtonReleased: { MouseButtonReleasedEvent e(event.code); app.onEvent(e); break; }
+                case EventType::MouseMoved:          { MouseMovedEvent e(event.x, event.y); app.onEvent(e); break; }
+                case EventType::MouseScrolled:       { MouseScrolledEvent e(event.x, event.y); app.onEvent(e); break; }
+                case EventType::WindowsResize:       { WindowResizeEvent e(event.code, event.repeat); app.onEvent(e); break; }
+                case EventType::WindowsClose:        { WindowCloseEvent e; app.onEvent(e); break; }
+                default: break;
+            }
+        }
+        m_dispatching = false;
+    }
+
+    bool ReplaySession::endFrame() {
+        float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_frameStart).count();
+        m_frames.push_back({ milliseconds, Renderer2D::getStats() });
+        m_frame++;
+        m_inFrame = false;
+        return m_frameCount == 0 || m_frame < m_frameCount;
+    }
+
+    bool ReplaySession::onLiveEvent(Event &e) {
+        if (m_dispatching)
+            return true;
+
+        if (isRecording()) {
+            // polled after the frame's update, so the next frame is the first to see it
+            std::string line = formatEvent(m_inFrame ? m_frame + 1 : m_frame, e);
+            if (!line.empty())
+                m_recorded.push_back(std::move(line));
+            return true;
+        }
+        return e.getEventType() == EventType::WindowsClose;
+    }
+
+    // a JSON string literal, Windows paths are full of backslashes
+    static std::string escapeJson(const std::string &text) {
+        std::string escaped = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if ((unsigned char) c < 0x20) {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", (unsigned) c);
+                escaped += code;
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped + '"';
+    }
+
+    bool ReplaySession::writeResults(const std::string &path) const {
+        std::ofstream out(path);
+        if (!out) {
+            DM_CORE_ERROR("Replay: could not open '{0}' for writing", path);
+            return false;
+        }
+
+        ReplaySummary summary = summarize(m_frames, m_settings.warmupFrames);
+        char text[512];
+        out << "{\n";
+        out << "  \"script\": " << escapeJson(isRecording() ? m_settings.recordPath : m_settings.scriptPath) << ",\n";
+        std::snprintf(text, sizeof(text),
+                      "  \"timestep\": %.7f,\n  \"frames\": %zu,\n  \"warmupFrames\": %u,\n"
+                      "  \"summary\": {\"frameTimeP50\": %.4f, \"frameTimeP95\": %.4f, \"frameTimeP99\": %.4f, "
+                      "\"frameTimeMax\": %.4f, \"frameTimeMean\": %.4f, \"drawCalls\": %llu, \"quads\": %llu, \"shapes\": %llu},\n",
+                      m_timestep.getSeconds(), m_frames.size(), m_settings.warmupFrames,
+                      summary.p50, summary.p95, summary.p99, summary.max, summary.mean,
+                      (unsigned long long) summary.drawCalls, (unsigned long long) summary.quads,
+                      (unsigned long long) summary.shapes);
+        out << text;
+        out << "  \"perFrame\": [\n";
+        for (size_t i = 0; i < m_frames.size(); i++) {
+            const ReplayFrame &frame = m_frames[i];
+            std::snprintf(text, sizeof(text), "    {\"frame\": %zu, \"ms\": %.4f, \"drawCalls\": %u, \"quads\": %u, \"shapes\": %u}%s\n",
+                          i, frame.milliseconds, frame.renderer.drawCalls, frame.renderer.quads, frame.renderer.shapes,
+                          i + 1 < m_frames.size() ? "," : "");
+            out << text;
+        }
+        out << "  ]\n}\n";
+        return (bool) out;
+    }
+
+    // the files are ours, a key lookup is all the parsing they need
+    static bool readNumber(const std::string &json, const char *key, double &value) {
+        std::string quoted = std::string("\"") + key + "\":";
+        size_t position = json.find(quoted);
+        if (position == std::string::npos)
+            return false;
+
+        const char *start = json.c_str() + position + quoted.size();
+        char *end = nullptr;
+        value = std::strtod(start, &end);
+        return end != start;
+    }
+
+    int ReplaySession::compareWithBaseline() const {
+        std::ifstream in(m_settings.baselinePath);
+        if (!in) {
+            DM_CORE_ERROR("Replay: could not open baseline '{0}'", m_settings.baselinePath);
+            return 2;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string baseline = buffer.str();
+
+        double baselineFrames = 0.0;
+        if (!readNumber(baseline, "frames", baselineFrames) || (size_t) baselineFrames != m_frames.size()) {
+            DM_CORE_ERROR("Replay: baseline '{0}' ran {1} frames, this run {2}, not comparable",
+                          m_settings.baselinePath, baselineFrames, m_frames.size());
+            return 2;
+        }
+
+        ReplaySummary summary = summarize(m_frames, m_settings.warmupFrames);
+        struct Metric {
+            const char *key;
+            double value;
+            bool timing; // one-sided, only slower is a regression
+        };
+        const Metric metrics[] = {
+            { "frameTimeP50", summary.p50, true }, { "frameTimeP95", summary.p95, true },
+            { "frameTimeP99", summary.p99, true }, { "frameTimeMean", summary.mean, true },
+            { "drawCalls", (double) summary.drawCalls, false }, { "quads", (double) summary.quads, false },
+            { "shapes", (double) summary.shapes, false }
+        };
+
+        uint32_t regressions = 0;
+        DM_CORE_INFO("Replay against '{0}':", m_settings.baselinePath);
+        for (const Metric &metric : metrics) {
+            double expected = 0.0;
+            if (!readNumber(baseline, metric.key, expected)) {
+                DM_CORE_ERROR("Replay: baseline has no '{0}'", metric.key);
+                return 2;
+            }
+
+            double change = expected != 0.0 ? (metric.value - expected) / expected : (metric.value != 0.0 ? 1.0 : 0.0);
+            bool regressed = metric.timing ? change > m_settings.timeTolerance
+                                           : std::abs(change) > m_settings.counterTolerance;
+            regressions += regressed;
+            DM_CORE_INFO("  {0:<14} {1:12.3f} baseline {2:12.3f} {3:+7.1f}%{4}", metric.key, metric.value, expected,
+                         change * 100.0, regressed ? "  REGRESSED" : "");
+        }
+
+        if (regressions) {
+            DM_CORE_ERROR("Replay: {0} metric(s) outside tolerance (timings {1:.0f}%, counters {2:.0f}%)",
+                          regressions, m_settings.timeTolerance * 100.f, m_settings.counterTolerance * 100.f);
+        } else {
+            DM_CORE_INFO("Replay: within tolerance of the baseline");
+        }
+        return regressions ? 1 : 0;
+    }
+
+    int ReplaySession::finish() {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        if (isRecording()) {
+            std::ofstream out(m_settings.recordPath);
+            out << "# Deimos replay script, recorded over " << m_frames.size() << " frames\n";
+            out << "timestep " << m_timestep.getSeconds() << "\n";
+            for (const std::string &line : m_recorded)
+                out << line << "\n";
+            if (!out) {
+                DM_CORE_ERROR("Replay: could not write script '{0}'", m_settings.recordPath);
+                return 2;
+            }
+            DM_CORE_INFO("Replay: recorded {0} events to '{1}'", m_recorded.size(), m_settings.recordPath);
+        }
+
+        if (!m_settings.resultsPath.empty() && !writeResults(m_settings.resultsPath))
+            return 2;
+
+        if (m_settings.baselinePath.empty())
+            return 0;
+        if (m_settings.writeBaseline) {
+            if (!writeResults(m_settings.baselinePath))
+                return 2;
+            DM_CORE_INFO("Replay: baseline '{0}' written", m_settings.baselinePath);
+            return 0;
+        }
+        return compareWithBaseline();
+    }
+}
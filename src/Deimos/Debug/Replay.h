@@ -0,0 +1,108 @@
+#ifndef ENGINE_REPLAY_H
+#define ENGINE_REPLAY_H
+
+#include "Deimos/Core/Core.h"
+#include "Deimos/Core/Timestep.h"
+#include "Deimos/Events/Event.h"
+#include "Deimos/Renderer/Renderer2D.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Deimos {
+    class Application;
+    class Input;
+
+    struct ReplaySettings {
+        std::string scriptPath;   // events to play back
+        std::string recordPath;   // or live events to record, one of the two
+        uint32_t frames = 0;      // 0 runs to the script's last event, or until closed while recording
+        float timestep = 0.f;     // seconds, 0 takes the script's or 1/60
+        uint32_t warmupFrames = 10; // not part of the timings, shaders and textures settle in them
+
+        std::string resultsPath = "DeimosReplay.json";
+        std::string baselinePath; // compared against when set
+        bool writeBaseline = false; // the results replace the baseline instead
+
+        float timeTolerance = 0.10f;  // a timing regresses above baseline * (1 + tolerance)
+        float counterTolerance = 0.f; // relative, renderer counters should match exactly
+
+        // --replay FILE | --record FILE, --replay-frames N, --replay-timestep SECONDS, --replay-warmup N,
+        // --replay-results FILE, --replay-baseline FILE, --replay-write-baseline,
+        // --replay-time-tolerance FRACTION, --replay-counter-tolerance FRACTION.
+        // false when none of them is present
+        static bool parseCommandLine(int argc, char** argv, ReplaySettings& settings);
+    };
+
+    struct ReplayEvent {
+        uint32_t frame;
+        EventType type;
+        int code = 0;         // key or mouse button, the width of a resize
+        int repeat = 0;       // repeat count of a key press, the height of a resize
+        float x = 0.f, y = 0.f; // mouse position or scroll offsets
+    };
+
+    struct ReplayFrame {
+        float milliseconds; // CPU time of the whole run loop iteration
+        Renderer2DStatistics renderer;
+    };
+
+    // Runs the application deterministically: a fixed timestep and the events of a script instead of live input,
+    // which is dropped except for closing the window. Every frame's CPU time and Renderer2D counters are
+    // captured, written out as JSON and compared against a baseline from an earlier run. Recording does the
+    // reverse and writes the live events, tagged with the frame that sees them, as a script.
+    // Script lines are "frame EventName arguments", '#' starts a comment:
+    //   timestep 0.0166667
+    //   12 KeyPressed 65 0
+    //   40 MouseMoved 640 360
+    class ReplaySession {
+    public:
+        ReplaySession(const ReplaySettings& settings);
+        ~ReplaySession();
+
+        // false when the script could not be read
+        bool isValid() const { return m_valid; }
+        bool isRecording() const { return !m_settings.recordPath.empty(); }
+
+        // dispatches the frame's scripted events through the application
+        void beginFrame(Application& app);
+        // false once the last frame ran
+        bool endFrame();
+
+        Timestep getTimestep() const { return m_timestep; }
+
+        // live events, false when the application should ignore them
+        bool onLiveEvent(Event& e);
+
+        // writes the results, compares them to the baseline, returns the process exit code:
+        // 0 when within tolerance, 1 on a regression, 2 when the baseline or results could not be used
+        int finish();
+
+        static bool loadScript(const std::string& path, std::vector<ReplayEvent>& events, float& timestep);
+        static std::string formatEvent(uint32_t frame, Event& e);
+    private:
+        bool writeResults(const std::string& path) const;
+        int compareWithBaseline() const;
+    private:
+        ReplaySettings m_settings;
+        bool m_valid = true;
+        Timestep m_timestep = 1.f / 60.f;
+
+        std::vector<ReplayEvent> m_events; // sorted by frame
+        size_t m_nextEvent = 0;
+        bool m_dispatching = false;
+        std::vector<std::string> m_recorded;
+
+        uint32_t m_frame = 0;
+        bool m_inFrame = false;
+        uint32_t m_frameCount = 0;
+        std::chrono::steady_clock::time_point m_frameStart;
+        std::vector<ReplayFrame> m_frames;
+
+        Scope<Input> m_liveInput; // put back when the session ends
+    };
+}
+
+
+#endif //ENGINE_REPLAY_H
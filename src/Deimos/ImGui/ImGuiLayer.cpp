@@ -17,7 +17,7 @@ namespace Deimos {
     }
 
     void ImGuiLayer::onAttach() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         // Setup Dear ImGui context
         IMGUI_CHECKVERSION();
@@ -56,7 +56,7 @@ namespace Deimos {
     }
 
     void ImGuiLayer::onDetach() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
@@ -64,7 +64,7 @@ namespace Deimos {
     }
 
     void ImGuiLayer::begin() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -72,7 +72,7 @@ namespace Deimos {
     }
 
     void ImGuiLayer::end() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         ImGuiIO& io = ImGui::GetIO();
         Application& app = Application::get();
@@ -31,4 +31,13 @@ namespace Deimos {
         return nullptr;
     }
 
+    Ref<StorageBuffer> StorageBuffer::create(uint32_t size) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None: DM_ASSERT(false, "Deimos currently does not support RendererAPI::None!");
+            case RendererAPI::API::OpenGL: return createRef<OpenGLStorageBuffer>(size);
+        }
+        DM_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
 }
@@ -116,6 +116,19 @@ namespace Deimos {
         static Ref<IndexBuffer> create(uint32_t* indices, int count);
         virtual int getCount() const = 0;
     };
+
+    // shader storage buffer, read by shaders through a std430 block
+    class StorageBuffer {
+    public:
+        virtual ~StorageBuffer(){};
+
+        virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+        virtual void bind(uint32_t binding) const = 0;
+
+        virtual uint32_t getSize() const = 0;
+
+        static Ref<StorageBuffer> create(uint32_t size);
+    };
 }
 
 
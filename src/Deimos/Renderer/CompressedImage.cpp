@@ -0,0 +1,549 @@
+#include "dmpch.h"
+#include "CompressedImage.h"
+#include "MipmapGenerator.h"
+
+#include <fstream>
+
+namespace Deimos {
+    // container codes of the formats, 0 - the container can't store it
+    struct ContainerFormat {
+        TextureFormat format;
+        uint32_t vkFormat;   // KTX2
+        uint32_t dxgiFormat; // DDS DX10 header
+        uint32_t fourCC;     // legacy DDS header
+    };
+
+    static uint32_t makeFourCC(const char* code) {
+        return (uint32_t) code[0] | ((uint32_t) code[1] << 8) | ((uint32_t) code[2] << 16) | ((uint32_t) code[3] << 24);
+    }
+
+    static const ContainerFormat s_containerFormats[] = {
+        { TextureFormat::RGB8,     23,  0,  0 },
+        { TextureFormat::RGBA8,    37,  28, 0 },
+        { TextureFormat::BC1,      133, 71, makeFourCC("DXT1") },
+        { TextureFormat::BC3,      137, 77, makeFourCC("DXT5") },
+        { TextureFormat::BC7,      145, 98, 0 },
+        { TextureFormat::ETC2RGB,  147, 0,  0 },
+        { TextureFormat::ETC2RGBA, 151, 0,  0 },
+    };
+
+    static const ContainerFormat* findContainerFormat(TextureFormat format) {
+        for (const ContainerFormat &entry : s_containerFormats) {
+            if (entry.format == format)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    static const uint8_t s_ktx2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+    // the containers are little endian, so are all the platforms we build for
+    static inline uint32_t read32(const uint8_t* data) { uint32_t value; memcpy(&value, data, 4); return value; }
+    static inline uint64_t read64(const uint8_t* data) { uint64_t value; memcpy(&value, data, 8); return value; }
+
+    static inline void write8(std::vector<uint8_t>& out, uint8_t value) { out.push_back(value); }
+    static inline void write16(std::vector<uint8_t>& out, uint16_t value) { out.insert(out.end(), (uint8_t*) &value, (uint8_t*) &value + 2); }
+    static inline void write32(std::vector<uint8_t>& out, uint32_t value) { out.insert(out.end(), (uint8_t*) &value, (uint8_t*) &value + 4); }
+    static inline void write64(std::vector<uint8_t>& out, uint64_t value) { out.insert(out.end(), (uint8_t*) &value, (uint8_t*) &value + 8); }
+    static inline void pad(std::vector<uint8_t>& out, size_t alignment) {
+        while (out.size() % alignment)
+            out.push_back(0);
+    }
+
+    static bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            DM_CORE_ERROR("Could not open '{0}' for writing", path);
+            return false;
+        }
+        file.write((const char*) data.data(), (std::streamsize) data.size());
+        return (bool) file;
+    }
+
+    // the counts come from files, a chain can't be longer than the one down to 1x1
+    static bool isValidChain(uint32_t width, uint32_t height, uint32_t levelCount) {
+        return width && height && levelCount <= MipmapGenerator::getLevelCount(width, height);
+    }
+
+    CompressedImage::CompressedImage(TextureFormat format, uint32_t width, uint32_t height)
+        : m_format(format), m_width(width), m_height(height) {
+    }
+
+    void CompressedImage::addLevel(const void *data, size_t size) {
+        uint32_t index = getLevelCount();
+        uint32_t width = std::max(1u, m_width >> index);
+        uint32_t height = std::max(1u, m_height >> index);
+        DM_CORE_ASSERT(size == getLevelSize(m_format, width, height), "Compressed level has a wrong size!");
+        DM_CORE_ASSERT(!m_view, "Can't add levels to a view!");
+
+        m_levels.push_back({ width, height, m_data.size(), size });
+        m_data.insert(m_data.end(), (const uint8_t*) data, (const uint8_t*) data + size);
+    }
+
+    CompressedImage CompressedImage::view(TextureFormat format, uint32_t width, uint32_t height, uint32_t levelCount,
+                                          const uint8_t *data, size_t size) {
+        if (!isValidChain(width, height, levelCount)) {
+            DM_CORE_ERROR("Compressed image view of {0}x{1} can't have {2} levels", width, height, levelCount);
+            return CompressedImage();
+        }
+
+        CompressedImage image(format, width, height);
+        size_t offset = 0;
+        for (uint32_t i = 0; i < levelCount; ++i) {
+            uint32_t levelWidth = std::max(1u, width >> i);
+            uint32_t levelHeight = std::max(1u, height >> i);
+            size_t levelSize = getLevelSize(format, levelWidth, levelHeight);
+            if (offset + levelSize > size) {
+                DM_CORE_ERROR("Compressed image view is truncated at level {0}", i);
+                return CompressedImage();
+            }
+            image.m_levels.push_back({ levelWidth, levelHeight, offset, levelSize });
+            offset += levelSize;
+        }
+
+        image.m_view = data;
+        image.m_viewSize = size;
+        return image;
+    }
+
+    bool CompressedImage::isBlockCompressed(TextureFormat format) {
+        return format != TextureFormat::None && format != TextureFormat::RGB8 && format != TextureFormat::RGBA8;
+    }
+
+    uint32_t CompressedImage::getBlockSize(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::None: return 0;
+            case TextureFormat::RGB8: return 3;
+            case TextureFormat::RGBA8: return 4;
+            case TextureFormat::BC1: return 8;
+            case TextureFormat::BC3: return 16;
+            case TextureFormat::BC7: return 16;
+            case TextureFormat::ETC2RGB: return 8;
+            case TextureFormat::ETC2RGBA: return 16;
+        }
+        DM_CORE_ASSERT(false, "Unknown TextureFormat!");
+        return 0;
+    }
+
+    size_t CompressedImage::getLevelSize(TextureFormat format, uint32_t width, uint32_t height) {
+        if (!isBlockCompressed(format))
+            return (size_t) width * height * getBlockSize(format);
+        return (size_t) ((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+    }
+
+    bool CompressedImage::isContainer(const std::string &path) {
+        size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos)
+            return false;
+        std::string extension = path.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char) std::tolower(c); });
+        return extension == "ktx2" || extension == "dds";
+    }
+
+    CompressedImage CompressedImage::load(const std::string &path) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            DM_CORE_ERROR("Could not open '{0}'", path);
+            return CompressedImage();
+        }
+
+        std::vector<uint8_t> data((size_t) file.tellg());
+        file.seekg(0);
+        file.read((char*) data.data(), (std::streamsize) data.size());
+        return loadFromMemory(data.data(), data.size(), path);
+    }
+
+    CompressedImage CompressedImage::loadFromMemory(const uint8_t *data, size_t size, const std::string &name) {
+        if (size >= sizeof(s_ktx2Identifier) && !memcmp(data, s_ktx2Identifier, sizeof(s_ktx2Identifier)))
+            return parseKTX2(data, size, name);
+        if (size >= 4 && read32(data) == makeFourCC("DDS "))
+            return parseDDS(data, size, name);
+
+        DM_CORE_ERROR("'{0}' is neither KTX2 nor DDS", name);
+        return CompressedImage();
+    }
+
+    // KTXorientation of a 2D texture, "rd" (first row at the top) unless the file says otherwise
+    static bool isKTX2TopDown(const uint8_t *data, size_t size) {
+        uint32_t kvdOffset = read32(data + 56), kvdLength = read32(data + 60);
+        if (kvdOffset > size || kvdLength > size - kvdOffset)
+            return true;
+
+        static const char key[] = "KTXorientation";
+        const uint8_t *entry = data + kvdOffset, *end = entry + kvdLength;
+        while (end - entry >= 4) {
+            uint32_t length = read32(entry);
+            if (length > (size_t) (end - entry) - 4)
+                break;
+            const char *keyValue = (const char*) entry + 4;
+            if (length >= sizeof(key) + 2 && !memcmp(keyValue, key, sizeof(key)))
+                return keyValue[sizeof(key) + 1] != 'u';
+
+            size_t advance = 4 + (((size_t) length + 3) & ~(size_t) 3);
+            if (advance > (size_t) (end - entry))
+                break;
+            entry += advance;
+        }
+        return true;
+    }
+
+    // reverses the first rows rows of 4 packed fields of bits bits each, the rest is padding of a partial block
+    static uint64_t flipBlockRows(uint64_t value, uint32_t bits, uint32_t rows) {
+        uint64_t mask = (1ull << bits) - 1, flipped = value;
+        for (uint32_t row = 0; row < rows; ++row) {
+            flipped &= ~(mask << (row * bits));
+            flipped |= ((value >> ((rows - 1 - row) * bits)) & mask) << (row * bits);
+        }
+        return flipped;
+    }
+
+    // a BC1 color block, or the color half of a BC3 block: the endpoints, then a byte of indices per row
+    static void flipColorBlock(const uint8_t *src, uint8_t *dst, uint32_t rows) {
+        memcpy(dst, src, 8);
+        uint64_t indices = read32(src + 4);
+        uint32_t flipped = (uint32_t) flipBlockRows(indices, 8, rows);
+        memcpy(dst + 4, &flipped, 4);
+    }
+
+    // the alpha half of a BC3 block: two endpoints, then 12 bits of indices per row
+    static void flipAlphaBlock(const uint8_t *src, uint8_t *dst, uint32_t rows) {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        uint64_t indices = 0;
+        memcpy(&indices, src + 2, 6);
+        uint64_t flipped = flipBlockRows(indices, 12, rows);
+        memcpy(dst + 2, &flipped, 6);
+    }
+
+    // turns a level stored top row first into the bottom first layout the textures are uploaded in. Blocks
+    // can only be flipped as a whole, so block-compressed levels need a height that is a multiple of 4 or
+    // fits in one block. BC7 and ETC2 blocks aren't flipped, their index layout varies from block to block
+    static bool flipLevel(TextureFormat format, const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height) {
+        if (!CompressedImage::isBlockCompressed(format)) {
+            size_t rowSize = (size_t) width * CompressedImage::getBlockSize(format);
+            for (uint32_t y = 0; y < height; ++y)
+                memcpy(dst + (size_t) (height - 1 - y) * rowSize, src + (size_t) y * rowSize, rowSize);
+            return true;
+        }
+        if ((format != TextureFormat::BC1 && format != TextureFormat::BC3) || (height > 4 && height % 4))
+            return false;
+
+        uint32_t blockSize = CompressedImage::getBlockSize(format);
+        uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4, rows = std::min(height, 4u);
+        for (uint32_t y = 0; y < blocksY; ++y) {
+            const uint8_t *srcRow = src + (size_t) y * blocksX * blockSize;
+            uint8_t *dstRow = dst + (size_t) (blocksY - 1 - y) * blocksX * blockSize;
+            for (uint32_t x = 0; x < blocksX; ++x) {
+                const uint8_t *srcBlock = srcRow + (size_t) x * blockSize;
+                uint8_t *dstBlock = dstRow + (size_t) x * blockSize;
+                if (format == TextureFormat::BC3) {
+                    flipAlphaBlock(srcBlock, dstBlock, rows);
+                    flipColorBlock(srcBlock + 8, dstBlock + 8, rows);
+                } else {
+                    flipColorBlock(srcBlock, dstBlock, rows);
+                }
+            }
+        }
+        return true;
+    }
+
+    CompressedImage CompressedImage::parseKTX2(const uint8_t *data, size_t size, const std::string &name) {
+        const size_t headerSize = 80; // identifier, header and index
+        if (size < headerSize) {
+            DM_CORE_ERROR("KTX2 '{0}' is truncated", name);
+            return CompressedImage();
+        }
+
+        const uint8_t *header = data + 12;
+        uint32_t vkFormat = read32(header);
+        uint32_t width = read32(header + 8), height = read32(header + 12);
+        uint32_t depth = read32(header + 16), layers = read32(header + 20), faces = read32(header + 24);
+        uint32_t levelCount = std::max(1u, read32(header + 28));
+        uint32_t supercompression = read32(header + 32);
+
+        TextureFormat format = TextureFormat::None;
+        for (const ContainerFormat &entry : s_containerFormats) {
+            if (entry.vkFormat == vkFormat)
+                format = entry.format;
+        }
+        if (format == TextureFormat::None) {
+            DM_CORE_ERROR("KTX2 '{0}': VkFormat {1} is not supported", name, vkFormat);
+            return CompressedImage();
+        }
+        if (supercompression != 0 || depth > 1 || layers > 1 || faces != 1) {
+            DM_CORE_ERROR("KTX2 '{0}': only plain 2D textures are supported (no supercompression, arrays or cube maps)", name);
+            return CompressedImage();
+        }
+        if (!isValidChain(width, height, levelCount)) {
+            DM_CORE_ERROR("KTX2 '{0}': {1}x{2} with {3} levels is invalid", name, width, height, levelCount);
+            return CompressedImage();
+        }
+        if (size < headerSize + (size_t) levelCount * 24) {
+            DM_CORE_ERROR("KTX2 '{0}' is truncated", name);
+            return CompressedImage();
+        }
+
+        bool topDown = isKTX2TopDown(data, size);
+        std::vector<uint8_t> flipped;
+
+        CompressedImage image(format, width, height);
+        const uint8_t *levelIndex = data + headerSize;
+        for (uint32_t i = 0; i < levelCount; ++i) {
+            uint64_t offset = read64(levelIndex + i * 24);
+            uint64_t length = read64(levelIndex + i * 24 + 8);
+            uint32_t levelWidth = std::max(1u, width >> i), levelHeight = std::max(1u, height >> i);
+            if (offset > size || length > size - offset || length != getLevelSize(format, levelWidth, levelHeight)) {
+                DM_CORE_ERROR("KTX2 '{0}': level {1} is corrupted", name, i);
+                return CompressedImage();
+            }
+
+            if (!topDown) {
+                image.addLevel(data + offset, (size_t) length);
+                continue;
+            }
+            flipped.resize((size_t) length);
+            if (!flipLevel(format, data + offset, flipped.data(), levelWidth, levelHeight)) {
+                DM_CORE_ERROR("KTX2 '{0}' is stored top-down and its level {1} can't be flipped, re-encode it bottom "
+                              "first (KTXorientation \"ru\")", name, i);
+                return CompressedImage();
+            }
+            image.addLevel(flipped.data(), flipped.size());
+        }
+        return image;
+    }
+
+    bool CompressedImage::writeKTX2(const std::string &path) const {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        const ContainerFormat *container = findContainerFormat(m_format);
+        if (!isValid() || !container) {
+            DM_CORE_ERROR("Can't write '{0}': the image is empty", path);
+            return false;
+        }
+
+        // data format descriptor, the basic block with one sample per channel
+        struct Sample { uint16_t bitOffset; uint8_t bitLength; uint8_t channel; uint32_t upper; };
+        uint8_t colorModel;
+        std::vector<Sample> samples;
+        switch (m_format) {
+            case TextureFormat::RGB8:     colorModel = 1;   samples = { { 0, 8, 0, 255 }, { 8, 8, 1, 255 }, { 16, 8, 2, 255 } }; break;
+            case TextureFormat::RGBA8:    colorModel = 1;   samples = { { 0, 8, 0, 255 }, { 8, 8, 1, 255 }, { 16, 8, 2, 255 }, { 24, 8, 15, 255 } }; break;
+            case TextureFormat::BC1:      colorModel = 128; samples = { { 0, 64, 0, UINT32_MAX } }; break;
+            case TextureFormat::BC3:      colorModel = 130; samples = { { 0, 64, 15, UINT32_MAX }, { 64, 64, 0, UINT32_MAX } }; break;
+            case TextureFormat::BC7:      colorModel = 134; samples = { { 0, 128, 0, UINT32_MAX } }; break;
+            case TextureFormat::ETC2RGB:  colorModel = 161; samples = { { 0, 64, 2, UINT32_MAX } }; break;
+            case TextureFormat::ETC2RGBA: colorModel = 161; samples = { { 0, 64, 15, UINT32_MAX }, { 64, 64, 2, UINT32_MAX } }; break;
+            default: return false;
+        }
+
+        bool blocks = isBlockCompressed(m_format);
+        uint32_t blockSize = getBlockSize(m_format);
+        uint32_t levelAlignment = blockSize % 4 == 0 ? blockSize : blockSize * 4; // lcm(block size, 4)
+
+        std::vector<uint8_t> dfd;
+        uint32_t descriptorSize = 24 + 16 * (uint32_t) samples.size();
+        write32(dfd, 4 + descriptorSize);
+        write32(dfd, 0); // Khronos vendor, basic descriptor
+        write32(dfd, 2u | (descriptorSize << 16)); // version 2
+        write8(dfd, colorModel);
+        write8(dfd, 1); // BT.709 primaries
+        write8(dfd, 1); // linear transfer
+        write8(dfd, 0); // straight alpha
+        for (uint32_t i = 0; i < 4; ++i)
+            write8(dfd, (blocks && i < 2) ? 3 : 0); // block dimensions - 1
+        write8(dfd, (uint8_t) blockSize);
+        for (uint32_t i = 1; i < 8; ++i)
+            write8(dfd, 0);
+        for (const Sample &sample : samples) {
+            write16(dfd, sample.bitOffset);
+            write8(dfd, (uint8_t) (sample.bitLength - 1));
+            write8(dfd, sample.channel);
+            write32(dfd, 0); // sample position
+            write32(dfd, 0); // lower
+            write32(dfd, sample.upper);
+        }
+
+        // rows are stored bottom first
+        std::vector<uint8_t> kvd;
+        const char orientation[] = "KTXorientation\0ru";
+        write32(kvd, (uint32_t) sizeof(orientation));
+        kvd.insert(kvd.end(), orientation, orientation + sizeof(orientation));
+        pad(kvd, 4);
+
+        uint32_t levelCount = getLevelCount();
+        std::vector<uint8_t> out(s_ktx2Identifier, s_ktx2Identifier + sizeof(s_ktx2Identifier));
+        write32(out, container->vkFormat);
+        write32(out, 1); // type size
+        write32(out, m_width);
+        write32(out, m_height);
+        write32(out, 0); // depth
+        write32(out, 0); // layers
+        write32(out, 1); // faces
+        write32(out, levelCount);
+        write32(out, 0); // no supercompression
+
+        uint32_t dfdOffset = 80 + levelCount * 24;
+        uint32_t kvdOffset = dfdOffset + (uint32_t) dfd.size();
+        write32(out, dfdOffset);
+        write32(out, (uint32_t) dfd.size());
+        write32(out, kvdOffset);
+        write32(out, (uint32_t) kvd.size());
+        write64(out, 0); // no supercompression global data
+        write64(out, 0);
+
+        // levels are stored smallest first, the index is filled once the offsets are known
+        size_t levelIndex = out.size();
+        out.resize(out.size() + (size_t) levelCount * 24);
+        out.insert(out.end(), dfd.begin(), dfd.end());
+        out.insert(out.end(), kvd.begin(), kvd.end());
+        for (uint32_t i = levelCount; i-- > 0;) {
+            pad(out, levelAlignment);
+            uint64_t offset = out.size(), length = m_levels[i].size;
+            out.insert(out.end(), getLevelData(i), getLevelData(i) + m_levels[i].size);
+
+            memcpy(out.data() + levelIndex + i * 24, &offset, 8);
+            memcpy(out.data() + levelIndex + i * 24 + 8, &length, 8);
+            memcpy(out.data() + levelIndex + i * 24 + 16, &length, 8);
+        }
+
+        return writeFile(path, out);
+    }
+
+    // DDS_HEADER field offsets (after the magic number)
+    enum DDSHeader : uint32_t {
+        DDSSize = 0, DDSFlags = 4, DDSHeight = 8, DDSWidth = 12, DDSPitchOrLinearSize = 16, DDSMipCount = 24,
+        DDSPixelFormatFlags = 76, DDSFourCC = 80, DDSBitCount = 84, DDSRedMask = 88, DDSGreenMask = 92,
+        DDSBlueMask = 96, DDSAlphaMask = 100, DDSCaps = 104, DDSHeaderSize = 124
+    };
+
+    static const uint32_t s_ddsFlagMipCount = 0x20000;
+    static const uint32_t s_ddsPixelFourCC = 0x4;
+    static const uint32_t s_ddsPixelRGB = 0x40;
+    static const uint32_t s_ddsPixelAlpha = 0x1;
+
+    CompressedImage CompressedImage::parseDDS(const uint8_t *data, size_t size, const std::string &name) {
+        if (size < 4 + DDSHeaderSize) {
+            DM_CORE_ERROR("DDS '{0}' is truncated", name);
+            return CompressedImage();
+        }
+
+        const uint8_t *header = data + 4;
+        uint32_t width = read32(header + DDSWidth), height = read32(header + DDSHeight);
+        uint32_t levelCount = (read32(header + DDSFlags) & s_ddsFlagMipCount) ? std::max(1u, read32(header + DDSMipCount)) : 1;
+        uint32_t pixelFlags = read32(header + DDSPixelFormatFlags);
+        uint32_t fourCC = read32(header + DDSFourCC);
+        size_t offset = 4 + DDSHeaderSize;
+
+        TextureFormat format = TextureFormat::None;
+        if ((pixelFlags & s_ddsPixelFourCC) && fourCC == makeFourCC("DX10")) {
+            if (size < offset + 20) {
+                DM_CORE_ERROR("DDS '{0}' is truncated", name);
+                return CompressedImage();
+            }
+            uint32_t dxgiFormat = read32(data + offset);
+            uint32_t arraySize = read32(data + offset + 12);
+            offset += 20;
+            for (const ContainerFormat &entry : s_containerFormats) {
+                if (entry.dxgiFormat && entry.dxgiFormat == dxgiFormat)
+                    format = entry.format;
+            }
+            if (arraySize > 1) {
+                DM_CORE_ERROR("DDS '{0}': texture arrays are not supported", name);
+                return CompressedImage();
+            }
+        } else if (pixelFlags & s_ddsPixelFourCC) {
+            for (const ContainerFormat &entry : s_containerFormats) {
+                if (entry.fourCC && entry.fourCC == fourCC)
+                    format = entry.format;
+            }
+        } else if (pixelFlags & s_ddsPixelRGB) {
+            uint32_t bitCount = read32(header + DDSBitCount);
+            bool rgbOrder = read32(header + DDSRedMask) == 0xFF && read32(header + DDSGreenMask) == 0xFF00
+                            && read32(header + DDSBlueMask) == 0xFF0000;
+            if (rgbOrder && bitCount == 32 && (pixelFlags & s_ddsPixelAlpha) && read32(header + DDSAlphaMask) == 0xFF000000)
+                format = TextureFormat::RGBA8;
+            else if (rgbOrder && bitCount == 24)
+                format = TextureFormat::RGB8;
+        }
+
+        if (format == TextureFormat::None) {
+            DM_CORE_ERROR("DDS '{0}': the pixel format is not supported", name);
+            return CompressedImage();
+        }
+
+        if (!isValidChain(width, height, levelCount)) {
+            DM_CORE_ERROR("DDS '{0}': {1}x{2} with {3} levels is invalid", name, width, height, levelCount);
+            return CompressedImage();
+        }
+
+        CompressedImage image(format, width, height);
+        for (uint32_t i = 0; i < levelCount; ++i) {
+            size_t length = getLevelSize(format, std::max(1u, width >> i), std::max(1u, height >> i));
+            if (offset + length > size) {
+                DM_CORE_ERROR("DDS '{0}': level {1} is truncated", name, i);
+                return CompressedImage();
+            }
+            image.addLevel(data + offset, length);
+            offset += length;
+        }
+        return image;
+    }
+
+    bool CompressedImage::writeDDS(const std::string &path) const {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        const ContainerFormat *container = findContainerFormat(m_format);
+        if (!isValid() || !container) {
+            DM_CORE_ERROR("Can't write '{0}': the image is empty", path);
+            return false;
+        }
+        bool blocks = isBlockCompressed(m_format);
+        if (blocks && !container->fourCC && !container->dxgiFormat) {
+            DM_CORE_ERROR("Can't write '{0}': DDS can't store the format, use KTX2", path);
+            return false;
+        }
+
+        std::vector<uint8_t> header(DDSHeaderSize, 0);
+        auto set = [&header](uint32_t offset, uint32_t value) { memcpy(header.data() + offset, &value, 4); };
+
+        set(DDSSize, DDSHeaderSize);
+        // caps, height, width, pixel format, mip count and pitch / linear size
+        set(DDSFlags, 0x1 | 0x2 | 0x4 | 0x1000 | s_ddsFlagMipCount | (blocks ? 0x80000 : 0x8));
+        set(DDSHeight, m_height);
+        set(DDSWidth, m_width);
+        set(DDSPitchOrLinearSize, blocks ? (uint32_t) m_levels[0].size : m_width * getBlockSize(m_format));
+        set(DDSMipCount, getLevelCount());
+        set(72, 32); // pixel format size
+        set(DDSCaps, 0x1000 | (getLevelCount() > 1 ? 0x400000 | 0x8 : 0)); // texture, mipmap, complex
+
+        bool dx10 = blocks && !container->fourCC;
+        if (blocks) {
+            set(DDSPixelFormatFlags, s_ddsPixelFourCC);
+            set(DDSFourCC, dx10 ? makeFourCC("DX10") : container->fourCC);
+        } else {
+            bool alpha = m_format == TextureFormat::RGBA8;
+            set(DDSPixelFormatFlags, s_ddsPixelRGB | (alpha ? s_ddsPixelAlpha : 0));
+            set(DDSBitCount, alpha ? 32 : 24);
+            set(DDSRedMask, 0xFF);
+            set(DDSGreenMask, 0xFF00);
+            set(DDSBlueMask, 0xFF0000);
+            set(DDSAlphaMask, alpha ? 0xFF000000 : 0);
+        }
+
+        std::vector<uint8_t> out;
+        write32(out, makeFourCC("DDS "));
+        out.insert(out.end(), header.begin(), header.end());
+        if (dx10) {
+            write32(out, container->dxgiFormat);
+            write32(out, 3); // 2D texture
+            write32(out, 0);
+            write32(out, 1); // array size
+            write32(out, 0);
+        }
+        out.insert(out.end(), getData(), getData() + getSize());
+
+        return writeFile(path, out);
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef ENGINE_COMPRESSEDIMAGE_H
+#define ENGINE_COMPRESSEDIMAGE_H
+
+#include "Deimos/Core/Core.h"
+#include "Texture.h"
+
+namespace Deimos {
+    // Texture levels in a GPU format as stored in a KTX2 or DDS container, level 0 first. The data is uploaded
+    // as is, so the first row (of blocks) must be the bottom of the picture, which is how DeimosTextureEncoder
+    // writes them. KTX2 files say so with the "ru" orientation, top-down ones ("rd", the default) are flipped on
+    // load where the format allows it (RGB8, RGBA8, BC1, BC3) and rejected otherwise. DDS has no such tag, DDS
+    // files are always taken as bottom first, so ones from other tools load upside down
+    class CompressedImage {
+    public:
+        struct Level {
+            uint32_t width, height;
+            size_t offset, size; // in the data of the image
+        };
+
+        CompressedImage() = default;
+        CompressedImage(TextureFormat format, uint32_t width, uint32_t height);
+
+        CompressedImage(CompressedImage&&) noexcept = default;
+        CompressedImage& operator=(CompressedImage&&) noexcept = default;
+        CompressedImage(const CompressedImage&) = delete;
+        CompressedImage& operator=(const CompressedImage&) = delete;
+
+        // appends the next smaller level, size must match getLevelSize of its dimensions
+        void addLevel(const void* data, size_t size);
+
+        inline TextureFormat getFormat() const { return m_format; }
+        inline uint32_t getWidth() const { return m_width; }
+        inline uint32_t getHeight() const { return m_height; }
+        inline uint32_t getLevelCount() const { return (uint32_t) m_levels.size(); }
+        inline const Level& getLevel(uint32_t index) const { return m_levels[index]; }
+        inline const uint8_t* getLevelData(uint32_t index) const { return getData() + m_levels[index].offset; }
+        inline const uint8_t* getData() const { return m_view ? m_view : m_data.data(); }
+        inline size_t getSize() const { return m_view ? m_viewSize : m_data.size(); }
+
+        inline bool isValid() const { return m_format != TextureFormat::None && !m_levels.empty(); }
+
+        static bool isBlockCompressed(TextureFormat format);
+        // bytes per 4x4 block for compressed formats, per pixel otherwise
+        static uint32_t getBlockSize(TextureFormat format);
+        static size_t getLevelSize(TextureFormat format, uint32_t width, uint32_t height);
+
+        // by the extension, .ktx2 and .dds
+        static bool isContainer(const std::string& path);
+
+        // KTX2 or DDS, detected by the magic number
+        static CompressedImage load(const std::string& path);
+        static CompressedImage loadFromMemory(const uint8_t* data, size_t size, const std::string& name = "<memory>");
+        // levels stored one after another in memory owned elsewhere (a mapped asset pack), nothing is copied.
+        // The data has to outlive the image, addLevel can't be used on it
+        static CompressedImage view(TextureFormat format, uint32_t width, uint32_t height, uint32_t levelCount,
+                                    const uint8_t* data, size_t size);
+
+        bool writeKTX2(const std::string& path) const;
+        // DDS has no ETC2, those are KTX2 only
+        bool writeDDS(const std::string& path) const;
+    private:
+        static CompressedImage parseKTX2(const uint8_t* data, size_t size, const std::string& name);
+        static CompressedImage parseDDS(const uint8_t* data, size_t size, const std::string& name);
+    private:
+        TextureFormat m_format = TextureFormat::None;
+        uint32_t m_width = 0, m_height = 0;
+        std::vector<Level> m_levels;
+        std::vector<uint8_t> m_data;
+        const uint8_t* m_view = nullptr;
+        size_t m_viewSize = 0;
+    };
+}
+
+
+#endif //ENGINE_COMPRESSEDIMAGE_H
@@ -0,0 +1,16 @@
+#include "dmpch.h"
+#include "Framebuffer.h"
+
+#include "Renderer.h"
+#include "Platform/OpenGL/OpenGLFramebuffer.h"
+
+namespace Deimos {
+    Ref<Framebuffer> Framebuffer::create(const FramebufferSpecification &spec) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None: DM_ASSERT(false, "Deimos currently does not support RendererAPI::None!");
+            case RendererAPI::API::OpenGL: return createRef<OpenGLFramebuffer>(spec);
+        }
+        DM_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef ENGINE_FRAMEBUFFER_H
+#define ENGINE_FRAMEBUFFER_H
+
+#include "Deimos/Core/Core.h"
+
+namespace Deimos {
+
+    enum class FramebufferTextureFormat {
+        None = 0, RGBA8, RGBA16F, Depth24Stencil8
+    };
+
+    struct FramebufferSpecification {
+        uint32_t width = 0, height = 0;
+        uint32_t samples = 1; // > 1 creates multisampled attachments, resolve them with blitTo
+        FramebufferTextureFormat colorFormat = FramebufferTextureFormat::RGBA8;
+        FramebufferTextureFormat depthFormat = FramebufferTextureFormat::Depth24Stencil8; // None - no depth attachment
+    };
+
+    class Framebuffer {
+    public:
+        virtual ~Framebuffer() = default;
+
+        // bind also sets the viewport to the size of the framebuffer, unbind restores the one bind replaced
+        virtual void bind() = 0;
+        virtual void unbind() = 0;
+
+        virtual void resize(uint32_t width, uint32_t height) = 0;
+
+        // copies the color attachment into target, nullptr - into the back buffer of the current context
+        virtual void blitTo(const Ref<Framebuffer>& target) const = 0;
+        // reads RGBA8 pixels of the color attachment, data must hold width * height * 4 bytes
+        virtual void readPixels(uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* data) const = 0;
+
+        virtual uint32_t getColorAttachmentRendererID() const = 0;
+        virtual uint32_t getDepthAttachmentRendererID() const = 0;
+        virtual uint32_t getRendererID() const = 0;
+
+        virtual const FramebufferSpecification& getSpecification() const = 0;
+
+        static Ref<Framebuffer> create(const FramebufferSpecification& spec);
+    };
+}
+
+
+#endif //ENGINE_FRAMEBUFFER_H
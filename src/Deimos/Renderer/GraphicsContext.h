@@ -1,12 +1,24 @@
 #ifndef GRAPHICSCONTEXT_H
 #define GRAPHICSCONTEXT_H
 
+#include "Deimos/Core/Core.h"
+
 namespace Deimos {
 
     class GraphicsContext {
     public:
+        virtual ~GraphicsContext() = default;
+
         virtual void init() = 0;
         virtual void swapBuffers() = 0;
+
+        // binds/unbinds the context to the calling thread
+        virtual void makeCurrent() = 0;
+        virtual void releaseCurrent() = 0;
+
+        // context without a visible surface that shares objects (textures, buffers, syncs) with this one,
+        // must be created on the main thread, but can be made current on any thread
+        virtual Scope<GraphicsContext> createSharedContext() = 0;
     };
 }
 
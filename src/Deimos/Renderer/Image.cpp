@@ -0,0 +1,436 @@
+#include "dmpch.h"
+#include "Image.h"
+
+#include "PixelKernels.h"
+#include "Deimos/Core/JobSystem.h"
+#include "stb_image/stb_image.h"
+
+#include <fstream>
+
+namespace Deimos {
+    static const uint8_t s_qoiMagic[4] = { 'q', 'o', 'i', 'f' };
+    static const uint8_t s_rawMagic[4] = { 'D', 'M', 'R', 'I' };
+
+    // header of the raw container, the pixels follow it tightly packed
+    struct RawImageHeader {
+        uint8_t magic[4];
+        uint32_t version;
+        uint32_t width, height, channels;
+        uint32_t flags;
+        uint32_t reserved[2];
+    };
+    static_assert(sizeof(RawImageHeader) == 32, "RawImageHeader must stay 32 bytes");
+
+    // the QOI spec's cap, raw images get the same one so the sizes computed from a header can't wrap
+    static const uint64_t s_maxPixels = 400000000ull;
+
+    static const uint32_t s_rawVersion = 1;
+    static const uint32_t s_rawBottomUp = 1 << 0; // the first row is the bottom of the picture
+
+    // QOI stores big endian
+    static inline uint32_t readBigEndian32(const uint8_t* data) {
+        return ((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 8) | data[3];
+    }
+    static inline void writeBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back((uint8_t) (value >> 24));
+        out.push_back((uint8_t) (value >> 16));
+        out.push_back((uint8_t) (value >> 8));
+        out.push_back((uint8_t) value);
+    }
+
+    static inline uint32_t qoiHash(const uint8_t* px) {
+        return (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+    }
+
+    static bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            DM_CORE_ERROR("Could not open '{0}' for writing", path);
+            return false;
+        }
+        file.write((const char*) data.data(), (std::streamsize) data.size());
+        return (bool) file;
+    }
+
+    Image::Image(uint32_t width, uint32_t height, uint32_t channels)
+        : m_width(width), m_height(height), m_channels(channels) {
+        m_data = (uint8_t*) malloc(getSize());
+    }
+
+    Image::~Image() {
+        free(m_data);
+    }
+
+    Image::Image(Image &&other) noexcept
+        : m_width(other.m_width), m_height(other.m_height), m_channels(other.m_channels), m_data(other.m_data) {
+        other.m_data = nullptr;
+        other.m_width = other.m_height = other.m_channels = 0;
+    }
+
+    Image &Image::operator=(Image &&other) noexcept {
+        if (this != &other) {
+            free(m_data);
+            m_width = other.m_width;
+            m_height = other.m_height;
+            m_channels = other.m_channels;
+            m_data = other.m_data;
+            other.m_data = nullptr;
+            other.m_width = other.m_height = other.m_channels = 0;
+        }
+        return *this;
+    }
+
+    Image Image::load(const std::string &path, bool flipVertically) {
+        ImageLoadOptions options;
+        options.flipVertically = flipVertically;
+        return load(path, options);
+    }
+
+    Image Image::load(const std::string &path, const ImageLoadOptions &options) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        // read whole, the format is picked by the magic number and not by the extension
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            DM_CORE_ERROR("Could not open '{0}'", path);
+            return Image();
+        }
+
+        std::vector<uint8_t> data((size_t) file.tellg());
+        file.seekg(0);
+        file.read((char*) data.data(), (std::streamsize) data.size());
+        return loadFromMemory(data.data(), data.size(), options, path);
+    }
+
+    Image Image::loadFromMemory(const uint8_t *data, size_t size, bool flipVertically, const std::string &name) {
+        ImageLoadOptions options;
+        options.flipVertically = flipVertically;
+        return loadFromMemory(data, size, options, name);
+    }
+
+    Image Image::loadFromMemory(const uint8_t *data, size_t size, const ImageLoadOptions &options, const std::string &name) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        Image image;
+        bool bottomUp = false; // the order of the decoded rows
+        if (size >= 4 && !memcmp(data, s_qoiMagic, 4)) {
+            image = decodeQOI(data, size, options.expandToRGBA, name);
+        } else if (size >= 4 && !memcmp(data, s_rawMagic, 4)) {
+            image = parseRaw(data, size, bottomUp, name);
+        } else {
+            int width, height, channels;
+            stbi_uc *pixels = stbi_load_from_memory(data, (int) size, &width, &height, &channels, 0);
+            if (!pixels) {
+                DM_CORE_ERROR("Failed to load image '{0}': {1}", name, stbi_failure_reason());
+                return image;
+            }
+
+            image.m_width = width;
+            image.m_height = height;
+            image.m_channels = channels;
+            image.m_data = pixels;
+        }
+
+        if (image.isValid()) {
+            ImageLoadOptions remaining = options;
+            remaining.flipVertically = options.flipVertically != bottomUp;
+            image.applyOptions(remaining);
+        }
+        return image;
+    }
+
+    std::vector<Image> Image::loadBatch(const std::vector<std::string> &paths, const ImageLoadOptions &options) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        std::vector<Image> images(paths.size());
+        JobSystem::parallelFor((uint32_t) paths.size(), [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+                images[i] = load(paths[i], options);
+        });
+        return images;
+    }
+
+    void Image::applyOptions(const ImageLoadOptions &options) {
+        // flipping first moves fewer bytes
+        if (options.flipVertically)
+            flipVertically();
+        if (options.expandToRGBA)
+            expandToRGBA();
+        if (options.premultiplyAlpha)
+            premultiplyAlpha();
+    }
+
+    void Image::flipVertically() {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        PixelKernels::flipVertically(m_data, (size_t) m_width * m_channels, m_height);
+    }
+
+    void Image::expandToRGBA() {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        if (m_channels == 4 || !m_data)
+            return;
+
+        Image rgba(m_width, m_height, 4);
+        size_t pixelCount = (size_t) m_width * m_height;
+        if (m_channels == 3) {
+            PixelKernels::expandRGBToRGBA(m_data, rgba.m_data, pixelCount);
+        } else {
+            // grey and grey + alpha, rare enough to stay scalar
+            for (size_t i = 0; i < pixelCount; ++i) {
+                const uint8_t *src = m_data + i * m_channels;
+                uint8_t *dst = rgba.m_data + i * 4;
+                dst[0] = dst[1] = dst[2] = src[0];
+                dst[3] = m_channels == 2 ? src[1] : 255;
+            }
+        }
+        *this = std::move(rgba);
+    }
+
+    void Image::premultiplyAlpha() {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        if (m_channels == 4)
+            PixelKernels::premultiplyAlpha(m_data, (size_t) m_width * m_height);
+    }
+
+    bool Image::writeTGA(const std::string &path) const {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        if (!isValid() || m_width > 0xFFFF || m_height > 0xFFFF) {
+            DM_CORE_ERROR("Image '{0}' can't be stored as TGA ({1}x{2})", path, m_width, m_height);
+            return false;
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            DM_CORE_ERROR("Could not open '{0}' for writing", path);
+            return false;
+        }
+
+        bool grey = m_channels < 3;
+        uint8_t header[18] = {};
+        header[2] = grey ? 3 : 2; // uncompressed grey / true color
+        header[12] = m_width & 0xFF;
+        header[13] = (m_width >> 8) & 0xFF;
+        header[14] = m_height & 0xFF;
+        header[15] = (m_height >> 8) & 0xFF;
+        header[16] = (uint8_t) (m_channels * 8);
+        header[17] = (m_channels == 2 || m_channels == 4) ? 8 : 0; // alpha bits, bottom left origin
+        file.write((const char*) header, sizeof(header));
+
+        // TGA stores BGR(A)
+        std::vector<uint8_t> row((size_t) m_width * m_channels);
+        for (uint32_t y = 0; y < m_height; ++y) {
+            const uint8_t *src = m_data + (size_t) y * m_width * m_channels;
+            memcpy(row.data(), src, row.size());
+            if (!grey) {
+                for (size_t x = 0; x < row.size(); x += m_channels) {
+                    std::swap(row[x], row[x + 2]);
+                }
+            }
+            file.write((const char*) row.data(), (std::streamsize) row.size());
+        }
+
+        return (bool) file;
+    }
+
+    Image Image::decodeQOI(const uint8_t *data, size_t size, bool toRGBA, const std::string &name) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        const size_t headerSize = 14, endMarkerSize = 8;
+        if (size < headerSize + endMarkerSize) {
+            DM_CORE_ERROR("QOI '{0}' is truncated", name);
+            return Image();
+        }
+
+        uint32_t width = readBigEndian32(data + 4);
+        uint32_t height = readBigEndian32(data + 8);
+        uint32_t fileChannels = data[12];
+        if (!width || !height || (uint64_t) width * height > s_maxPixels || (fileChannels != 3 && fileChannels != 4)) {
+            DM_CORE_ERROR("QOI '{0}' has an invalid header ({1}x{2}, {3} channels)", name, width, height, fileChannels);
+            return Image();
+        }
+
+        const uint32_t channels = toRGBA ? 4 : fileChannels;
+        Image image(width, height, channels);
+        uint8_t *dst = image.m_data;
+        uint8_t *end = dst + image.getSize();
+
+        uint8_t index[64][4] = {};
+        uint8_t px[4] = { 0, 0, 0, 255 };
+        // every op is at most 5 bytes and the end marker is 8, so reads before it never leave the data
+        const uint8_t *src = data + headerSize;
+        const uint8_t *chunksEnd = data + size - endMarkerSize;
+        while (dst < end) {
+            if (src >= chunksEnd) {
+                DM_CORE_ERROR("QOI '{0}' is truncated", name);
+                return Image();
+            }
+
+            uint8_t op = *src++;
+            uint32_t run = 1;
+            if (op == 0xFE) { // RGB
+                px[0] = src[0]; px[1] = src[1]; px[2] = src[2];
+                src += 3;
+            } else if (op == 0xFF) { // RGBA
+                memcpy(px, src, 4);
+                src += 4;
+            } else if ((op & 0xC0) == 0x00) { // INDEX
+                memcpy(px, index[op], 4);
+            } else if ((op & 0xC0) == 0x40) { // DIFF
+                px[0] += ((op >> 4) & 0x03) - 2;
+                px[1] += ((op >> 2) & 0x03) - 2;
+                px[2] += (op & 0x03) - 2;
+            } else if ((op & 0xC0) == 0x80) { // LUMA
+                uint8_t second = *src++;
+                int dg = (op & 0x3F) - 32;
+                px[0] += dg - 8 + ((second >> 4) & 0x0F);
+                px[1] += dg;
+                px[2] += dg - 8 + (second & 0x0F);
+            } else { // RUN
+                run = (op & 0x3F) + 1;
+            }
+            memcpy(index[qoiHash(px)], px, 4);
+
+            run = std::min<uint32_t>(run, (uint32_t) ((end - dst) / channels));
+            for (uint32_t i = 0; i < run; ++i, dst += channels)
+                memcpy(dst, px, channels);
+        }
+
+        return image;
+    }
+
+    Image Image::parseRaw(const uint8_t *data, size_t size, bool &bottomUp, const std::string &name) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        RawImageHeader header;
+        if (size < sizeof(header)) {
+            DM_CORE_ERROR("Raw image '{0}' is truncated", name);
+            return Image();
+        }
+        memcpy(&header, data, sizeof(header));
+        if (header.version != s_rawVersion || header.channels < 1 || header.channels > 4) {
+            DM_CORE_ERROR("Raw image '{0}' has an unsupported header (version {1}, {2} channels)", name, header.version, header.channels);
+            return Image();
+        }
+
+        if (!header.width || !header.height || (uint64_t) header.width * header.height > s_maxPixels) {
+            DM_CORE_ERROR("Raw image '{0}' has invalid dimensions {1}x{2}", name, header.width, header.height);
+            return Image();
+        }
+
+        size_t pixelSize = (size_t) header.width * header.height * header.channels;
+        if (!pixelSize || size - sizeof(header) < pixelSize) {
+            DM_CORE_ERROR("Raw image '{0}' is truncated", name);
+            return Image();
+        }
+
+        Image image(header.width, header.height, header.channels);
+        memcpy(image.m_data, data + sizeof(header), pixelSize);
+        bottomUp = (header.flags & s_rawBottomUp) != 0;
+        return image;
+    }
+
+    bool Image::writeQOI(const std::string &path) const {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        if (!isValid()) {
+            DM_CORE_ERROR("Image '{0}' can't be stored as QOI, it is empty", path);
+            return false;
+        }
+
+        // grey is widened, grey + alpha keeps its alpha
+        const uint32_t fileChannels = (m_channels == 2 || m_channels == 4) ? 4 : 3;
+        std::vector<uint8_t> out;
+        out.reserve(14 + (size_t) m_width * m_height * (fileChannels + 1) + 8);
+        out.insert(out.end(), s_qoiMagic, s_qoiMagic + 4);
+        writeBigEndian32(out, m_width);
+        writeBigEndian32(out, m_height);
+        out.push_back((uint8_t) fileChannels);
+        out.push_back(0); // sRGB with linear alpha
+
+        uint8_t index[64][4] = {};
+        uint8_t prev[4] = { 0, 0, 0, 255 };
+        uint32_t run = 0;
+        const size_t pixelCount = (size_t) m_width * m_height;
+        for (size_t i = 0; i < pixelCount; ++i) {
+            // QOI is top to bottom, the last row here
+            size_t row = m_height - 1 - i / m_width, column = i % m_width;
+            const uint8_t *src = m_data + (row * m_width + column) * m_channels;
+            uint8_t px[4];
+            if (m_channels >= 3) {
+                px[0] = src[0]; px[1] = src[1]; px[2] = src[2];
+                px[3] = m_channels == 4 ? src[3] : 255;
+            } else {
+                px[0] = px[1] = px[2] = src[0];
+                px[3] = m_channels == 2 ? src[1] : 255;
+            }
+
+            if (!memcmp(px, prev, 4)) {
+                if (++run == 62 || i + 1 == pixelCount) {
+                    out.push_back((uint8_t) (0xC0 | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run) {
+                out.push_back((uint8_t) (0xC0 | (run - 1)));
+                run = 0;
+            }
+
+            uint32_t hash = qoiHash(px);
+            if (!memcmp(index[hash], px, 4)) {
+                out.push_back((uint8_t) hash);
+            } else {
+                memcpy(index[hash], px, 4);
+                if (px[3] == prev[3]) {
+                    int8_t dr = (int8_t) (px[0] - prev[0]);
+                    int8_t dg = (int8_t) (px[1] - prev[1]);
+                    int8_t db = (int8_t) (px[2] - prev[2]);
+                    int drg = dr - dg, dbg = db - dg;
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                        out.push_back((uint8_t) (0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2)));
+                    } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                        out.push_back((uint8_t) (0x80 | (dg + 32)));
+                        out.push_back((uint8_t) (((drg + 8) << 4) | (dbg + 8)));
+                    } else {
+                        out.push_back(0xFE);
+                        out.insert(out.end(), px, px + 3);
+                    }
+                } else {
+                    out.push_back(0xFF);
+                    out.insert(out.end(), px, px + 4);
+                }
+            }
+            memcpy(prev, px, 4);
+        }
+
+        static const uint8_t endMarker[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+        out.insert(out.end(), endMarker, endMarker + 8);
+        return writeFile(path, out);
+    }
+
+    bool Image::writeRaw(const std::string &path) const {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        if (!isValid()) {
+            DM_CORE_ERROR("Image '{0}' can't be stored raw, it is empty", path);
+            return false;
+        }
+
+        RawImageHeader header = {};
+        memcpy(header.magic, s_rawMagic, 4);
+        header.version = s_rawVersion;
+        header.width = m_width;
+        header.height = m_height;
+        header.channels = m_channels;
+        header.flags = s_rawBottomUp;
+
+        std::vector<uint8_t> out(sizeof(header) + getSize());
+        memcpy(out.data(), &header, sizeof(header));
+        memcpy(out.data() + sizeof(header), m_data, getSize());
+        return writeFile(path, out);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef ENGINE_IMAGE_H
+#define ENGINE_IMAGE_H
+
+#include "Deimos/Core/Core.h"
+
+namespace Deimos {
+    struct ImageLoadOptions {
+        bool flipVertically = true; // the first row is the bottom of the picture (GL convention)
+        bool expandToRGBA = false; // 1 to 3 channel images get 4 channels, GPUs have no 3 byte texel format
+        bool premultiplyAlpha = false;
+    };
+
+    // Decoded 8 bit per channel pixels in CPU memory, rows are tightly packed
+    class Image {
+    public:
+        Image() = default;
+        Image(uint32_t width, uint32_t height, uint32_t channels);
+        ~Image();
+
+        Image(Image&& other) noexcept;
+        Image& operator=(Image&& other) noexcept;
+        Image(const Image&) = delete;
+        Image& operator=(const Image&) = delete;
+
+        inline uint32_t getWidth() const { return m_width; }
+        inline uint32_t getHeight() const { return m_height; }
+        inline uint32_t getChannels() const { return m_channels; }
+        inline size_t getSize() const { return (size_t) m_width * m_height * m_channels; }
+
+        inline uint8_t* getData() { return m_data; }
+        inline const uint8_t* getData() const { return m_data; }
+
+        inline bool isValid() const { return m_data != nullptr; }
+
+        // thread safe, the first row of the result is the bottom of the picture when flipVertically is set (GL convention).
+        // QOI and raw (.dmraw) files are recognised by their magic number and skip stb_image, everything else goes through it
+        static Image load(const std::string& path, bool flipVertically = true);
+        static Image load(const std::string& path, const ImageLoadOptions& options);
+        // encoded file contents (PNG, JPEG, QOI, raw ...), name is only used in messages
+        static Image loadFromMemory(const uint8_t* data, size_t size, bool flipVertically = true,
+                                    const std::string& name = "<memory>");
+        static Image loadFromMemory(const uint8_t* data, size_t size, const ImageLoadOptions& options,
+                                    const std::string& name = "<memory>");
+        // decodes the files on the job system (and the calling thread), in the order of paths. Failed ones are
+        // invalid images
+        static std::vector<Image> loadBatch(const std::vector<std::string>& paths, const ImageLoadOptions& options);
+
+        // the conversions of ImageLoadOptions on an image in memory
+        void flipVertically();
+        void expandToRGBA();
+        void premultiplyAlpha();
+
+        // uncompressed TGA, the first row is written as the bottom of the picture
+        bool writeTGA(const std::string& path) const;
+        // QOI, lossless and several times faster to decode than PNG. Grey images are widened to RGB(A)
+        bool writeQOI(const std::string& path) const;
+        // the pixels as they are behind a 32 byte header, loading them with flipVertically set is a plain copy
+        bool writeRaw(const std::string& path) const;
+    private:
+        void applyOptions(const ImageLoadOptions& options);
+
+        // toRGBA decodes 3 channel files straight into 4 channels
+        static Image decodeQOI(const uint8_t* data, size_t size, bool toRGBA, const std::string& name);
+        // bottomUp is set to the row order stored in the file
+        static Image parseRaw(const uint8_t* data, size_t size, bool& bottomUp, const std::string& name);
+    private:
+        uint32_t m_width = 0, m_height = 0, m_channels = 0;
+        uint8_t* m_data = nullptr; // malloc'd, stb_image allocates the same way
+    };
+}
+
+
+#endif //ENGINE_IMAGE_H
@@ -0,0 +1,116 @@
+#include "dmpch.h"
+#include "MipmapGenerator.h"
+
+#include "Deimos/Core/JobSystem.h"
+
+#include <emmintrin.h>
+
+namespace Deimos {
+    // levels smaller than this are not worth splitting over threads
+    static const uint32_t s_minParallelRows = 128;
+    static const uint32_t s_rowsPerTask = 32;
+
+    // 4 destination RGBA pixels from 8x2 source pixels: widen to 16 bits, add the 2x2 block, round and narrow
+    static inline __m128i boxFilter4(const uint8_t* row0, const uint8_t* row1) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i two = _mm_set1_epi16(2);
+
+        __m128i a0 = _mm_loadu_si128((const __m128i*) row0);
+        __m128i a1 = _mm_loadu_si128((const __m128i*) (row0 + 16));
+        __m128i b0 = _mm_loadu_si128((const __m128i*) row1);
+        __m128i b1 = _mm_loadu_si128((const __m128i*) (row1 + 16));
+
+        // vertical sums, two pixels per register
+        __m128i v0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero)); // pixels 0, 1
+        __m128i v1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero)); // pixels 2, 3
+        __m128i v2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero)); // pixels 4, 5
+        __m128i v3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero)); // pixels 6, 7
+
+        // horizontal sums land in the low half
+        __m128i h0 = _mm_add_epi16(v0, _mm_srli_si128(v0, 8));
+        __m128i h1 = _mm_add_epi16(v1, _mm_srli_si128(v1, 8));
+        __m128i h2 = _mm_add_epi16(v2, _mm_srli_si128(v2, 8));
+        __m128i h3 = _mm_add_epi16(v3, _mm_srli_si128(v3, 8));
+
+        __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(h0, h1), two), 2);
+        __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(h2, h3), two), 2);
+        return _mm_packus_epi16(lo, hi);
+    }
+
+    // rows [rowBegin, rowEnd) of the next level. Odd sizes drop the last row / column, a 1 pixel wide or high
+    // level repeats its only column / row
+    static void downsample(const uint8_t* src, uint32_t width, uint32_t height, uint32_t channels,
+                           uint8_t* dst, uint32_t rowBegin, uint32_t rowEnd) {
+        uint32_t dstWidth = std::max(1u, width / 2);
+        size_t srcStride = (size_t) width * channels;
+        size_t dstStride = (size_t) dstWidth * channels;
+        uint32_t stepX = width > 1 ? 1 : 0;
+
+        for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+            const uint8_t* row0 = src + (size_t) std::min(y * 2, height - 1) * srcStride;
+            const uint8_t* row1 = src + (size_t) std::min(y * 2 + 1, height - 1) * srcStride;
+            uint8_t* out = dst + y * dstStride;
+
+            uint32_t x = 0;
+            if (channels == 4 && stepX) {
+                for (; x + 4 <= dstWidth; x += 4) {
+                    _mm_storeu_si128((__m128i*) (out + x * 4), boxFilter4(row0 + x * 8, row1 + x * 8));
+                }
+            }
+
+            for (; x < dstWidth; ++x) {
+                const uint8_t* p00 = row0 + (size_t) x * 2 * channels;
+                const uint8_t* p01 = p00 + stepX * channels;
+                const uint8_t* p10 = row1 + (size_t) x * 2 * channels;
+                const uint8_t* p11 = p10 + stepX * channels;
+                for (uint32_t c = 0; c < channels; ++c) {
+                    out[x * channels + c] = (uint8_t) ((p00[c] + p01[c] + p10[c] + p11[c] + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    uint32_t MipmapGenerator::getLevelCount(uint32_t width, uint32_t height) {
+        uint32_t size = std::max(width, height);
+        uint32_t levels = 1;
+        while (size > 1) {
+            size >>= 1;
+            ++levels;
+        }
+        return levels;
+    }
+
+    std::vector<Image> MipmapGenerator::generate(const Image &base) {
+        return generate(base.getData(), base.getWidth(), base.getHeight(), base.getChannels());
+    }
+
+    std::vector<Image> MipmapGenerator::generate(const uint8_t *data, uint32_t width, uint32_t height, uint32_t channels) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        std::vector<Image> levels;
+        levels.reserve(getLevelCount(width, height) - 1);
+
+        const uint8_t *src = data;
+        while (width > 1 || height > 1) {
+            uint32_t dstWidth = std::max(1u, width / 2);
+            uint32_t dstHeight = std::max(1u, height / 2);
+            Image level(dstWidth, dstHeight, channels);
+            uint8_t *dst = level.getData();
+
+            if (dstHeight >= s_minParallelRows) {
+                JobSystem::parallelFor(dstHeight, [=](uint32_t begin, uint32_t end) {
+                    downsample(src, width, height, channels, dst, begin, end);
+                }, s_rowsPerTask);
+            } else {
+                downsample(src, width, height, channels, dst, 0, dstHeight);
+            }
+
+            levels.push_back(std::move(level));
+            src = levels.back().getData(); // the vector doesn't reallocate, it is reserved for the whole chain
+            width = dstWidth;
+            height = dstHeight;
+        }
+
+        return levels;
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef ENGINE_MIPMAPGENERATOR_H
+#define ENGINE_MIPMAPGENERATOR_H
+
+#include "Deimos/Core/Core.h"
+#include "Image.h"
+
+namespace Deimos {
+    // Builds mip chains on the CPU with a 2x2 box filter (SSE2 for RGBA), so the levels can be generated
+    // on a loader thread or baked offline instead of on the GPU
+    class MipmapGenerator {
+    public:
+        // levels of a full chain down to 1x1, the base included
+        static uint32_t getLevelCount(uint32_t width, uint32_t height);
+
+        // levels 1..n of the chain, the base isn't copied. Rows of large levels are split over the job system
+        static std::vector<Image> generate(const Image& base);
+        static std::vector<Image> generate(const uint8_t* data, uint32_t width, uint32_t height, uint32_t channels);
+    };
+}
+
+
+#endif //ENGINE_MIPMAPGENERATOR_H
@@ -4,14 +4,14 @@
 namespace Deimos {
     OrthographicCamera::OrthographicCamera(float left, float right, float bottom, float top)
             : m_viewMatrix(1.f) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         m_projectionMatrix = glm::ortho(left, right, bottom, top, -1.f, 1.f); // scene parallelepiped
         m_viewProjectionMatrix = m_projectionMatrix * m_viewMatrix;
     }
 
     void OrthographicCamera::recalculateViewMatrix() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         glm::mat4 transform = glm::translate(glm::mat4(1.f), m_position);
         transform = glm::rotate(transform, glm::radians(m_rotation), glm::vec3(0, 0, 1));
@@ -21,7 +21,7 @@ namespace Deimos {
     }
 
     void OrthographicCamera::setProjection(float left, float right, float bottom, float top) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         m_projectionMatrix = glm::ortho(left, right, bottom, top, -1.f, 1.f);
         m_viewProjectionMatrix = m_projectionMatrix * m_viewMatrix;
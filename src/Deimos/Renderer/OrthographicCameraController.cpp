@@ -13,7 +13,7 @@ namespace Deimos {
     }
 
     void OrthographicCameraController::onUpdate(Deimos::Timestep ts) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         if (Deimos::Input::isKeyPressed(DM_KEY_LEFT)) {
             m_cameraPosition.x -= cos(glm::radians(m_cameraRotation)) * m_cameraTranslationSpeed * ts;
@@ -48,7 +48,7 @@ namespace Deimos {
     }
 
     void OrthographicCameraController::onEvent(Event &e) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         EventDispatcher dispatcher(e);
         dispatcher.dispatch<MouseScrolledEvent>(DM_BIND_EVENT_FN(OrthographicCameraController::onMouseScrolled));
@@ -56,7 +56,7 @@ namespace Deimos {
     }
 
     bool OrthographicCameraController::onMouseScrolled(MouseScrolledEvent & e) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         m_zoomLevel -= e.getYOffset() * 0.25f;
         m_zoomLevel = std::max(m_zoomLevel, 0.25f);
@@ -65,7 +65,7 @@ namespace Deimos {
     }
 
     bool OrthographicCameraController::onWindowResized(WindowResizeEvent &e) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
         
         m_aspectRatio = (float) e.getWidth() / (float) e.getHeight();
         m_camera.setProjection(-m_aspectRatio * m_zoomLevel, m_aspectRatio * m_zoomLevel, -m_zoomLevel, m_zoomLevel);
@@ -0,0 +1,227 @@
+#include "dmpch.h"
+#include "PixelKernels.h"
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+    // MSVC emits any instruction set through intrinsics, only the runtime check guards them
+    #define DM_TARGET(isa)
+#else
+    #define DM_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace Deimos {
+    static SimdLevel detectLevel() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool ssse3 = (info[2] & (1 << 9)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && (_xgetbv(0) & 0x6) == 0x6) { // the OS saves the ymm registers
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#else
+        __builtin_cpu_init();
+        bool ssse3 = __builtin_cpu_supports("ssse3");
+        bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+        if (avx2)
+            return SimdLevel::AVX2;
+        return ssse3 ? SimdLevel::SSE : SimdLevel::Scalar;
+    }
+
+    SimdLevel PixelKernels::s_level = detectLevel();
+
+    SimdLevel PixelKernels::getSupportedLevel() {
+        static const SimdLevel s_supported = detectLevel();
+        return s_supported;
+    }
+
+    void PixelKernels::setLevel(SimdLevel level) {
+        s_level = std::min(level, getSupportedLevel());
+    }
+
+    const char* PixelKernels::getLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::Scalar: return "scalar";
+            case SimdLevel::SSE: return "sse";
+            case SimdLevel::AVX2: return "avx2";
+        }
+        return "unknown";
+    }
+
+    ////////////////////////////////////////// Flip ////////////////////////////////////////////////////
+
+    static void swapRowsScalar(uint8_t* a, uint8_t* b, size_t size) {
+        uint8_t tmp[256];
+        for (size_t offset = 0; offset < size; offset += sizeof(tmp)) {
+            size_t count = std::min(sizeof(tmp), size - offset);
+            memcpy(tmp, a + offset, count);
+            memcpy(a + offset, b + offset, count);
+            memcpy(b + offset, tmp, count);
+        }
+    }
+
+    static void swapRowsSSE(uint8_t* a, uint8_t* b, size_t size) {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            __m128i va = _mm_loadu_si128((const __m128i*) (a + i));
+            __m128i vb = _mm_loadu_si128((const __m128i*) (b + i));
+            _mm_storeu_si128((__m128i*) (a + i), vb);
+            _mm_storeu_si128((__m128i*) (b + i), va);
+        }
+        swapRowsScalar(a + i, b + i, size - i);
+    }
+
+    DM_TARGET("avx2")
+    static void swapRowsAVX2(uint8_t* a, uint8_t* b, size_t size) {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            __m256i va = _mm256_loadu_si256((const __m256i*) (a + i));
+            __m256i vb = _mm256_loadu_si256((const __m256i*) (b + i));
+            _mm256_storeu_si256((__m256i*) (a + i), vb);
+            _mm256_storeu_si256((__m256i*) (b + i), va);
+        }
+        swapRowsScalar(a + i, b + i, size - i);
+    }
+
+    void PixelKernels::flipVertically(uint8_t* data, size_t rowSize, uint32_t rows) {
+        if (rows < 2)
+            return;
+        auto swapRows = s_level == SimdLevel::AVX2 ? swapRowsAVX2 : s_level == SimdLevel::SSE ? swapRowsSSE : swapRowsScalar;
+        for (uint32_t top = 0, bottom = rows - 1; top < bottom; ++top, --bottom)
+            swapRows(data + top * rowSize, data + bottom * rowSize, rowSize);
+    }
+
+    ////////////////////////////////////////// RGB -> RGBA ////////////////////////////////////////////////////
+
+    static void expandRGBToRGBAScalar(const uint8_t* src, uint8_t* dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[4 * i + 0] = src[3 * i + 0];
+            dst[4 * i + 1] = src[3 * i + 1];
+            dst[4 * i + 2] = src[3 * i + 2];
+            dst[4 * i + 3] = 255;
+        }
+    }
+
+    // 4 pixels per shuffle: the 12 used bytes of the load are spread out, the alpha lanes come from the or
+    DM_TARGET("ssse3")
+    static void expandRGBToRGBASSE(const uint8_t* src, uint8_t* dst, size_t count) {
+        const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alpha = _mm_set1_epi32((int) 0xFF000000);
+
+        size_t i = 0;
+        // the load reads 16 bytes for 12, the last pixels go through the scalar loop
+        for (; i + 6 <= count; i += 4) {
+            __m128i rgb = _mm_loadu_si128((const __m128i*) (src + 3 * i));
+            _mm_storeu_si128((__m128i*) (dst + 4 * i), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+        }
+        expandRGBToRGBAScalar(src + 3 * i, dst + 4 * i, count - i);
+    }
+
+    // vpshufb stays within 128 bit lanes, so each lane gets its own 12 source bytes
+    DM_TARGET("avx2")
+    static void expandRGBToRGBAAVX2(const uint8_t* src, uint8_t* dst, size_t count) {
+        const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                                 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m256i alpha = _mm256_set1_epi32((int) 0xFF000000);
+
+        size_t i = 0;
+        for (; i + 10 <= count; i += 8) {
+            __m128i lo = _mm_loadu_si128((const __m128i*) (src + 3 * i));
+            __m128i hi = _mm_loadu_si128((const __m128i*) (src + 3 * i + 12));
+            __m256i rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+            _mm256_storeu_si256((__m256i*) (dst + 4 * i), _mm256_or_si256(_mm256_shuffle_epi8(rgb, shuffle), alpha));
+        }
+        expandRGBToRGBAScalar(src + 3 * i, dst + 4 * i, count - i);
+    }
+
+    void PixelKernels::expandRGBToRGBA(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+        if (s_level == SimdLevel::AVX2)
+            expandRGBToRGBAAVX2(src, dst, pixelCount);
+        else if (s_level == SimdLevel::SSE)
+            expandRGBToRGBASSE(src, dst, pixelCount);
+        else
+            expandRGBToRGBAScalar(src, dst, pixelCount);
+    }
+
+    ////////////////////////////////////////// Premultiply ////////////////////////////////////////////////////
+
+    // exact rounded c * a / 255: t = c * a + 128, (t + (t >> 8)) >> 8
+    static inline uint8_t mulDiv255(uint32_t c, uint32_t a) {
+        uint32_t t = c * a + 128;
+        return (uint8_t) ((t + (t >> 8)) >> 8);
+    }
+
+    static void premultiplyAlphaScalar(uint8_t* rgba, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t *p = rgba + 4 * i;
+            uint32_t a = p[3];
+            p[0] = mulDiv255(p[0], a);
+            p[1] = mulDiv255(p[1], a);
+            p[2] = mulDiv255(p[2], a);
+        }
+    }
+
+    // two pixels per 16 bit register, the alpha lane is multiplied by 255 which leaves it unchanged
+    static inline __m128i premultiply2(__m128i px, __m128i alphaLane, __m128i bias) {
+        __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        a = _mm_or_si128(a, alphaLane);
+        __m128i t = _mm_add_epi16(_mm_mullo_epi16(px, a), bias);
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    }
+
+    static void premultiplyAlphaSSE(uint8_t* rgba, size_t count) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+        const __m128i alphaLane = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i px = _mm_loadu_si128((const __m128i*) (rgba + 4 * i));
+            __m128i lo = premultiply2(_mm_unpacklo_epi8(px, zero), alphaLane, bias);
+            __m128i hi = premultiply2(_mm_unpackhi_epi8(px, zero), alphaLane, bias);
+            _mm_storeu_si128((__m128i*) (rgba + 4 * i), _mm_packus_epi16(lo, hi));
+        }
+        premultiplyAlphaScalar(rgba + 4 * i, count - i);
+    }
+
+    DM_TARGET("avx2")
+    static void premultiplyAlphaAVX2(uint8_t* rgba, size_t count) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i bias = _mm256_set1_epi16(128);
+        const __m256i alphaLane = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i px = _mm256_loadu_si256((const __m256i*) (rgba + 4 * i));
+            // unpack and pack work per lane, so the pixel order survives the round trip
+            __m256i lo = _mm256_unpacklo_epi8(px, zero);
+            __m256i hi = _mm256_unpackhi_epi8(px, zero);
+
+            __m256i alo = _mm256_or_si256(_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)), alphaLane);
+            __m256i ahi = _mm256_or_si256(_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)), alphaLane);
+
+            __m256i tlo = _mm256_add_epi16(_mm256_mullo_epi16(lo, alo), bias);
+            __m256i thi = _mm256_add_epi16(_mm256_mullo_epi16(hi, ahi), bias);
+            lo = _mm256_srli_epi16(_mm256_add_epi16(tlo, _mm256_srli_epi16(tlo, 8)), 8);
+            hi = _mm256_srli_epi16(_mm256_add_epi16(thi, _mm256_srli_epi16(thi, 8)), 8);
+            _mm256_storeu_si256((__m256i*) (rgba + 4 * i), _mm256_packus_epi16(lo, hi));
+        }
+        premultiplyAlphaScalar(rgba + 4 * i, count - i);
+    }
+
+    void PixelKernels::premultiplyAlpha(uint8_t* rgba, size_t pixelCount) {
+        if (s_level == SimdLevel::AVX2)
+            premultiplyAlphaAVX2(rgba, pixelCount);
+        else if (s_level == SimdLevel::SSE)
+            premultiplyAlphaSSE(rgba, pixelCount);
+        else
+            premultiplyAlphaScalar(rgba, pixelCount);
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef ENGINE_PIXELKERNELS_H
+#define ENGINE_PIXELKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Deimos {
+    enum class SimdLevel {
+        Scalar = 0,
+        SSE, // SSE2 + SSSE3
+        AVX2
+    };
+
+    // Pixel format conversions run on decoded images. Each kernel has a scalar, an SSE and an AVX2 version,
+    // the best one the CPU supports is picked at runtime
+    class PixelKernels {
+    public:
+        static SimdLevel getSupportedLevel();
+        inline static SimdLevel getLevel() { return s_level; }
+        // clamped to the supported level, lower levels are for comparing the kernels
+        static void setLevel(SimdLevel level);
+        static const char* getLevelName(SimdLevel level);
+
+        // swaps the rows top to bottom in place
+        static void flipVertically(uint8_t* data, size_t rowSize, uint32_t rows);
+        // 3 channel pixels to 4 channels with opaque alpha, src and dst must not overlap
+        static void expandRGBToRGBA(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+        // RGBA in place, color = color * alpha / 255 rounded
+        static void premultiplyAlpha(uint8_t* rgba, size_t pixelCount);
+    private:
+        static SimdLevel s_level;
+    };
+}
+
+
+#endif //ENGINE_PIXELKERNELS_H
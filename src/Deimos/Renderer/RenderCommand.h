@@ -27,9 +27,25 @@ namespace Deimos {
             s_rendererAPI->init();
         }
 
+        inline static void shutdown() {
+            s_rendererAPI->shutdown();
+        }
+
         inline static void setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
             s_rendererAPI->setViewport(x, y, width, height);
         }
+
+        inline static void finish() {
+            s_rendererAPI->finish();
+        }
+
+        inline static uint32_t getMaxTextureSlots() {
+            return s_rendererAPI->getMaxTextureSlots();
+        }
+
+        inline static bool hasBindlessTextures() {
+            return s_rendererAPI->hasBindlessTextures();
+        }
     private:
         static Scope<RendererAPI> s_rendererAPI;
     };
@@ -1,4 +1,6 @@
 #include "Renderer.h"
+#include "TextureLoader.h"
+#include "TextureCache.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
 namespace Deimos {
@@ -28,9 +30,20 @@ namespace Deimos {
     }
 
     void Renderer::init() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
         
         RenderCommand::init();
+        GPUProfiler::init();
+        TextureLoader::init();
+    }
+
+    void Renderer::shutdown() {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
+
+        TextureCache::clear();
+        TextureLoader::shutdown();
+        GPUProfiler::shutdown();
+        RenderCommand::shutdown();
     }
 }
 
@@ -19,16 +19,29 @@ namespace Deimos {
         glm::vec4 color;
         glm::vec2 texCoord;
         float texID;
+        float texLayer; // negative for 2D textures
     };
 
     struct Renderer2DData {
         const uint32_t maxQuads = 10'000;
         const uint32_t maxVertices = maxQuads * 4;
         const uint32_t maxIndices = maxQuads * 6;
-        static const int maxSlots = 16; // TODO: derive from specs
 
-        std::array<Ref<Texture>, maxSlots> textures;
+        // slot path, the counts are derived from GL_MAX_TEXTURE_IMAGE_UNITS in init
+        uint32_t maxTextureSlots = 16;
+        uint32_t maxArraySlots = 1;
+        std::vector<Ref<Texture>> textures;
+        std::vector<Ref<Texture>> textureArrays;
         uint32_t index = 1; // 0 is reserved for white texture
+        uint32_t arrayIndex = 0;
+
+        // bindless path, one handle per distinct texture of the batch. A quad adds at most one,
+        // so the buffer never fills before the vertices do
+        bool bindless = false;
+        std::vector<uint64_t> handles;
+        std::unordered_map<uint64_t, uint32_t> handleIndices;
+        std::vector<Ref<Texture>> batchTextures; // kept alive until the batch is drawn
+        Ref<StorageBuffer> handleBuffer;
 
         QuadVertex* quadVertexBufferBase = nullptr;
         QuadVertex* quadVertexBufferPtr = nullptr;
@@ -51,29 +64,128 @@ namespace Deimos {
         Ref<Texture2D> whiteTexture;
 
         glm::vec4 QuadVertexPositions[4];
+        glm::vec2 defaultTexCoords[4] = { { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } };
+
+        Renderer2DStatistics stats;
     };
 
     static Renderer2DData s_data;
 
-    void Renderer2D::init() {
-        DM_PROFILE_FUNCTION();
+    static const char* s_textureVertexSrc = R"(
+        #version 450 core
 
-        s_data.whiteTexture = Texture2D::create(1, 1);
-        uint32_t whiteTextureData = 0xffffffff;
-        s_data.whiteTexture->setData(&whiteTextureData, sizeof(uint32_t));
-        s_data.textures[0] = s_data.whiteTexture;
+        layout(location = 0) in vec3 a_position;
+        layout(location = 1) in vec4 a_color;
+        layout(location = 2) in vec2 a_texCoord;
+        layout(location = 3) in float a_texID;
+        layout(location = 4) in float a_texLayer;
 
-        s_data.textureShader = Shader::create(std::string(ASSETS_DIR) + "/shaders/Texture.glsl");
-        s_data.plainColorShader = Shader::create(std::string(ASSETS_DIR) + "/shaders/PlainColor.glsl");
+        uniform mat4 u_viewProjection;
+
+        out vec4 v_color;
+        out vec2 v_texCoord;
+        flat out int v_texID;
+        flat out float v_texLayer;
+
+        void main() {
+            v_color = a_color;
+            v_texCoord = a_texCoord;
+            v_texID = int(a_texID);
+            v_texLayer = a_texLayer;
+            gl_Position = u_viewProjection * vec4(a_position, 1.0);
+        }
+    )";
+
+    // u_textures and u_textureArrays are sized by init
+    static const char* s_textureSlotFragmentSrc = R"(
+        layout(location = 0) out vec4 color;
+
+        in vec4 v_color;
+        in vec2 v_texCoord;
+        flat in int v_texID;
+        flat in float v_texLayer;
+
+        uniform sampler2D u_textures[MAX_TEXTURE_SLOTS];
+        uniform sampler2DArray u_textureArrays[MAX_ARRAY_SLOTS];
+
+        void main() {
+            if (v_texLayer < 0.0)
+                color = texture(u_textures[v_texID], v_texCoord) * v_color;
+            else
+                color = texture(u_textureArrays[v_texID], vec3(v_texCoord, v_texLayer)) * v_color;
+        }
+    )";
+
+    static const char* s_textureBindlessFragmentSrc = R"(
+        #extension GL_ARB_bindless_texture : require
+
+        layout(location = 0) out vec4 color;
+
+        in vec4 v_color;
+        in vec2 v_texCoord;
+        flat in int v_texID;
+        flat in float v_texLayer;
+
+        layout(std430, binding = 0) readonly buffer TextureHandles {
+            uvec2 u_handles[];
+        };
+
+        void main() {
+            if (v_texLayer < 0.0)
+                color = texture(sampler2D(u_handles[v_texID]), v_texCoord) * v_color;
+            else
+                color = texture(sampler2DArray(u_handles[v_texID]), vec3(v_texCoord, v_texLayer)) * v_color;
+        }
+    )";
 
+    static void createTextureShader() {
+        if (s_data.bindless) {
+            s_data.textureShader = Shader::create("Texture", s_textureVertexSrc,
+                                                  std::string("#version 450 core\n") + s_textureBindlessFragmentSrc);
+            return;
+        }
+
+        std::string fragmentSrc = "#version 450 core\n";
+        fragmentSrc += "#define MAX_TEXTURE_SLOTS " + std::to_string(s_data.maxTextureSlots) + "\n";
+        fragmentSrc += "#define MAX_ARRAY_SLOTS " + std::to_string(s_data.maxArraySlots) + "\n";
+        fragmentSrc += s_textureSlotFragmentSrc;
+        s_data.textureShader = Shader::create("Texture", s_textureVertexSrc, fragmentSrc);
+
+        // 2D textures on the first units, arrays after them
         s_data.textureShader->bind();
-        
-        // Array of sample slots
-        int samplers[s_data.maxSlots];
-        for (uint32_t i = 0; i < s_data.maxSlots; ++i)
+        std::vector<int> samplers(s_data.maxTextureSlots + s_data.maxArraySlots);
+        for (uint32_t i = 0; i < samplers.size(); ++i)
             samplers[i] = i;
 
-        s_data.textureShader->setIntVec("u_textures", samplers, s_data.maxSlots);
+        s_data.textureShader->setIntVec("u_textures", samplers.data(), s_data.maxTextureSlots);
+        s_data.textureShader->setIntVec("u_textureArrays", samplers.data() + s_data.maxTextureSlots, s_data.maxArraySlots);
+    }
+
+    void Renderer2D::init(bool allowBindless) {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
+
+        s_data.whiteTexture = Texture2D::create(1, 1);
+        uint32_t whiteTextureData = 0xffffffff;
+        s_data.whiteTexture->setData(&whiteTextureData, sizeof(uint32_t));
+
+        s_data.bindless = allowBindless && RenderCommand::hasBindlessTextures();
+        if (s_data.bindless) {
+            s_data.handles.reserve(s_data.maxQuads + 1);
+            s_data.batchTextures.reserve(s_data.maxQuads + 1);
+            s_data.handleBuffer = StorageBuffer::create((s_data.maxQuads + 1) * sizeof(uint64_t));
+            DM_CORE_INFO("Renderer2D: using bindless textures");
+        } else {
+            uint32_t units = std::min(RenderCommand::getMaxTextureSlots(), 32u);
+            s_data.maxArraySlots = std::min(8u, std::max(1u, units > 16 ? units - 16 : 1u));
+            s_data.maxTextureSlots = units - s_data.maxArraySlots;
+            s_data.textures.resize(s_data.maxTextureSlots);
+            s_data.textureArrays.resize(s_data.maxArraySlots);
+            s_data.textures[0] = s_data.whiteTexture;
+            DM_CORE_INFO("Renderer2D: {0} texture slots, {1} texture array slots", s_data.maxTextureSlots, s_data.maxArraySlots);
+        }
+
+        createTextureShader();
+        s_data.plainColorShader = Shader::create(std::string(ASSETS_DIR) + "/shaders/PlainColor.glsl");
 
         s_data.QuadVertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
         s_data.QuadVertexPositions[1] = { 0.5f, -0.5f, 0.0f, 1.0f };
@@ -120,7 +232,8 @@ namespace Deimos {
                             { ShaderDataType::Float3, "a_position" },
                             { ShaderDataType::Float4, "a_color" },
                             { ShaderDataType::Float2, "a_texCoord" },
-                            { ShaderDataType::Float,  "a_texID"}
+                            { ShaderDataType::Float,  "a_texID"},
+                            { ShaderDataType::Float,  "a_texLayer"}
                     });
             s_data.quadVertexArray->addVertexBuffer(s_data.quadVB);
 
@@ -224,36 +337,216 @@ namespace Deimos {
         }
     }
 
+    void Renderer2D::resetStats() {
+        s_data.stats = Renderer2DStatistics();
+    }
+
+    const Renderer2DStatistics &Renderer2D::getStats() {
+        return s_data.stats;
+    }
+
     void Renderer2D::shutdown() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
+
+        delete[] s_data.quadVertexBufferBase;
+        s_data.quadVertexBufferBase = nullptr;
+        s_data.quadVertexBufferPtr = nullptr;
+        s_data.quadIndexCount = 0;
+
+        s_data.textures.clear();
+        s_data.textureArrays.clear();
+        s_data.index = 1;
+        s_data.arrayIndex = 0;
+
+        s_data.handles.clear();
+        s_data.handleIndices.clear();
+        s_data.batchTextures.clear();
+        s_data.handleBuffer.reset();
+
+        s_data.quadVB.reset();
+        s_data.quadVertexArray.reset();
+        s_data.lineVertexArray.reset();
+        s_data.triangleVertexArray.reset();
+        s_data.circleVertexArray.reset();
+        s_data.ovalVertexArray.reset();
+        s_data.polygonVertexArray.reset();
+        s_data.bezierVertexArray.reset();
+
+        s_data.textureShader.reset();
+        s_data.plainColorShader.reset();
+        s_data.whiteTexture.reset();
     }
 
-    void Renderer2D::beginScene(const OrthographicCamera &camera) {
-        DM_PROFILE_FUNCTION();
+    bool Renderer2D::usesBindlessTextures() {
+        return s_data.bindless;
+    }
 
+    static void startBatch() {
         s_data.quadIndexCount = 0;
         s_data.quadVertexBufferPtr = s_data.quadVertexBufferBase;
+        s_data.index = 1;
+        s_data.arrayIndex = 0;
 
-        s_data.textureShader->bind();
-        s_data.textureShader->setMat4("u_viewProjection", camera.getViewProjectionMatrix());
+        if (s_data.bindless) {
+            s_data.handles.clear();
+            s_data.handleIndices.clear();
+            s_data.batchTextures.clear();
 
-        s_data.plainColorShader->bind();
-        s_data.plainColorShader->setMat4("u_viewProjection", camera.getViewProjectionMatrix());
+            uint64_t whiteHandle = s_data.whiteTexture->getBindlessHandle();
+            s_data.handles.push_back(whiteHandle);
+            s_data.handleIndices[whiteHandle] = 0;
+        }
     }
 
-    void Renderer2D::endScene() {
-        DM_PROFILE_FUNCTION();
+    // drops the batch's references once it is drawn, a texture held by nobody else can then be evicted by the cache
+    static void releaseBatchTextures() {
+        for (uint32_t i = 1; i < s_data.index; ++i)
+            s_data.textures[i] = nullptr;
+        for (uint32_t i = 0; i < s_data.arrayIndex; ++i)
+            s_data.textureArrays[i] = nullptr;
+        s_data.index = 1;
+        s_data.arrayIndex = 0;
+        s_data.batchTextures.clear();
+    }
+
+    static void flush() {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
+
+        if (s_data.quadIndexCount == 0) {
+            releaseBatchTextures();
+            return;
+        }
+        DM_PROFILE_CATEGORY_COUNTER(Renderer, "Quads per batch", s_data.quadIndexCount / 6);
 
         uint32_t size = (uint8_t*)s_data.quadVertexBufferPtr - (uint8_t*)s_data.quadVertexBufferBase;
         s_data.quadVB->setData(s_data.quadVertexBufferBase, size);
-        
+
+        s_data.textureShader->bind();
         s_data.quadVertexArray->bind();
-         // Bind textures to some slots
-        for (uint32_t i = 0; i < s_data.index; ++i) {
-            s_data.textures[i]->bind(i);
+        if (s_data.bindless) {
+            s_data.handleBuffer->setData(s_data.handles.data(), s_data.handles.size() * sizeof(uint64_t));
+            s_data.handleBuffer->bind(0);
+        } else {
+            // Bind textures to some slots
+            for (uint32_t i = 0; i < s_data.index; ++i)
+                s_data.textures[i]->bind(i);
+            for (uint32_t i = 0; i < s_data.arrayIndex; ++i)
+                s_data.textureArrays[i]->bind(s_data.maxTextureSlots + i);
         }
-        
+
+        DM_PROFILE_GPU_SCOPE("Renderer2D::flush drawIndexed");
         RenderCommand::drawIndexed(s_data.quadVertexArray, s_data.quadIndexCount);
+        s_data.stats.drawCalls++;
+
+        releaseBatchTextures();
+    }
+
+    // index of the texture in the handle buffer, never flushes (see Renderer2DData)
+    static float getBindlessIndex(const Ref<Texture> &texture) {
+        uint64_t handle = texture->getBindlessHandle();
+        auto it = s_data.handleIndices.find(handle);
+        if (it != s_data.handleIndices.end())
+            return (float) it->second;
+
+        uint32_t index = (uint32_t) s_data.handles.size();
+        s_data.handles.push_back(handle);
+        s_data.handleIndices[handle] = index;
+        s_data.batchTextures.push_back(texture);
+        return (float) index;
+    }
+
+    // slot of the texture in the current batch, starts a new batch when all slots are taken
+    static float getTextureSlot(const Ref<Texture> &texture) {
+        if (s_data.bindless)
+            return getBindlessIndex(texture);
+
+        for (uint32_t i = 1; i < s_data.index; ++i) {
+            if (*s_data.textures[i].get() == *texture.get())
+                return (float) i;
+        }
+
+        if (s_data.index == s_data.maxTextureSlots) {
+            flush();
+            startBatch();
+        }
+
+        s_data.textures[s_data.index] = texture;
+        return (float) s_data.index++;
+    }
+
+    static float getTextureArraySlot(const Ref<Texture2DArray> &textureArray) {
+        if (s_data.bindless)
+            return getBindlessIndex(textureArray);
+
+        for (uint32_t i = 0; i < s_data.arrayIndex; ++i) {
+            if (*s_data.textureArrays[i].get() == *textureArray.get())
+                return (float) i;
+        }
+
+        if (s_data.arrayIndex == s_data.maxArraySlots) {
+            flush();
+            startBatch();
+        }
+
+        s_data.textureArrays[s_data.arrayIndex] = textureArray;
+        return (float) s_data.arrayIndex++;
+    }
+
+    static void submitQuad(const glm::mat4 &transform, const glm::vec4 &color, float textureIndex, const glm::vec2 *texCoords, float layer = -1.f) {
+        if (s_data.quadIndexCount >= s_data.maxIndices) {
+            flush();
+            startBatch();
+        }
+
+        for (uint32_t i = 0; i < 4; ++i) {
+            s_data.quadVertexBufferPtr->position = transform * s_data.QuadVertexPositions[i];
+            s_data.quadVertexBufferPtr->color = color;
+            s_data.quadVertexBufferPtr->texCoord = texCoords[i];
+            s_data.quadVertexBufferPtr->texID = textureIndex;
+            s_data.quadVertexBufferPtr->texLayer = layer;
+            s_data.quadVertexBufferPtr++;
+        }
+
+        s_data.quadIndexCount += 6;
+        s_data.stats.quads++;
+    }
+
+    static void submitTexturedQuad(const glm::mat4 &transform, const Ref<Texture> &texture, const glm::vec2 *texCoords, const glm::vec4 &tintColor) {
+        // the slot lookup may flush, so it has to happen before the vertices are written
+        if (s_data.quadIndexCount >= s_data.maxIndices) {
+            flush();
+            startBatch();
+        }
+        float textureIndex = getTextureSlot(texture);
+        submitQuad(transform, tintColor, textureIndex, texCoords);
+    }
+
+    static void submitTextureArrayQuad(const glm::mat4 &transform, const Ref<Texture2DArray> &textureArray, uint32_t layer, const glm::vec4 &tintColor) {
+        DM_CORE_ASSERT(layer < textureArray->getLayerCount(), "Texture array layer out of range!");
+        if (s_data.quadIndexCount >= s_data.maxIndices) {
+            flush();
+            startBatch();
+        }
+        float textureIndex = getTextureArraySlot(textureArray);
+        submitQuad(transform, tintColor, textureIndex, s_data.defaultTexCoords, (float) layer);
+    }
+
+    void Renderer2D::beginScene(const OrthographicCamera &camera) {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
+
+        startBatch();
+
+        s_data.textureShader->bind();
+        s_data.textureShader->setMat4("u_viewProjection", camera.getViewProjectionMatrix());
+
+        s_data.plainColorShader->bind();
+        s_data.plainColorShader->setMat4("u_viewProjection", camera.getViewProjectionMatrix());
+    }
+
+    void Renderer2D::endScene() {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
+
+        flush();
     }
 
     void Renderer2D::drawLine(const glm::vec2 &start, const glm::vec2 &end, float thickness, const glm::vec4 &color, float tilingFactor, const glm::vec4 &tintColor) {
@@ -261,7 +554,7 @@ namespace Deimos {
     }
 
     void Renderer2D::drawLine(const glm::vec3 &start, const glm::vec3 &end, float thickness, const glm::vec4 &color, float tilingFactor, const glm::vec4 &tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         s_data.plainColorShader->bind();
         glm::vec3 direction = end - start; // direction vector
@@ -282,6 +575,8 @@ namespace Deimos {
 
         s_data.lineVertexArray->bind();
         RenderCommand::drawLine(s_data.lineVertexArray, thickness);
+        s_data.stats.drawCalls++;
+        s_data.stats.shapes++;
     }
 
     void Renderer2D::drawQuad(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color, float tilingFactor, const glm::vec4& tintColor) {
@@ -289,39 +584,13 @@ namespace Deimos {
     }
 
     void Renderer2D::drawQuad(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color, float tilingFactor, const glm::vec4& tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         const float textureIdex = 0.f; // white texture
 
         glm::mat4 transfrom = glm::translate(glm::mat4(1.f), position) * glm::scale(glm::mat4(1.f), { size.x, size.y, 1.f });
 
-        s_data.textureShader->bind();
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[0];
-        s_data.quadVertexBufferPtr->color = color;
-        s_data.quadVertexBufferPtr->texCoord = { 0, 0 };
-        s_data.quadVertexBufferPtr->texID = textureIdex;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[1];
-        s_data.quadVertexBufferPtr->color = color;
-        s_data.quadVertexBufferPtr->texCoord = { 1, 0 };
-        s_data.quadVertexBufferPtr->texID = textureIdex;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[2];
-        s_data.quadVertexBufferPtr->color = color;
-        s_data.quadVertexBufferPtr->texCoord = { 1, 1 };
-        s_data.quadVertexBufferPtr->texID = textureIdex;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[3];
-        s_data.quadVertexBufferPtr->color = color;
-        s_data.quadVertexBufferPtr->texCoord = { 0, 1 };
-        s_data.quadVertexBufferPtr->texID = textureIdex;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadIndexCount += 6;
+        submitQuad(transfrom, color, textureIdex, s_data.defaultTexCoords);
     }
 
     /**@param rotation The rotation of the quad in radians*/
@@ -331,7 +600,7 @@ namespace Deimos {
 
     /**@param rotation The rotation of the quad in radians*/
     void Renderer2D::drawRotatedQuad(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color, float rotation, float tilingFactor, const glm::vec4& tintColor) {
-        DM_PROFILE_FUNCTION()
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer)
 
         const float textureIdex = 0.f; // white texture
 
@@ -339,33 +608,7 @@ namespace Deimos {
                               * glm::rotate(glm::mat4(1.f), glm::radians(rotation), { 0.f, 0.f, 1.f })
                               * glm::scale(glm::mat4(1.f), { size.x, size.y, 1.f });
 
-        s_data.textureShader->bind();
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[0];
-        s_data.quadVertexBufferPtr->color = color;
-        s_data.quadVertexBufferPtr->texCoord = { 0, 0 };
-        s_data.quadVertexBufferPtr->texID = textureIdex;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[1];
-        s_data.quadVertexBufferPtr->color = color;
-        s_data.quadVertexBufferPtr->texCoord = { 1, 0 };
-        s_data.quadVertexBufferPtr->texID = textureIdex;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[2];
-        s_data.quadVertexBufferPtr->color = color;
-        s_data.quadVertexBufferPtr->texCoord = { 1, 1 };
-        s_data.quadVertexBufferPtr->texID = textureIdex;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[3];
-        s_data.quadVertexBufferPtr->color = color;
-        s_data.quadVertexBufferPtr->texCoord = { 0, 1 };
-        s_data.quadVertexBufferPtr->texID = textureIdex;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadIndexCount += 6;
+        submitQuad(transfrom, color, textureIdex, s_data.defaultTexCoords);
     }
 
     void Renderer2D::drawQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<Texture> &texture, float tilingFactor, const glm::vec4& tintColor) {
@@ -373,50 +616,11 @@ namespace Deimos {
     }
 
     void Renderer2D::drawQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<Texture> &texture, float tilingFactor, const glm::vec4& tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         glm::mat4 transfrom = glm::translate(glm::mat4(1.f), position) * glm::scale(glm::mat4(1.f), { size.x, size.y, 1.f });
 
-        uint32_t index = 0;
-        for (uint32_t i = 1; i < s_data.index; ++i) {
-            if (*s_data.textures[i].get() == *texture.get()) {
-                index = i;
-                break;
-            }
-        }
-        if (!index) {
-            s_data.textures[s_data.index] = texture;
-            index = s_data.index;
-            s_data.index++;
-        }
-
-        s_data.textureShader->bind();
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[0];
-        s_data.quadVertexBufferPtr->color = tintColor;
-        s_data.quadVertexBufferPtr->texCoord = { 0, 0 };
-        s_data.quadVertexBufferPtr->texID = index;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[1];
-        s_data.quadVertexBufferPtr->color = tintColor;
-        s_data.quadVertexBufferPtr->texCoord = { 1, 0 };
-        s_data.quadVertexBufferPtr->texID = index;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[2];
-        s_data.quadVertexBufferPtr->color = tintColor;
-        s_data.quadVertexBufferPtr->texCoord = { 1, 1 };
-        s_data.quadVertexBufferPtr->texID = index;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[3];
-        s_data.quadVertexBufferPtr->color = tintColor;
-        s_data.quadVertexBufferPtr->texCoord = { 0, 1 };
-        s_data.quadVertexBufferPtr->texID = index;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadIndexCount += 6;
+        submitTexturedQuad(transfrom, texture, s_data.defaultTexCoords, tintColor);
     }
 
     /**@param rotation The rotation of the quad in degrees*/
@@ -426,53 +630,69 @@ namespace Deimos {
 
     /**@param rotation The rotation of the quad in degrees*/
     void Renderer2D::drawRotatedQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<Texture> &texture, float rotation, float tilingFactor, const glm::vec4& tintColor) {
-        DM_PROFILE_FUNCTION()
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer)
 
         glm::mat4 transfrom = glm::translate(glm::mat4(1.f), position)
                               * glm::rotate(glm::mat4(1.f), glm::radians(rotation), { 0.f, 0.f, 1.f })
                               * glm::scale(glm::mat4(1.f), { size.x, size.y, 1.f });
 
-        uint32_t index = 0;
-        for (uint32_t i = 1; i < s_data.index; ++i) {
-            if (*s_data.textures[i].get() == *texture.get()) {
-                index = i;
-                break;
-            }
-        }
-        if (!index) {
-            s_data.textures[s_data.index] = texture;
-            index = s_data.index;
-            s_data.index++;
-        }
+        submitTexturedQuad(transfrom, texture, s_data.defaultTexCoords, tintColor);
+    }
 
-        s_data.textureShader->bind();
+    void Renderer2D::drawQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<SubTexture2D> &subTexture, float tilingFactor, const glm::vec4& tintColor) {
+        drawQuad({ position.x, position.y, 0.f }, size, subTexture, tilingFactor, tintColor);
+    }
 
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[0];
-        s_data.quadVertexBufferPtr->color = tintColor;
-        s_data.quadVertexBufferPtr->texCoord = { 0, 0 };
-        s_data.quadVertexBufferPtr->texID = index;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[1];
-        s_data.quadVertexBufferPtr->color = tintColor;
-        s_data.quadVertexBufferPtr->texCoord = { 1, 0 };
-        s_data.quadVertexBufferPtr->texID = index;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[2];
-        s_data.quadVertexBufferPtr->color = tintColor;
-        s_data.quadVertexBufferPtr->texCoord = { 1, 1 };
-        s_data.quadVertexBufferPtr->texID = index;
-        s_data.quadVertexBufferPtr++;
-
-        s_data.quadVertexBufferPtr->position = transfrom * s_data.QuadVertexPositions[3];
-        s_data.quadVertexBufferPtr->color = tintColor;
-        s_data.quadVertexBufferPtr->texCoord = { 0, 1 };
-        s_data.quadVertexBufferPtr->texID = index;
-        s_data.quadVertexBufferPtr++;
+    void Renderer2D::drawQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<SubTexture2D> &subTexture, float tilingFactor, const glm::vec4& tintColor) {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
-        s_data.quadIndexCount += 6;
-       
+        glm::mat4 transfrom = glm::translate(glm::mat4(1.f), position) * glm::scale(glm::mat4(1.f), { size.x, size.y, 1.f });
+
+        submitTexturedQuad(transfrom, subTexture->getTexture(), subTexture->getTexCoords(), tintColor);
+    }
+
+    /**@param rotation The rotation of the quad in degrees*/
+    void Renderer2D::drawRotatedQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<SubTexture2D> &subTexture, float rotation, float tilingFactor, const glm::vec4& tintColor) {
+        drawRotatedQuad({ position.x, position.y, 0.f }, size, subTexture, rotation, tilingFactor, tintColor);
+    }
+
+    /**@param rotation The rotation of the quad in degrees*/
+    void Renderer2D::drawRotatedQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<SubTexture2D> &subTexture, float rotation, float tilingFactor, const glm::vec4& tintColor) {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer)
+
+        glm::mat4 transfrom = glm::translate(glm::mat4(1.f), position)
+                              * glm::rotate(glm::mat4(1.f), glm::radians(rotation), { 0.f, 0.f, 1.f })
+                              * glm::scale(glm::mat4(1.f), { size.x, size.y, 1.f });
+
+        submitTexturedQuad(transfrom, subTexture->getTexture(), subTexture->getTexCoords(), tintColor);
+    }
+
+    void Renderer2D::drawQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<Texture2DArray> &textureArray, uint32_t layer, float tilingFactor, const glm::vec4& tintColor) {
+        drawQuad({ position.x, position.y, 0.f }, size, textureArray, layer, tilingFactor, tintColor);
+    }
+
+    void Renderer2D::drawQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<Texture2DArray> &textureArray, uint32_t layer, float tilingFactor, const glm::vec4& tintColor) {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
+
+        glm::mat4 transfrom = glm::translate(glm::mat4(1.f), position) * glm::scale(glm::mat4(1.f), { size.x, size.y, 1.f });
+
+        submitTextureArrayQuad(transfrom, textureArray, layer, tintColor);
+    }
+
+    /**@param rotation The rotation of the quad in degrees*/
+    void Renderer2D::drawRotatedQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<Texture2DArray> &textureArray, uint32_t layer, float rotation, float tilingFactor, const glm::vec4& tintColor) {
+        drawRotatedQuad({ position.x, position.y, 0.f }, size, textureArray, layer, rotation, tilingFactor, tintColor);
+    }
+
+    /**@param rotation The rotation of the quad in degrees*/
+    void Renderer2D::drawRotatedQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<Texture2DArray> &textureArray, uint32_t layer, float rotation, float tilingFactor, const glm::vec4& tintColor) {
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer)
+
+        glm::mat4 transfrom = glm::translate(glm::mat4(1.f), position)
+                              * glm::rotate(glm::mat4(1.f), glm::radians(rotation), { 0.f, 0.f, 1.f })
+                              * glm::scale(glm::mat4(1.f), { size.x, size.y, 1.f });
+
+        submitTextureArrayQuad(transfrom, textureArray, layer, tintColor);
     }
 
     void Renderer2D::drawTriangle(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color, float tilingFactor, const glm::vec4 &tintColor) {
@@ -480,7 +700,7 @@ namespace Deimos {
     }
 
     void Renderer2D::drawTriangle(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color, float tilingFactor, const glm::vec4 &tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         s_data.plainColorShader->bind();
 
@@ -490,6 +710,8 @@ namespace Deimos {
 
         s_data.triangleVertexArray->bind();
         RenderCommand::drawIndexed(s_data.triangleVertexArray);
+        s_data.stats.drawCalls++;
+        s_data.stats.shapes++;
     }
 
     /**@param rotation The rotation of the triangle in radians*/
@@ -499,7 +721,7 @@ namespace Deimos {
 
     /**@param rotation The rotation of the triangle in radians*/
     void Renderer2D::drawRotatedTriangle(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color, float rotation, float tilingFactor, const glm::vec4 &tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         s_data.plainColorShader->bind();
 
@@ -509,6 +731,8 @@ namespace Deimos {
 
         s_data.triangleVertexArray->bind();
         RenderCommand::drawIndexed(s_data.triangleVertexArray);
+        s_data.stats.drawCalls++;
+        s_data.stats.shapes++;
     }
     
     void Renderer2D::drawCircle(const glm::vec2 &position, float radius, int vCount, const glm::vec4 &color, float tilingFactor, const glm::vec4 &tintColor) {
@@ -516,7 +740,7 @@ namespace Deimos {
     }
 
     void Renderer2D::drawCircle(const glm::vec3 &position, float radius, int vCount, const glm::vec4 &color, float tilingFactor, const glm::vec4 &tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         s_data.plainColorShader->bind();
 
@@ -526,6 +750,8 @@ namespace Deimos {
 
         s_data.circleVertexArray->bind();
         RenderCommand::drawIndexed(s_data.circleVertexArray);
+        s_data.stats.drawCalls++;
+        s_data.stats.shapes++;
     }
 
     /**@param rotation The rotation of the oval in radians*/
@@ -535,7 +761,7 @@ namespace Deimos {
 
     /**@param rotation The rotation of the oval in radians*/
     void Renderer2D::drawOval(const glm::vec3 &center, float a, float b, float rotation, const glm::vec4 &color, float tilingFactor, const glm::vec4 &tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         s_data.ovalVertexArray = VertexArray::create();
 
@@ -586,11 +812,13 @@ namespace Deimos {
 
         s_data.ovalVertexArray->bind();
         RenderCommand::drawIndexed(s_data.ovalVertexArray);
+        s_data.stats.drawCalls++;
+        s_data.stats.shapes++;
     }
 
 
     void Renderer2D::drawPolygon(const glm::vec3 *vertices, int vCount, const glm::vec4 &color, float tilingFactor, const glm::vec4& tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         std::vector<float> polygonVertices;
         polygonVertices.resize(vCount * 3);
@@ -654,10 +882,12 @@ namespace Deimos {
 
         s_data.polygonVertexArray->bind();
         RenderCommand::drawIndexed(s_data.polygonVertexArray);
+        s_data.stats.drawCalls++;
+        s_data.stats.shapes++;
     }
 
     void Renderer2D::drawBezier(const glm::vec3 &anchor1, const glm::vec3 &control, const glm::vec3 &anchor2, const glm::vec4 &color, float tilingFactor, const glm::vec4& tintColor) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Renderer);
 
         s_data.bezierVertexArray = VertexArray::create();
 
@@ -708,5 +938,7 @@ namespace Deimos {
 
         s_data.bezierVertexArray->bind();
         RenderCommand::drawIndexed(s_data.bezierVertexArray);
+        s_data.stats.drawCalls++;
+        s_data.stats.shapes++;
     }
 }
@@ -3,16 +3,31 @@
 
 #include "OrthographicCamera.h"
 #include "Texture.h"
+#include "SubTexture2D.h"
 
 namespace Deimos {
+    // since the last resetStats, e.g. per frame
+    struct Renderer2DStatistics {
+        uint32_t drawCalls = 0;
+        uint32_t quads = 0;  // batched, textured or not
+        uint32_t shapes = 0; // lines, triangles, circles, ovals, polygons and curves, a draw call each
+    };
+
     class Renderer2D {
     public:
-        static void init();
+        // allowBindless false keeps to texture slots even where bindless textures are supported
+        static void init(bool allowBindless = true);
+        // releases the GPU resources, init may be called again afterwards
         static void shutdown();
 
+        static bool usesBindlessTextures();
+
         static void beginScene(const OrthographicCamera &camera);
         static void endScene();
 
+        static void resetStats();
+        static const Renderer2DStatistics& getStats();
+
         // Line with color
         static void drawLine(const glm::vec2 &start, const glm::vec2 &end, float thickness, const glm::vec4 &color, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
         static void drawLine(const glm::vec3 &start, const glm::vec3 &end, float thickness, const glm::vec4 &color, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
@@ -29,6 +44,18 @@ namespace Deimos {
         static void drawRotatedQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<Texture>& texture, float rotation, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
         static void drawRotatedQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<Texture>& texture, float rotation, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
 
+        // Quad with a region of a texture (sprite sheet cell, atlas entry)
+        static void drawQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
+        static void drawQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
+        static void drawRotatedQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<SubTexture2D>& subTexture, float rotation, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
+        static void drawRotatedQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<SubTexture2D>& subTexture, float rotation, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
+
+        // Quad with one layer of a texture array
+        static void drawQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<Texture2DArray>& textureArray, uint32_t layer, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
+        static void drawQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<Texture2DArray>& textureArray, uint32_t layer, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
+        static void drawRotatedQuad(const glm::vec2 &position, const glm::vec2 &size, const Ref<Texture2DArray>& textureArray, uint32_t layer, float rotation, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
+        static void drawRotatedQuad(const glm::vec3 &position, const glm::vec2 &size, const Ref<Texture2DArray>& textureArray, uint32_t layer, float rotation, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
+
         // Triangle with color
         static void drawTriangle(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
         static void drawTriangle(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4{1.f});
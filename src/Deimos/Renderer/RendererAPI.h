@@ -18,7 +18,14 @@ namespace Deimos {
         virtual void drawLine(const Ref<VertexArray>& vertexArray, float thickness) = 0;
 
         virtual void init() = 0;
+        // frees what the API keeps between frames, the context is still current
+        virtual void shutdown() = 0;
         virtual void setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+        // blocks until the GPU has executed every command issued so far
+        virtual void finish() = 0;
+
+        virtual uint32_t getMaxTextureSlots() const = 0;
+        virtual bool hasBindlessTextures() const = 0;
 
         inline static API getAPI() { return s_API; }
     private:
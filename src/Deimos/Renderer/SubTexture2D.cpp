@@ -0,0 +1,39 @@
+#include "dmpch.h"
+#include "SubTexture2D.h"
+
+namespace Deimos {
+    SubTexture2D::SubTexture2D(const Ref<Texture2D> &texture, const glm::vec2 &min, const glm::vec2 &max)
+        : m_texture(texture) {
+        m_texCoords[0] = { min.x, min.y };
+        m_texCoords[1] = { max.x, min.y };
+        m_texCoords[2] = { max.x, max.y };
+        m_texCoords[3] = { min.x, max.y };
+    }
+
+    Ref<SubTexture2D> SubTexture2D::createFromCoords(const Ref<Texture2D> &texture, const glm::vec2 &coords, const glm::vec2 &cellSize,
+                                                     const glm::vec2 &spriteSize) {
+        return createFromPixels(texture, coords * cellSize, spriteSize * cellSize);
+    }
+
+    Ref<SubTexture2D> SubTexture2D::createFromPixels(const Ref<Texture2D> &texture, const glm::vec2 &position, const glm::vec2 &size) {
+        glm::vec2 textureSize = { (float) texture->getWidth(), (float) texture->getHeight() };
+        DM_CORE_ASSERT(position.x + size.x <= textureSize.x && position.y + size.y <= textureSize.y, "Sub texture is outside of the texture!");
+
+        return createRef<SubTexture2D>(texture, position / textureSize, (position + size) / textureSize);
+    }
+
+    std::vector<Ref<SubTexture2D>> SubTexture2D::sliceGrid(const Ref<Texture2D> &texture, const glm::vec2 &cellSize) {
+        uint32_t columns = (uint32_t) (texture->getWidth() / cellSize.x);
+        uint32_t rows = (uint32_t) (texture->getHeight() / cellSize.y);
+
+        std::vector<Ref<SubTexture2D>> cells;
+        cells.reserve((size_t) columns * rows);
+        // a sheet that isn't a whole number of cells high has its partial row at the bottom
+        float top = (float) texture->getHeight() - rows * cellSize.y;
+        for (uint32_t row = rows; row-- > 0;) {
+            for (uint32_t column = 0; column < columns; ++column)
+                cells.push_back(createFromPixels(texture, { column * cellSize.x, top + row * cellSize.y }, cellSize));
+        }
+        return cells;
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef ENGINE_SUBTEXTURE2D_H
+#define ENGINE_SUBTEXTURE2D_H
+
+#include "Deimos/Core/Core.h"
+#include "Texture.h"
+
+#include <glm/glm/glm.hpp>
+
+namespace Deimos {
+    // A rectangular region of a texture, min and max are in texture coordinates
+    class SubTexture2D {
+    public:
+        SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max);
+
+        inline const Ref<Texture2D>& getTexture() const { return m_texture; }
+        // bottom left, bottom right, top right, top left
+        inline const glm::vec2* getTexCoords() const { return m_texCoords; }
+
+        // Cell of a sprite sheet laid out on a grid of cellSize pixels. coords count cells from the bottom left
+        // (textures are stored bottom row first), spriteSize in cells lets a sprite span several of them
+        static Ref<SubTexture2D> createFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize,
+                                                  const glm::vec2& spriteSize = { 1.f, 1.f });
+        // position of the bottom left corner and size in pixels
+        static Ref<SubTexture2D> createFromPixels(const Ref<Texture2D>& texture, const glm::vec2& position, const glm::vec2& size);
+        // every whole cell of the sheet in reading order, top row first, e.g. the frames of an animation
+        static std::vector<Ref<SubTexture2D>> sliceGrid(const Ref<Texture2D>& texture, const glm::vec2& cellSize);
+    private:
+        Ref<Texture2D> m_texture;
+        glm::vec2 m_texCoords[4];
+    };
+}
+
+
+#endif //ENGINE_SUBTEXTURE2D_H
@@ -5,25 +5,68 @@
 
 #include "Renderer.h"
 
+#include "TextureLoader.h"
 #include "Platform/OpenGL/OpenGLTexture2D.h"
+#include "Platform/OpenGL/OpenGLTexture2DArray.h"
 
 namespace Deimos {
 
-    Ref<Texture2D> Texture2D::create(uint32_t width, uint32_t height) {
+    Ref<Texture2D> Texture2D::create(uint32_t width, uint32_t height, const TextureSpecification &spec) {
         switch(Renderer::getAPI()) {
             case RendererAPI::API::None: DM_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2D>(width, height);
+            case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2D>(width, height, spec);
         }
         DM_CORE_ASSERT(false, "Unknown RendererAPI!");
         return nullptr;
     }
 
-    Ref <Texture2D> Texture2D::create(const std::string &path) {
+    Ref <Texture2D> Texture2D::create(const std::string &path, const TextureSpecification &spec) {
         switch(Renderer::getAPI()) {
             case RendererAPI::API::None: DM_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2D>(path);
+            case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2D>(path, spec);
         }
         DM_CORE_ASSERT(false, "Unknown RendererAPI!");
         return nullptr;
     }
-}
\ No newline at end of file
+
+    Ref<Texture2D> Texture2D::createAsync(const std::string &path, const TextureSpecification &spec) {
+        Ref<Texture2D> texture;
+        switch(Renderer::getAPI()) {
+            case RendererAPI::API::None: DM_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::OpenGL: texture = std::make_shared<OpenGLTexture2D>(1, 1, spec, false); break;
+        }
+        DM_CORE_ASSERT(texture, "Unknown RendererAPI!");
+
+        uint32_t whiteTextureData = 0xffffffff;
+        texture->setData(&whiteTextureData, sizeof(uint32_t));
+        TextureLoader::load(texture, path);
+        return texture;
+    }
+
+    bool Texture2D::isFormatSupported(TextureFormat format) {
+        switch(Renderer::getAPI()) {
+            case RendererAPI::API::None: DM_ASSERT(false, "RendererAPI::None is currently not supported!"); return false;
+            case RendererAPI::API::OpenGL: return OpenGLTexture2D::isFormatSupported(format);
+        }
+        DM_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return false;
+    }
+
+    Ref<Texture2DArray> Texture2DArray::create(uint32_t width, uint32_t height, uint32_t layers, const TextureSpecification &spec) {
+        switch(Renderer::getAPI()) {
+            case RendererAPI::API::None: DM_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2DArray>(width, height, layers, spec);
+        }
+        DM_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+    Ref<Texture2DArray> Texture2DArray::create(const std::vector<std::string> &paths, const TextureSpecification &spec) {
+        switch(Renderer::getAPI()) {
+            case RendererAPI::API::None: DM_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2DArray>(paths, spec);
+        }
+        DM_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+}
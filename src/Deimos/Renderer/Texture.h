@@ -2,6 +2,39 @@
 #define ENGINE_TEXTURE_H
 
 namespace Deimos {
+    class Image;
+    class CompressedImage;
+
+    enum class TextureFormat {
+        None = 0,
+        RGB8, RGBA8,
+        BC1, BC3, BC7, // desktop block compression, 4x4 texel blocks. BC1 has 1 bit alpha
+        ETC2RGB, ETC2RGBA // mobile block compression, 4x4 texel blocks
+    };
+
+    enum class TextureFilter {
+        Nearest = 0, Linear
+    };
+
+    enum class TextureWrap {
+        Repeat = 0, MirroredRepeat, ClampToEdge
+    };
+
+    // where the lower levels of the mip chain come from
+    enum class MipmapMode {
+        None = 0, GPU, CPU
+    };
+
+    struct TextureSpecification {
+        TextureFilter minFilter = TextureFilter::Linear;
+        TextureFilter magFilter = TextureFilter::Nearest;
+        TextureFilter mipFilter = TextureFilter::Linear; // between levels, linear min and mip filters are trilinear
+        MipmapMode mipmaps = MipmapMode::None;
+        float maxAnisotropy = 1.f; // clamped to what the device supports
+        TextureWrap wrapS = TextureWrap::Repeat;
+        TextureWrap wrapT = TextureWrap::Repeat;
+    };
+
     class Texture {
     public:
         virtual ~Texture() = default;
@@ -14,13 +47,71 @@ namespace Deimos {
 
         virtual void setData(void* data, uint32_t size) = 0;
 
+        // false while an asynchronously loaded texture still shows its placeholder
+        virtual bool isLoaded() const = 0;
+
+        // bytes of video memory held by the storage, all levels and layers
+        virtual size_t getMemorySize() const = 0;
+
+        // resident handle for bindless sampling, 0 if the device can't do it. Once a texture has a handle
+        // its sampler settings are frozen
+        virtual uint64_t getBindlessHandle() const = 0;
+
         virtual bool operator==(const Texture& other) = 0;
     };
 
     class Texture2D : public Texture {
     public:
-        static Ref<Texture2D> create(uint32_t width, uint32_t height);
-        static Ref<Texture2D> create(const std::string& path);
+        // replaces storage and contents, the size and format are taken from the image.
+        // The mip chain is filled as the specification says
+        virtual void setImage(const Image& image) = 0;
+        // same with the lower levels generated beforehand (baked, or on a loader thread), mips[0] is level 1
+        virtual void setMipChain(const Image& image, const std::vector<Image>& mips) = 0;
+        // uploads the levels of a KTX2 / DDS container as they are, without decoding
+        virtual void setCompressedImage(const CompressedImage& image) = 0;
+
+        // Updates a region of level 0, the rest of the texture keeps its contents. data holds width * height pixels in
+        // the format of the texture, rowLength is the pixels per row of data (0 means width), so a region can be sent
+        // straight out of a larger CPU side canvas. The lower levels are regenerated on the GPU
+        virtual void setSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength = 0) = 0;
+        // same, but returns as soon as data is copied to a staging buffer. For contents that change every frame
+        // (canvases, video), the copy never waits for the GPU to finish reading earlier updates
+        virtual void streamSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength = 0) = 0;
+
+        virtual const TextureSpecification& getSpecification() const = 0;
+        // sampler settings apply immediately, a different mipmap mode takes effect with the next setImage
+        virtual void setSpecification(const TextureSpecification& spec) = 0;
+
+        static Ref<Texture2D> create(uint32_t width, uint32_t height, const TextureSpecification& spec = TextureSpecification());
+        // .ktx2 and .dds containers are uploaded block compressed, other files are decoded
+        static Ref<Texture2D> create(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+        // returns immediately with a white placeholder, the image is decoded in the background
+        // and uploaded by TextureLoader::update on the render thread
+        static Ref<Texture2D> createAsync(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+
+        // true if the device samples the format directly. Block compressed formats that the driver would
+        // decompress on upload (ETC2 on most desktop GPUs) report false
+        static bool isFormatSupported(TextureFormat format);
+    };
+
+    // Layers of the same size and format (RGBA8) in one texture object. All the layers of a texture array take a
+    // single texture slot in Renderer2D, the layer is picked per quad
+    class Texture2DArray : public Texture {
+    public:
+        virtual uint32_t getLayerCount() const = 0;
+
+        // width * height RGBA pixels of one layer
+        virtual void setLayerData(uint32_t layer, const void* data, uint32_t size) = 0;
+        // the image must have the size of the array, 3 channel images are expanded
+        virtual void setLayerImage(uint32_t layer, const Image& image) = 0;
+
+        virtual const TextureSpecification& getSpecification() const = 0;
+
+        static Ref<Texture2DArray> create(uint32_t width, uint32_t height, uint32_t layers,
+                                          const TextureSpecification& spec = TextureSpecification());
+        // one layer per file, in order. The images must have the same size
+        static Ref<Texture2DArray> create(const std::vector<std::string>& paths,
+                                          const TextureSpecification& spec = TextureSpecification());
     };
 }
 
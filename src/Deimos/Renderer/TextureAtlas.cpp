@@ -0,0 +1,133 @@
+#include "dmpch.h"
+#include "TextureAtlas.h"
+
+#include <fstream>
+
+namespace Deimos {
+    TextureAtlas::TextureAtlas(const TextureAtlasSpecification &spec)
+        : m_builder(createScope<TextureAtlasBuilder>(spec)), m_pageSize(spec.pageSize) {
+    }
+
+    Ref<SubTexture2D> TextureAtlas::add(const std::string &name, const Image &image) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        DM_CORE_ASSERT(m_builder, "Texture atlas loaded from a file is read only!");
+        if (!m_builder->add(name, image))
+            return get(name);
+
+        syncPages();
+        Ref<SubTexture2D> subTexture = createSubTexture(*m_builder->find(name));
+        m_subTextures[name] = subTexture;
+        return subTexture;
+    }
+
+    Ref<SubTexture2D> TextureAtlas::add(const std::string &name, const std::string &path) {
+        Image image = Image::load(path);
+        if (!image.isValid())
+            return nullptr;
+        return add(name, image);
+    }
+
+    void TextureAtlas::add(const std::vector<TextureAtlasBuilder::Entry> &entries) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        DM_CORE_ASSERT(m_builder, "Texture atlas loaded from a file is read only!");
+        m_builder->add(entries);
+
+        syncPages();
+        for (const auto &entry : entries) {
+            const AtlasRegion *region = m_builder->find(entry.name);
+            if (region && m_subTextures.find(entry.name) == m_subTextures.end())
+                m_subTextures[entry.name] = createSubTexture(*region);
+        }
+    }
+
+    Ref<SubTexture2D> TextureAtlas::get(const std::string &name) const {
+        auto it = m_subTextures.find(name);
+        return it != m_subTextures.end() ? it->second : nullptr;
+    }
+
+    void TextureAtlas::commit() {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        if (!m_builder)
+            return;
+
+        for (uint32_t i = 0; i < m_pages.size(); ++i) {
+            if (!m_builder->isPageDirty(i))
+                continue;
+            const Image &page = m_builder->getPage(i);
+            m_pages[i]->setData((void*) page.getData(), (uint32_t) page.getSize());
+        }
+        m_builder->clearDirty();
+    }
+
+    Ref<TextureAtlas> TextureAtlas::load(const std::string &manifestPath) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        std::ifstream manifest(manifestPath);
+        std::string magic;
+        int version = 0;
+        if (!(manifest >> magic >> version) || magic != "deimos-atlas" || version != 1) {
+            DM_CORE_ERROR("'{0}' is not a texture atlas manifest", manifestPath);
+            return nullptr;
+        }
+
+        std::string directory = manifestPath.substr(0, manifestPath.find_last_of("/\\") + 1);
+
+        std::string keyword;
+        uint32_t pageCount = 0, pageSize = 0;
+        manifest >> keyword >> pageCount >> pageSize;
+        if (keyword != "pages" || pageSize == 0) {
+            DM_CORE_ERROR("Texture atlas manifest '{0}' is corrupted", manifestPath);
+            return nullptr;
+        }
+
+        Ref<TextureAtlas> atlas = createRef<TextureAtlas>();
+        atlas->m_builder.reset();
+        atlas->m_pageSize = pageSize;
+        atlas->m_pages.resize(pageCount);
+
+        while (manifest >> keyword) {
+            if (keyword == "page") {
+                uint32_t index;
+                std::string file;
+                manifest >> index >> file;
+                if (index >= pageCount) {
+                    DM_CORE_ERROR("Texture atlas manifest '{0}' is corrupted", manifestPath);
+                    return nullptr;
+                }
+                atlas->m_pages[index] = Texture2D::create(directory + file);
+            } else if (keyword == "sprite") {
+                AtlasRegion region;
+                std::string name;
+                manifest >> region.page >> region.x >> region.y >> region.width >> region.height >> std::ws;
+                std::getline(manifest, name);
+                if (region.page >= pageCount || !atlas->m_pages[region.page]) {
+                    DM_CORE_ERROR("Texture atlas manifest '{0}' is corrupted", manifestPath);
+                    return nullptr;
+                }
+                atlas->m_subTextures[name] = atlas->createSubTexture(region);
+            } else {
+                DM_CORE_ERROR("Texture atlas manifest '{0}': unknown entry '{1}'", manifestPath, keyword);
+                return nullptr;
+            }
+        }
+
+        return atlas;
+    }
+
+    Ref<SubTexture2D> TextureAtlas::createSubTexture(const AtlasRegion &region) {
+        float size = (float) m_pageSize;
+        glm::vec2 min = { region.x / size, region.y / size };
+        glm::vec2 max = { (region.x + region.width) / size, (region.y + region.height) / size };
+        return createRef<SubTexture2D>(m_pages[region.page], min, max);
+    }
+
+    // textures for the pages the builder opened
+    void TextureAtlas::syncPages() {
+        while (m_pages.size() < m_builder->getPageCount()) {
+            m_pages.push_back(Texture2D::create(m_pageSize, m_pageSize));
+        }
+    }
+}
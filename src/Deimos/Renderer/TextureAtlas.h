@@ -0,0 +1,46 @@
+#ifndef ENGINE_TEXTUREATLAS_H
+#define ENGINE_TEXTUREATLAS_H
+
+#include "Deimos/Core/Core.h"
+#include "TextureAtlasBuilder.h"
+#include "SubTexture2D.h"
+
+namespace Deimos {
+    // Sprites packed into a few large textures, so Renderer2D draws them from the same slots in one batch.
+    // Sprites can be added at runtime, the pages are uploaded in commit()
+    class TextureAtlas {
+    public:
+        TextureAtlas(const TextureAtlasSpecification& spec = TextureAtlasSpecification());
+
+        // the sub texture is valid right away, its pixels show up after the next commit
+        Ref<SubTexture2D> add(const std::string& name, const Image& image);
+        Ref<SubTexture2D> add(const std::string& name, const std::string& path);
+        // packs the batch at once, see TextureAtlasBuilder::add
+        void add(const std::vector<TextureAtlasBuilder::Entry>& entries);
+
+        // nullptr if there is no such sprite
+        Ref<SubTexture2D> get(const std::string& name) const;
+
+        // uploads the pages that changed since the last commit, render thread
+        void commit();
+
+        inline uint32_t getPageCount() const { return (uint32_t) m_pages.size(); }
+        inline const Ref<Texture2D>& getPageTexture(uint32_t index) const { return m_pages[index]; }
+
+        inline const TextureAtlasBuilder& getBuilder() const { return *m_builder; }
+
+        // atlas cooked by the AtlasPacker tool (.atlas manifest and its pages), it is read only
+        static Ref<TextureAtlas> load(const std::string& manifestPath);
+    private:
+        Ref<SubTexture2D> createSubTexture(const AtlasRegion& region);
+        void syncPages();
+    private:
+        Scope<TextureAtlasBuilder> m_builder; // null for loaded atlases
+        uint32_t m_pageSize;
+        std::vector<Ref<Texture2D>> m_pages;
+        std::unordered_map<std::string, Ref<SubTexture2D>> m_subTextures;
+    };
+}
+
+
+#endif //ENGINE_TEXTUREATLAS_H
@@ -0,0 +1,216 @@
+#include "dmpch.h"
+#include "TextureAtlasBuilder.h"
+
+#include <fstream>
+
+// imgui compiles its copy of the packer as static as well, the two don't clash
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+
+namespace Deimos {
+    struct TextureAtlasBuilder::Page {
+        Image image;
+        stbrp_context context;
+        std::vector<stbrp_node> nodes; // one per pixel of width, the packer is optimal with that many
+        bool dirty = true;
+    };
+
+    // writes one sprite pixel into an RGBA page, 1 and 2 channel images are grey (+ alpha)
+    static inline void toRGBA(const uint8_t* src, uint32_t channels, uint8_t* dst) {
+        switch (channels) {
+            case 1: dst[0] = dst[1] = dst[2] = src[0]; dst[3] = 255; break;
+            case 2: dst[0] = dst[1] = dst[2] = src[0]; dst[3] = src[1]; break;
+            case 3: dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = 255; break;
+            default: memcpy(dst, src, 4); break;
+        }
+    }
+
+    TextureAtlasBuilder::TextureAtlasBuilder(const TextureAtlasSpecification &spec)
+        : m_specification(spec) {
+    }
+
+    TextureAtlasBuilder::~TextureAtlasBuilder() = default;
+
+    bool TextureAtlasBuilder::add(const std::string &name, const Image &image) {
+        return add(std::vector<Entry>{ { name, &image } }) == 1;
+    }
+
+    uint32_t TextureAtlasBuilder::add(const std::vector<Entry> &entries) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        const uint32_t padding = m_specification.padding;
+        const uint32_t pageSize = m_specification.pageSize;
+
+        std::vector<stbrp_rect> rects;
+        rects.reserve(entries.size());
+        for (uint32_t i = 0; i < entries.size(); ++i) {
+            const Entry &entry = entries[i];
+            if (!entry.image || !entry.image->isValid()) {
+                DM_CORE_WARN("Texture atlas: sprite '{0}' has no pixels, skipped", entry.name);
+                continue;
+            }
+            if (m_regions.find(entry.name) != m_regions.end()) {
+                DM_CORE_WARN("Texture atlas: sprite '{0}' is already packed, skipped", entry.name);
+                continue;
+            }
+
+            uint32_t width = entry.image->getWidth() + padding * 2;
+            uint32_t height = entry.image->getHeight() + padding * 2;
+            if (width > pageSize || height > pageSize) {
+                DM_CORE_ERROR("Texture atlas: sprite '{0}' ({1}x{2}) doesn't fit into a {3}x{3} page",
+                              entry.name, entry.image->getWidth(), entry.image->getHeight(), pageSize);
+                continue;
+            }
+
+            stbrp_rect rect{};
+            rect.id = (int) i;
+            rect.w = (stbrp_coord) width;
+            rect.h = (stbrp_coord) height;
+            rects.push_back(rect);
+        }
+
+        uint32_t placed = 0;
+        uint32_t pageIndex = 0;
+        while (!rects.empty()) {
+            bool freshPage = pageIndex == m_pages.size();
+            Page &page = freshPage ? addPage() : *m_pages[pageIndex];
+
+            stbrp_pack_rects(&page.context, rects.data(), (int) rects.size());
+
+            std::vector<stbrp_rect> remaining;
+            for (const stbrp_rect &rect : rects) {
+                if (!rect.was_packed) {
+                    remaining.push_back(rect);
+                    continue;
+                }
+
+                const Entry &entry = entries[rect.id];
+                AtlasRegion region;
+                region.page = pageIndex;
+                region.x = rect.x + padding;
+                region.y = rect.y + padding;
+                region.width = entry.image->getWidth();
+                region.height = entry.image->getHeight();
+
+                blit(page, region, *entry.image);
+                m_regions[entry.name] = region;
+                ++placed;
+            }
+
+            // every rect fits into an empty page, so a fresh page always takes at least one
+            DM_CORE_ASSERT(!freshPage || remaining.size() < rects.size(), "Texture atlas: an empty page rejected every sprite!");
+            rects = std::move(remaining);
+            ++pageIndex;
+        }
+
+        return placed;
+    }
+
+    const AtlasRegion *TextureAtlasBuilder::find(const std::string &name) const {
+        auto it = m_regions.find(name);
+        return it != m_regions.end() ? &it->second : nullptr;
+    }
+
+    uint32_t TextureAtlasBuilder::getPageCount() const {
+        return (uint32_t) m_pages.size();
+    }
+
+    const Image &TextureAtlasBuilder::getPage(uint32_t index) const {
+        DM_CORE_ASSERT(index < m_pages.size(), "Texture atlas page index out of range!");
+        return m_pages[index]->image;
+    }
+
+    bool TextureAtlasBuilder::isPageDirty(uint32_t index) const {
+        DM_CORE_ASSERT(index < m_pages.size(), "Texture atlas page index out of range!");
+        return m_pages[index]->dirty;
+    }
+
+    void TextureAtlasBuilder::clearDirty() {
+        for (auto &page : m_pages) {
+            page->dirty = false;
+        }
+    }
+
+    bool TextureAtlasBuilder::save(const std::string &basePath) const {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        std::ofstream manifest(basePath + ".atlas");
+        if (!manifest) {
+            DM_CORE_ERROR("Texture atlas: could not open '{0}.atlas' for writing", basePath);
+            return false;
+        }
+
+        // page files are referenced relative to the manifest
+        std::string baseName = basePath.substr(basePath.find_last_of("/\\") + 1);
+
+        manifest << "deimos-atlas 1\n";
+        manifest << "pages " << m_pages.size() << ' ' << m_specification.pageSize << '\n';
+        for (uint32_t i = 0; i < m_pages.size(); ++i) {
+            std::string file = baseName + "_" + std::to_string(i) + ".tga";
+            if (!m_pages[i]->image.writeTGA(basePath + "_" + std::to_string(i) + ".tga"))
+                return false;
+            manifest << "page " << i << ' ' << file << '\n';
+        }
+        for (const auto &[name, region] : m_regions) {
+            // the name goes last, it is the rest of the line and may contain spaces
+            manifest << "sprite " << region.page << ' ' << region.x << ' ' << region.y << ' '
+                     << region.width << ' ' << region.height << ' ' << name << '\n';
+        }
+
+        return (bool) manifest;
+    }
+
+    TextureAtlasBuilder::Page &TextureAtlasBuilder::addPage() {
+        const uint32_t pageSize = m_specification.pageSize;
+
+        auto page = createScope<Page>();
+        page->image = Image(pageSize, pageSize, 4);
+        memset(page->image.getData(), 0, page->image.getSize());
+        page->nodes.resize(pageSize);
+        stbrp_init_target(&page->context, (int) pageSize, (int) pageSize, page->nodes.data(), (int) page->nodes.size());
+
+        m_pages.push_back(std::move(page));
+        return *m_pages.back();
+    }
+
+    void TextureAtlasBuilder::blit(Page &page, const AtlasRegion &region, const Image &image) {
+        const uint32_t pageSize = m_specification.pageSize;
+        const uint32_t channels = image.getChannels();
+        uint8_t *pixels = page.image.getData();
+
+        for (uint32_t y = 0; y < region.height; ++y) {
+            const uint8_t *src = image.getData() + (size_t) y * region.width * channels;
+            uint8_t *dst = pixels + ((size_t) (region.y + y) * pageSize + region.x) * 4;
+            if (channels == 4) {
+                memcpy(dst, src, (size_t) region.width * 4);
+                continue;
+            }
+            for (uint32_t x = 0; x < region.width; ++x) {
+                toRGBA(src + x * channels, channels, dst + x * 4);
+            }
+        }
+
+        uint32_t padding = m_specification.padding;
+        if (m_specification.bleed && padding > 0) {
+            // left and right edges first, then whole padded rows up and down, which fills the corners too
+            for (uint32_t y = 0; y < region.height; ++y) {
+                uint8_t *row = pixels + ((size_t) (region.y + y) * pageSize + region.x) * 4;
+                for (uint32_t p = 1; p <= padding; ++p) {
+                    memcpy(row - p * 4, row, 4);
+                    memcpy(row + (region.width - 1 + p) * 4, row + (region.width - 1) * 4, 4);
+                }
+            }
+
+            size_t rowBytes = (size_t) (region.width + padding * 2) * 4;
+            uint8_t *bottom = pixels + ((size_t) region.y * pageSize + region.x - padding) * 4;
+            uint8_t *top = pixels + ((size_t) (region.y + region.height - 1) * pageSize + region.x - padding) * 4;
+            for (uint32_t p = 1; p <= padding; ++p) {
+                memcpy(bottom - (size_t) p * pageSize * 4, bottom, rowBytes);
+                memcpy(top + (size_t) p * pageSize * 4, top, rowBytes);
+            }
+        }
+
+        page.dirty = true;
+    }
+}
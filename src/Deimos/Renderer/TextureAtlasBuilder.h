@@ -0,0 +1,69 @@
+#ifndef ENGINE_TEXTUREATLASBUILDER_H
+#define ENGINE_TEXTUREATLASBUILDER_H
+
+#include "Deimos/Core/Core.h"
+#include "Image.h"
+
+namespace Deimos {
+    struct TextureAtlasSpecification {
+        uint32_t pageSize = 2048; // pages are square RGBA images
+        uint32_t padding = 2; // empty pixels kept around every sprite
+        bool bleed = true; // extrude the sprite edges into the padding, so linear filtering doesn't sample the neighbours
+    };
+
+    // pixel rectangle of a sprite inside its page, the origin is the bottom left corner (GL convention)
+    struct AtlasRegion {
+        uint32_t page = 0;
+        uint32_t x = 0, y = 0, width = 0, height = 0;
+    };
+
+    // Packs images into atlas pages on the CPU, doesn't touch GL so it can run in offline tools.
+    // Every page keeps its skyline, sprites can be added incrementally, a new page is opened when the others are full
+    class TextureAtlasBuilder {
+    public:
+        struct Entry {
+            std::string name;
+            const Image* image;
+        };
+
+        TextureAtlasBuilder(const TextureAtlasSpecification& spec = TextureAtlasSpecification());
+        ~TextureAtlasBuilder();
+
+        TextureAtlasBuilder(const TextureAtlasBuilder&) = delete;
+        TextureAtlasBuilder& operator=(const TextureAtlasBuilder&) = delete;
+
+        // false if the sprite is larger than a page or the name is taken
+        bool add(const std::string& name, const Image& image);
+        // packs the whole batch at once (sorted by height), fills the pages better than adding one by one.
+        // returns the number of sprites placed
+        uint32_t add(const std::vector<Entry>& entries);
+
+        // nullptr if there is no such sprite
+        const AtlasRegion* find(const std::string& name) const;
+        inline const std::unordered_map<std::string, AtlasRegion>& getRegions() const { return m_regions; }
+
+        uint32_t getPageCount() const;
+        const Image& getPage(uint32_t index) const;
+
+        // pages modified since the last clearDirty
+        bool isPageDirty(uint32_t index) const;
+        void clearDirty();
+
+        inline const TextureAtlasSpecification& getSpecification() const { return m_specification; }
+
+        // writes <basePath>_<page>.tga for every page and the <basePath>.atlas manifest
+        bool save(const std::string& basePath) const;
+    private:
+        struct Page;
+
+        Page& addPage();
+        void blit(Page& page, const AtlasRegion& region, const Image& image);
+    private:
+        TextureAtlasSpecification m_specification;
+        std::vector<Scope<Page>> m_pages; // the packer contexts point into themselves, pages must not move
+        std::unordered_map<std::string, AtlasRegion> m_regions;
+    };
+}
+
+
+#endif //ENGINE_TEXTUREATLASBUILDER_H
@@ -0,0 +1,240 @@
+#include "dmpch.h"
+#include "TextureCache.h"
+
+#include "Image.h"
+#include "CompressedImage.h"
+#include "Deimos/Core/Hash.h"
+
+#include <fstream>
+#include <list>
+
+namespace Deimos {
+    struct CachedTexture {
+        std::string path; // a file with the contents, to reload from after eviction
+        TextureSpecification spec;
+        size_t fileSize = 0;
+        Ref<Texture2D> texture; // null while evicted
+        size_t size = 0;
+        std::list<uint64_t>::iterator lruPosition;
+    };
+
+    struct CachedPath {
+        std::string path;
+        uint64_t contentKey;
+    };
+
+    struct TextureCacheData {
+        // by content and specification, colliding contents take the next free key
+        std::unordered_map<uint64_t, CachedTexture> textures;
+        // by path and specification to the content key, colliding paths take the next free key
+        std::unordered_map<uint64_t, CachedPath> paths;
+        std::list<uint64_t> lru; // resident textures, least recently requested first
+        size_t budget = 0;
+        TextureCacheStats stats;
+    };
+
+    static TextureCacheData s_cacheData;
+
+    // textures with the same contents but different sampling are separate entries
+    static uint64_t hashSpecification(const TextureSpecification &spec, uint64_t hash) {
+        uint32_t fields[] = { (uint32_t) spec.minFilter, (uint32_t) spec.magFilter, (uint32_t) spec.mipFilter,
+                              (uint32_t) spec.mipmaps, (uint32_t) spec.wrapS, (uint32_t) spec.wrapT };
+        hash = fnv1a(fields, sizeof(fields), hash);
+        return fnv1a(&spec.maxAnisotropy, sizeof(float), hash);
+    }
+
+    static bool readFile(const std::string &path, std::vector<uint8_t> &bytes) {
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (!in)
+            return false;
+
+        in.seekg(0, std::ios::end);
+        bytes.resize((size_t) in.tellg());
+        in.seekg(0, std::ios::beg);
+        in.read((char*) bytes.data(), (std::streamsize) bytes.size());
+        return (bool) in;
+    }
+
+    static bool isSameSpecification(const TextureSpecification &a, const TextureSpecification &b) {
+        return a.minFilter == b.minFilter && a.magFilter == b.magFilter && a.mipFilter == b.mipFilter &&
+               a.mipmaps == b.mipmaps && a.maxAnisotropy == b.maxAnisotropy && a.wrapS == b.wrapS && a.wrapT == b.wrapT;
+    }
+
+    // the key of the entry holding these bytes, or the free key they go to. Hashes are only a hint, a file
+    // under another path is compared byte by byte
+    static uint64_t findContent(uint64_t contentKey, const std::string &path, const std::vector<uint8_t> &bytes,
+                                const TextureSpecification &spec) {
+        for (auto it = s_cacheData.textures.find(contentKey); it != s_cacheData.textures.end();
+             it = s_cacheData.textures.find(++contentKey)) {
+            const CachedTexture &entry = it->second;
+            if (entry.fileSize != bytes.size() || !isSameSpecification(entry.spec, spec))
+                continue;
+
+            std::vector<uint8_t> cached;
+            if (entry.path == path || (readFile(entry.path, cached) && cached == bytes))
+                return contentKey;
+        }
+        return contentKey;
+    }
+
+    // the key of the entry for this path, or the free key it goes to
+    static uint64_t findPath(uint64_t pathKey, const std::string &path, const TextureSpecification &spec) {
+        for (auto it = s_cacheData.paths.find(pathKey); it != s_cacheData.paths.end();
+             it = s_cacheData.paths.find(++pathKey)) {
+            if (it->second.path != path)
+                continue;
+
+            auto content = s_cacheData.textures.find(it->second.contentKey);
+            if (content != s_cacheData.textures.end() && isSameSpecification(content->second.spec, spec))
+                return pathKey;
+        }
+        return pathKey;
+    }
+
+    static Ref<Texture2D> createTexture(const std::string &path, const std::vector<uint8_t> &bytes, const TextureSpecification &spec) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        Ref<Texture2D> texture = Texture2D::create(1, 1, spec);
+        if (CompressedImage::isContainer(path)) {
+            CompressedImage image = CompressedImage::loadFromMemory(bytes.data(), bytes.size(), path);
+            if (!image.isValid())
+                return nullptr;
+            texture->setCompressedImage(image);
+        } else {
+            ImageLoadOptions options;
+            options.expandToRGBA = true;
+            Image image = Image::loadFromMemory(bytes.data(), bytes.size(), options, path);
+            if (!image.isValid())
+                return nullptr;
+            texture->setImage(image);
+        }
+        return texture;
+    }
+
+    static void makeResident(uint64_t key, CachedTexture &entry, Ref<Texture2D> texture) {
+        entry.texture = std::move(texture);
+        entry.size = entry.texture->getMemorySize();
+        entry.lruPosition = s_cacheData.lru.insert(s_cacheData.lru.end(), key);
+
+        s_cacheData.stats.residentTextures++;
+        s_cacheData.stats.residentBytes += entry.size;
+    }
+
+    static void touch(CachedTexture &entry) {
+        s_cacheData.lru.splice(s_cacheData.lru.end(), s_cacheData.lru, entry.lruPosition);
+    }
+
+    Ref<Texture2D> TextureCache::get(const std::string &path, const TextureSpecification &spec) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        uint64_t pathKey = findPath(hashSpecification(spec, fnv1a(path)), path, spec);
+        auto pathIt = s_cacheData.paths.find(pathKey);
+        if (pathIt != s_cacheData.paths.end()) {
+            uint64_t contentKey = pathIt->second.contentKey;
+            CachedTexture &entry = s_cacheData.textures[contentKey];
+            if (entry.texture) {
+                s_cacheData.stats.hits++;
+                touch(entry);
+                return entry.texture;
+            }
+
+            std::vector<uint8_t> bytes;
+            Ref<Texture2D> texture = readFile(entry.path, bytes) ? createTexture(entry.path, bytes, spec) : nullptr;
+            if (!texture) {
+                DM_CORE_ERROR("TextureCache: failed to reload '{0}'", entry.path);
+                return nullptr;
+            }
+
+            s_cacheData.stats.reloads++;
+            makeResident(contentKey, entry, std::move(texture));
+            Ref<Texture2D> result = entry.texture; // trim can't evict it while referenced here
+            trim();
+            return result;
+        }
+
+        std::vector<uint8_t> bytes;
+        if (!readFile(path, bytes)) {
+            DM_CORE_ERROR("TextureCache: failed to read '{0}'", path);
+            return nullptr;
+        }
+
+        size_t fileSize = bytes.size();
+        uint64_t contentKey = hashSpecification(spec, fnv1a(&fileSize, sizeof(fileSize), fnv1a(bytes.data(), bytes.size())));
+        contentKey = findContent(contentKey, path, bytes, spec);
+        s_cacheData.paths[pathKey] = { path, contentKey };
+
+        auto it = s_cacheData.textures.find(contentKey);
+        if (it != s_cacheData.textures.end() && it->second.texture) {
+            s_cacheData.stats.hits++; // same file under another name
+            touch(it->second);
+            return it->second.texture;
+        }
+
+        Ref<Texture2D> texture = createTexture(path, bytes, spec);
+        if (!texture) {
+            s_cacheData.paths.erase(pathKey);
+            return nullptr;
+        }
+
+        s_cacheData.stats.misses++;
+        CachedTexture &entry = s_cacheData.textures[contentKey];
+        if (entry.path.empty()) {
+            entry.path = path;
+            entry.spec = spec;
+            entry.fileSize = fileSize;
+            s_cacheData.stats.textures++;
+        }
+        makeResident(contentKey, entry, texture);
+        trim();
+        return texture;
+    }
+
+    void TextureCache::setBudget(size_t bytes) {
+        s_cacheData.budget = bytes;
+        trim();
+    }
+
+    size_t TextureCache::getBudget() {
+        return s_cacheData.budget;
+    }
+
+    void TextureCache::trim() {
+        DM_PROFILE_CATEGORY_COUNTER(Assets, "Textures resident", s_cacheData.stats.residentTextures);
+        DM_PROFILE_CATEGORY_COUNTER(Assets, "Texture bytes resident", s_cacheData.stats.residentBytes);
+
+        if (!s_cacheData.budget || s_cacheData.stats.residentBytes <= s_cacheData.budget)
+            return;
+
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        for (auto it = s_cacheData.lru.begin(); it != s_cacheData.lru.end() && s_cacheData.stats.residentBytes > s_cacheData.budget;) {
+            CachedTexture &entry = s_cacheData.textures[*it];
+            if (entry.texture.use_count() > 1) { // still drawn somewhere
+                ++it;
+                continue;
+            }
+
+            s_cacheData.stats.residentTextures--;
+            s_cacheData.stats.residentBytes -= entry.size;
+            s_cacheData.stats.evictions++;
+            entry.texture.reset();
+            entry.size = 0;
+            it = s_cacheData.lru.erase(it);
+        }
+    }
+
+    void TextureCache::clear() {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        s_cacheData.textures.clear();
+        s_cacheData.paths.clear();
+        s_cacheData.lru.clear();
+        s_cacheData.stats.textures = 0;
+        s_cacheData.stats.residentTextures = 0;
+        s_cacheData.stats.residentBytes = 0;
+    }
+
+    const TextureCacheStats &TextureCache::getStats() {
+        return s_cacheData.stats;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef ENGINE_TEXTURECACHE_H
+#define ENGINE_TEXTURECACHE_H
+
+#include "Texture.h"
+
+namespace Deimos {
+    struct TextureCacheStats {
+        uint32_t textures = 0; // distinct contents known to the cache, resident or not
+        uint32_t residentTextures = 0;
+        size_t residentBytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t reloads = 0;
+    };
+
+    // Shares textures loaded from files. Requests are deduplicated by path and by content, so two files with
+    // the same bytes end up as one texture. Over the memory budget the least recently requested textures
+    // nobody else holds a reference to are released, they are loaded again when requested next time.
+    // Render thread only
+    class TextureCache {
+    public:
+        static Ref<Texture2D> get(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+
+        // bytes of video memory the cached textures may use, 0 is unlimited
+        static void setBudget(size_t bytes);
+        static size_t getBudget();
+
+        // evicts until the budget is met or every resident texture is referenced, runs once per frame
+        static void trim();
+        // forgets every texture, ones still referenced elsewhere live on through their owners
+        static void clear();
+
+        static const TextureCacheStats& getStats();
+    };
+}
+
+
+#endif //ENGINE_TEXTURECACHE_H
@@ -0,0 +1,153 @@
+#include "dmpch.h"
+#include "TextureLoader.h"
+
+#include "Image.h"
+#include "CompressedImage.h"
+#include "MipmapGenerator.h"
+#include "UploadQueue.h"
+#include "Deimos/Core/ThreadPool.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Deimos {
+    // uploads are spread over frames, so finishing a whole level at once doesn't cause a hitch
+    static const uint32_t s_maxUploadsPerFrame = 8;
+
+    struct DecodedTexture {
+        std::weak_ptr<Texture2D> texture; // dropped if nobody holds the texture by the time it is decoded
+        std::string path;
+        Image image;
+        std::vector<Image> mips; // empty unless the texture wants a mip chain generated on the CPU
+        CompressedImage compressed; // KTX2 / DDS files skip decoding, image is empty then
+    };
+
+    struct TextureLoaderData {
+        Scope<ThreadPool> pool;
+
+        std::mutex decodedMutex;
+        std::deque<DecodedTexture> decoded;
+
+        // handed to the UploadQueue, still pending until the copy is swapped in. Render thread only
+        std::vector<std::weak_ptr<Texture2D>> uploading;
+
+        std::atomic<uint32_t> pendingCount{ 0 };
+    };
+
+    static TextureLoaderData s_loaderData;
+
+    void TextureLoader::init(uint32_t threadCount) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        s_loaderData.pool = createScope<ThreadPool>(threadCount);
+    }
+
+    void TextureLoader::shutdown() {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        s_loaderData.pool.reset(); // joins the workers
+        s_loaderData.decoded.clear();
+        s_loaderData.uploading.clear();
+        s_loaderData.pendingCount = 0;
+    }
+
+    void TextureLoader::load(const Ref<Texture2D> &texture, const std::string &path) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        DM_CORE_ASSERT(s_loaderData.pool, "TextureLoader is not initialized!");
+        ++s_loaderData.pendingCount;
+
+        std::weak_ptr<Texture2D> target = texture;
+        bool cpuMipmaps = texture->getSpecification().mipmaps == MipmapMode::CPU;
+        s_loaderData.pool->submit([target, path, cpuMipmaps]() {
+            // the trace is written later, the name has to stay alive until then. Interned names are never freed,
+            // so only while the scope is actually recorded. Built inside the macro, it compiles out with it
+            DM_PROFILE_CATEGORY_SCOPE(Assets, Instrumentor::get().isCategoryActive(ProfileCategory::Assets)
+                                              ? Instrumentor::get().internName("Decode " + path) : "Decode texture");
+
+            if (target.expired()) {
+                --s_loaderData.pendingCount;
+                return;
+            }
+
+            if (CompressedImage::isContainer(path)) {
+                CompressedImage compressed = CompressedImage::load(path);
+                if (!compressed.isValid()) {
+                    --s_loaderData.pendingCount;
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(s_loaderData.decodedMutex);
+                s_loaderData.decoded.push_back({ target, path, Image(), {}, std::move(compressed) });
+                return;
+            }
+
+            ImageLoadOptions options;
+            options.expandToRGBA = true;
+            Image image = Image::load(path, options);
+            if (!image.isValid()) {
+                --s_loaderData.pendingCount; // keeps the placeholder
+                return;
+            }
+
+            // the mips are built here as well, the render thread only copies
+            std::vector<Image> mips;
+            if (cpuMipmaps)
+                mips = MipmapGenerator::generate(image);
+
+            std::lock_guard<std::mutex> lock(s_loaderData.decodedMutex);
+            s_loaderData.decoded.push_back({ target, path, std::move(image), std::move(mips), CompressedImage() });
+        });
+    }
+
+    void TextureLoader::update() {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        std::deque<DecodedTexture> ready;
+        {
+            std::lock_guard<std::mutex> lock(s_loaderData.decodedMutex);
+            // the upload thread takes everything, the copy doesn't happen on this thread then
+            uint32_t count = UploadQueue::isRunning() ? (uint32_t) s_loaderData.decoded.size()
+                                                      : std::min<uint32_t>(s_maxUploadsPerFrame, (uint32_t) s_loaderData.decoded.size());
+            for (uint32_t i = 0; i < count; ++i) {
+                ready.push_back(std::move(s_loaderData.decoded.front()));
+                s_loaderData.decoded.pop_front();
+            }
+        }
+
+        for (DecodedTexture &decoded : ready) {
+            Ref<Texture2D> texture = decoded.texture.lock();
+            // compressed levels are already in their GPU layout, the copy is cheap enough for this thread
+            if (texture && decoded.compressed.isValid()) {
+                texture->setCompressedImage(decoded.compressed);
+            } else if (texture && UploadQueue::isRunning()) {
+                UploadQueue::uploadTexture(texture, std::move(decoded.image), std::move(decoded.mips));
+                s_loaderData.uploading.push_back(texture);
+                continue;
+            } else if (texture && !decoded.mips.empty()) {
+                texture->setMipChain(decoded.image, decoded.mips);
+            } else if (texture) {
+                texture->setImage(decoded.image);
+            }
+            --s_loaderData.pendingCount;
+        }
+
+        // the UploadQueue marks a texture loaded once its copy has finished on the GPU
+        auto it = s_loaderData.uploading.begin();
+        while (it != s_loaderData.uploading.end()) {
+            Ref<Texture2D> texture = it->lock();
+            if (texture && !texture->isLoaded()) {
+                ++it;
+                continue;
+            }
+            --s_loaderData.pendingCount;
+            it = s_loaderData.uploading.erase(it);
+        }
+
+        DM_PROFILE_CATEGORY_COUNTER(Assets, "Textures pending", s_loaderData.pendingCount.load());
+    }
+
+    uint32_t TextureLoader::getPendingCount() {
+        return s_loaderData.pendingCount;
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef ENGINE_TEXTURELOADER_H
+#define ENGINE_TEXTURELOADER_H
+
+#include "Texture.h"
+
+namespace Deimos {
+    // Decodes images on a small worker pool, the GL upload happens on the render thread in update(). Mip chains
+    // built on the CPU are split over the job system
+    class TextureLoader {
+    public:
+        static void init(uint32_t threadCount = 0);
+        static void shutdown();
+
+        // texture keeps its current contents until the decoded image is uploaded
+        static void load(const Ref<Texture2D>& texture, const std::string& path);
+
+        // render thread, once per frame
+        static void update();
+
+        // textures that are queued, decoding or waiting for upload
+        static uint32_t getPendingCount();
+    };
+}
+
+
+#endif //ENGINE_TEXTURELOADER_H
@@ -0,0 +1,25 @@
+#include "dmpch.h"
+#include "UploadQueue.h"
+
+#include "Renderer.h"
+#include "Platform/OpenGL/OpenGLUploadQueue.h"
+
+namespace Deimos {
+    Scope<UploadQueue> UploadQueue::s_instance;
+
+    void UploadQueue::init(GraphicsContext &context) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None: DM_ASSERT(false, "Deimos currently does not support RendererAPI::None!"); return;
+            case RendererAPI::API::OpenGL: s_instance = createScope<OpenGLUploadQueue>(context.createSharedContext()); return;
+        }
+        DM_ASSERT(false, "Unknown RendererAPI!");
+    }
+
+    void UploadQueue::shutdown() {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        s_instance.reset();
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef ENGINE_UPLOADQUEUE_H
+#define ENGINE_UPLOADQUEUE_H
+
+#include "Texture.h"
+#include "Buffer.h"
+#include "Image.h"
+#include "GraphicsContext.h"
+
+namespace Deimos {
+    // Copies texture and buffer data to the GPU on a separate thread with its own context that shares objects
+    // with the main one. Every upload is published with a fence, the frame thread only waits on it if it uses
+    // the resource before the copy is done.
+    class UploadQueue {
+    public:
+        virtual ~UploadQueue() = default;
+
+        // main thread, the context is the one of the window
+        static void init(GraphicsContext& context);
+        static void shutdown();
+
+        inline static bool isRunning() { return (bool) s_instance; }
+
+        // replaces storage and contents like Texture2D::setImage (setMipChain when mips are given), the texture
+        // keeps showing its previous contents until the copy has finished on the GPU
+        inline static void uploadTexture(const Ref<Texture2D>& texture, Image image, std::vector<Image> mips = {}) {
+            s_instance->uploadTextureImpl(texture, std::move(image), std::move(mips));
+        }
+
+        // data is copied, the buffer must be large enough to hold offset + size bytes
+        inline static void uploadBuffer(const Ref<VertexBuffer>& buffer, const void* data, uint32_t size, uint32_t offset = 0) {
+            s_instance->uploadBufferImpl(buffer, data, size, offset);
+        }
+
+        // render thread, once per frame, swaps in textures whose copies have finished
+        inline static void update() { if (s_instance) s_instance->updateImpl(); }
+    protected:
+        virtual void uploadTextureImpl(const Ref<Texture2D>& texture, Image image, std::vector<Image> mips) = 0;
+        virtual void uploadBufferImpl(const Ref<VertexBuffer>& buffer, const void* data, uint32_t size, uint32_t offset) = 0;
+        virtual void updateImpl() = 0;
+    private:
+        static Scope<UploadQueue> s_instance;
+    };
+}
+
+
+#endif //ENGINE_UPLOADQUEUE_H
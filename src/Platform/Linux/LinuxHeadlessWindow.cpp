@@ -0,0 +1,34 @@
+#ifdef DM_PLATFORM_LINUX
+
+#include "dmpch.h"
+#include "LinuxHeadlessWindow.h"
+
+namespace Deimos {
+    LinuxHeadlessWindow::LinuxHeadlessWindow(const WindowProps &props)
+        : m_title(props.title), m_width(props.width), m_height(props.height) {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        DM_CORE_INFO("Creating headless window {0} ({1}, {2})", props.title, props.width, props.height);
+
+        m_context = createScope<OpenGLHeadlessContext>(m_width, m_height);
+        m_context->init();
+    }
+
+    LinuxHeadlessWindow::~LinuxHeadlessWindow() {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+    }
+
+    void LinuxHeadlessWindow::onUpdate() {
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
+
+        m_context->swapBuffers();
+    }
+
+    void LinuxHeadlessWindow::setVSync(bool enabled) {
+        if (enabled) {
+            DM_CORE_WARN("VSync is not available for a headless window");
+        }
+    }
+}
+
+#endif
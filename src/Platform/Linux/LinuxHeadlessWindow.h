@@ -0,0 +1,38 @@
+#ifndef ENGINE_LINUXHEADLESSWINDOW_H
+#define ENGINE_LINUXHEADLESSWINDOW_H
+
+#include "Deimos/Core/Window.h"
+#include "Platform/OpenGL/OpenGLHeadlessContext.h"
+
+namespace Deimos {
+
+    // Window without a display: no events, no presentation and no vsync, so the run loop is uncapped
+    class LinuxHeadlessWindow : public Window {
+    public:
+        LinuxHeadlessWindow(const WindowProps& props);
+        virtual ~LinuxHeadlessWindow();
+
+        void onUpdate() override;
+
+        inline unsigned int getWidth() const override { return m_width; }
+        inline unsigned int getHeight() const override { return m_height; }
+        inline void* getNativeWindow() const override { return nullptr; }
+
+        inline void setEventCallback(const eventCallbackFn &callback) override { m_eventCallback = callback; }
+
+        void setVSync(bool enabled) override;
+        bool isVSync() const override { return false; }
+
+        inline GraphicsContext& getContext() override { return *m_context; }
+        inline OpenGLHeadlessContext& getHeadlessContext() { return *m_context; }
+    private:
+        std::string m_title;
+        unsigned int m_width, m_height;
+        eventCallbackFn m_eventCallback;
+
+        Scope<OpenGLHeadlessContext> m_context;
+    };
+}
+
+
+#endif //ENGINE_LINUXHEADLESSWINDOW_H
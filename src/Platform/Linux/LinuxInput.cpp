@@ -11,18 +11,24 @@ namespace Deimos {
 
     bool LinuxInput::isKeyPressedImpl(int keycode) {
         auto window = static_cast<GLFWwindow*>(Application::get().getWindow().getNativeWindow());
+        if (!window) // headless
+            return false;
         auto state = glfwGetKey(window, keycode);
         return state == GLFW_PRESS || state == GLFW_REPEAT;
     }
 
     bool LinuxInput::isMouseButtonPressedImpl(int button) {
         auto window = static_cast<GLFWwindow*>(Application::get().getWindow().getNativeWindow());
+        if (!window)
+            return false;
         auto state = glfwGetMouseButton(window, button);
         return state == GLFW_PRESS;
     }
 
     std::pair<float, float> LinuxInput::getMousePositionImpl() {
         auto window = static_cast<GLFWwindow*>(Application::get().getWindow().getNativeWindow());
+        if (!window)
+            return { 0.f, 0.f };
         double x, y;
         glfwGetCursorPos(window, &x, &y);
 
@@ -0,0 +1,47 @@
+#ifdef DM_PLATFORM_LINUX
+#include "dmpch.h"
+#include "LinuxMappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Deimos {
+    Scope<MappedFile> MappedFile::open(const std::string &path) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            DM_CORE_ERROR("Could not open '{0}': {1}", path, strerror(errno));
+            return nullptr;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            DM_CORE_ERROR("Could not map '{0}': empty or unreadable", path);
+            close(fd);
+            return nullptr;
+        }
+
+        void *data = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping keeps the file referenced
+        if (data == MAP_FAILED) {
+            DM_CORE_ERROR("Could not map '{0}': {1}", path, strerror(errno));
+            return nullptr;
+        }
+
+        // assets are read front to back during loading
+        madvise(data, (size_t) st.st_size, MADV_WILLNEED);
+        return createScope<LinuxMappedFile>(data, (size_t) st.st_size);
+    }
+
+    LinuxMappedFile::LinuxMappedFile(void *data, size_t size) : m_data(data), m_size(size) {
+    }
+
+    LinuxMappedFile::~LinuxMappedFile() {
+        munmap(m_data, m_size);
+    }
+}
+
+#endif
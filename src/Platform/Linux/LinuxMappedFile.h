@@ -0,0 +1,21 @@
+#ifndef ENGINE_LINUXMAPPEDFILE_H
+#define ENGINE_LINUXMAPPEDFILE_H
+
+#include "Deimos/Core/MappedFile.h"
+
+namespace Deimos {
+    class LinuxMappedFile : public MappedFile {
+    public:
+        LinuxMappedFile(void* data, size_t size);
+        virtual ~LinuxMappedFile() override;
+
+        virtual const uint8_t* getData() const override { return (const uint8_t*) m_data; }
+        virtual size_t getSize() const override { return m_size; }
+    private:
+        void* m_data;
+        size_t m_size;
+    };
+}
+
+
+#endif //ENGINE_LINUXMAPPEDFILE_H
@@ -10,6 +10,7 @@
 #include "spdlog/details/fmt_helper.h"
 
 #include "Platform/OpenGL/OpenGLContext.h"
+#include "LinuxHeadlessWindow.h"
 
 namespace Deimos {
     // static because should only be inited once no matter how many windows
@@ -20,23 +21,29 @@ namespace Deimos {
     }
 
     Window *Window::create(const WindowProps &props) {
+        if (props.headless)
+            return new LinuxHeadlessWindow(props);
         return new LinuxWindow(props);
     }
 
+    bool Window::isHeadlessAvailable() {
+        return OpenGLHeadlessContext::isAvailable();
+    }
+
     LinuxWindow::LinuxWindow(const WindowProps &props) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         init(props);
     }
 
     LinuxWindow::~LinuxWindow() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         shutdown();
     }
 
     void LinuxWindow::init(const Deimos::WindowProps &props) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         m_data.title = props.title;
         m_data.width = props.width;
@@ -45,7 +52,7 @@ namespace Deimos {
         DM_CORE_INFO("Creating window {0} ({1}, {2})", props.title, props.width, props.height);
 
         if (s_GLFWWindowCount == 0) {
-            DM_PROFILE_SCOPE("glfwInit");
+            DM_PROFILE_CATEGORY_SCOPE(Core, "glfwInit");
             // TODO glfw terminate on system shutdown
             int success = glfwInit();
             DM_CORE_ASSERT(success, "Could not initialize GLFW!");
@@ -58,7 +65,7 @@ namespace Deimos {
 
         {
             glfwWindowHint(GLFW_DECORATED, GLFW_TRUE);
-            DM_PROFILE_SCOPE("glfwCreateWindow");
+            DM_PROFILE_CATEGORY_SCOPE(Core, "glfwCreateWindow");
             m_window = glfwCreateWindow((int) props.width, (int) props.height, m_data.title.c_str(), nullptr, nullptr);
             ++s_GLFWWindowCount;
         }
@@ -147,14 +154,14 @@ namespace Deimos {
     }
 
     void LinuxWindow::onUpdate() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         glfwPollEvents(); // processes window events
         m_context->swapBuffers();
     }
 
     void LinuxWindow::shutdown() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         glfwDestroyWindow(m_window);
 
@@ -163,7 +170,7 @@ namespace Deimos {
     }
 
     void LinuxWindow::setVSync(bool enabled) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         if (enabled)
             glfwSwapInterval(1); // sets vertical synchronization with the refresh rate of a monitor
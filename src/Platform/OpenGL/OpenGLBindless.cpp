@@ -0,0 +1,45 @@
+#include "dmpch.h"
+#include "OpenGLBindless.h"
+
+namespace Deimos {
+    typedef GLuint64 (APIENTRYP PFNGLGETTEXTUREHANDLEARBPROC)(GLuint texture);
+    typedef void (APIENTRYP PFNGLMAKETEXTUREHANDLERESIDENTARBPROC)(GLuint64 handle);
+    typedef void (APIENTRYP PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC)(GLuint64 handle);
+
+    static PFNGLGETTEXTUREHANDLEARBPROC s_getTextureHandle = nullptr;
+    static PFNGLMAKETEXTUREHANDLERESIDENTARBPROC s_makeResident = nullptr;
+    static PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC s_makeNonResident = nullptr;
+
+    bool OpenGLBindless::s_supported = false;
+
+    void OpenGLBindless::load(GLADloadproc loader) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        bool exposed = false;
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count && !exposed; ++i)
+            exposed = !strcmp((const char*) glGetStringi(GL_EXTENSIONS, i), "GL_ARB_bindless_texture");
+
+        if (exposed) {
+            s_getTextureHandle = (PFNGLGETTEXTUREHANDLEARBPROC) loader("glGetTextureHandleARB");
+            s_makeResident = (PFNGLMAKETEXTUREHANDLERESIDENTARBPROC) loader("glMakeTextureHandleResidentARB");
+            s_makeNonResident = (PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC) loader("glMakeTextureHandleNonResidentARB");
+        }
+
+        s_supported = s_getTextureHandle && s_makeResident && s_makeNonResident;
+        DM_CORE_INFO("  Bindless textures: {0}", s_supported ? "yes" : "no");
+    }
+
+    GLuint64 OpenGLBindless::getTextureHandle(GLuint texture) {
+        return s_getTextureHandle(texture);
+    }
+
+    void OpenGLBindless::makeResident(GLuint64 handle) {
+        s_makeResident(handle);
+    }
+
+    void OpenGLBindless::makeNonResident(GLuint64 handle) {
+        s_makeNonResident(handle);
+    }
+}
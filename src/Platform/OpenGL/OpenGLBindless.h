@@ -0,0 +1,24 @@
+#ifndef ENGINE_OPENGLBINDLESS_H
+#define ENGINE_OPENGLBINDLESS_H
+
+#include <glad/glad.h>
+
+namespace Deimos {
+    // GL_ARB_bindless_texture entry points, GLAD is generated without extensions so they are loaded here
+    class OpenGLBindless {
+    public:
+        // after gladLoadGLLoader with the same loader, on the thread of the context
+        static void load(GLADloadproc loader);
+
+        inline static bool isSupported() { return s_supported; }
+
+        static GLuint64 getTextureHandle(GLuint texture);
+        static void makeResident(GLuint64 handle);
+        static void makeNonResident(GLuint64 handle);
+    private:
+        static bool s_supported;
+    };
+}
+
+
+#endif //ENGINE_OPENGLBINDLESS_H
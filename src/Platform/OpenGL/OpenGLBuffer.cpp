@@ -6,8 +6,8 @@ namespace Deimos {
 
     ////////////////////////////////////////// Vertex Buffer ///////////////////////////////////////////////////
 
-    OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size) {
-        DM_PROFILE_FUNCTION();
+    OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size) : m_size(size) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glGenBuffers(1, &m_rendererID);
         glBindBuffer(GL_ARRAY_BUFFER, m_rendererID);
@@ -15,8 +15,8 @@ namespace Deimos {
         glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
     }
 
-    OpenGLVertexBuffer::OpenGLVertexBuffer(float *vertices, uint32_t size) {
-        DM_PROFILE_FUNCTION();
+    OpenGLVertexBuffer::OpenGLVertexBuffer(float *vertices, uint32_t size) : m_size(size) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glGenBuffers(1, &m_rendererID);
         glBindBuffer(GL_ARRAY_BUFFER, m_rendererID);
@@ -25,33 +25,35 @@ namespace Deimos {
     }
 
     OpenGLVertexBuffer::~OpenGLVertexBuffer() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glDeleteBuffers(1, &m_rendererID);
     }
 
     void OpenGLVertexBuffer::bind() const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
+        m_uploadFence.wait();
         glBindBuffer(GL_ARRAY_BUFFER, m_rendererID);
     }
 
     void OpenGLVertexBuffer::unbind() const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
     void OpenGLVertexBuffer::setData(const void *data, uint32_t size) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
+        m_uploadFence.wait(); // keep the order of writes
         glBindBuffer(GL_ARRAY_BUFFER, m_rendererID);
         glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
     }
     ////////////////////////////////////////// Index Buffer ////////////////////////////////////////////////////
 
     OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, int count) : m_count(count){
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glGenBuffers(1, &m_rendererID);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererID);
@@ -60,19 +62,19 @@ namespace Deimos {
     }
 
     OpenGLIndexBuffer::~OpenGLIndexBuffer() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glDeleteBuffers(1, &m_rendererID);
     }
 
     void OpenGLIndexBuffer::bind() const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererID);
     }
 
     void OpenGLIndexBuffer::unbind() const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
         
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
@@ -80,5 +82,32 @@ namespace Deimos {
     int OpenGLIndexBuffer::getCount() const {
         return m_count;
     }
-}
 
+    ////////////////////////////////////////// Storage Buffer ////////////////////////////////////////////////////
+
+    OpenGLStorageBuffer::OpenGLStorageBuffer(uint32_t size) : m_size(size) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        glCreateBuffers(1, &m_rendererID);
+        glNamedBufferData(m_rendererID, size, nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    OpenGLStorageBuffer::~OpenGLStorageBuffer() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        glDeleteBuffers(1, &m_rendererID);
+    }
+
+    void OpenGLStorageBuffer::setData(const void *data, uint32_t size, uint32_t offset) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        DM_CORE_ASSERT(offset + size <= m_size, "Storage buffer overflow!");
+        glNamedBufferSubData(m_rendererID, offset, size, data);
+    }
+
+    void OpenGLStorageBuffer::bind(uint32_t binding) const {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_rendererID);
+    }
+}
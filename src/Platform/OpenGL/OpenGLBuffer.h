@@ -3,6 +3,7 @@
 
 #include "Deimos/Renderer/Buffer.h"
 #include "Deimos/Renderer/Shader.h"
+#include "OpenGLUploadFence.h"
 
 namespace Deimos {
 
@@ -19,9 +20,16 @@ namespace Deimos {
         virtual void setLayout(const BufferLayout &layout) override { m_layout = layout; }
 
         virtual void setData(const void* data, uint32_t size) override;
+
+        inline uint32_t getRendererID() const { return m_rendererID; }
+        inline uint32_t getSize() const { return m_size; }
+        // uploads from the UploadQueue thread, waited on before the buffer is used
+        inline OpenGLUploadFence& getUploadFence() const { return m_uploadFence; }
     private:
         uint32_t m_rendererID;
+        uint32_t m_size;
         BufferLayout m_layout;
+        mutable OpenGLUploadFence m_uploadFence;
     };
 
     class OpenGLIndexBuffer : public IndexBuffer{
@@ -38,6 +46,20 @@ namespace Deimos {
         uint32_t m_count;
     };
 
+    class OpenGLStorageBuffer : public StorageBuffer {
+    public:
+        OpenGLStorageBuffer(uint32_t size);
+        virtual ~OpenGLStorageBuffer() override;
+
+        virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) override;
+        virtual void bind(uint32_t binding) const override;
+
+        virtual uint32_t getSize() const override { return m_size; }
+    private:
+        uint32_t m_rendererID;
+        uint32_t m_size;
+    };
+
 
 }
 
@@ -1,6 +1,7 @@
 #include "dmpch.h"
 
 #include "OpenGLContext.h"
+#include "OpenGLBindless.h"
 
 #include <GLAD/include/glad/glad.h>
 #include "GLFW/include/GLFW/glfw3.h"
@@ -11,8 +12,13 @@ namespace Deimos {
         DM_CORE_ASSERT(windowHandle, "Window handle is null!")
     }
 
+    OpenGLContext::~OpenGLContext() {
+        if (m_ownsWindow)
+            glfwDestroyWindow(m_windowHandle);
+    }
+
     void OpenGLContext::init() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glfwMakeContextCurrent(m_windowHandle);
         int status = gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
@@ -22,11 +28,36 @@ namespace Deimos {
         DM_CORE_INFO("  Vendor: {0}", (const char*)glGetString(GL_VENDOR));
         DM_CORE_INFO("  Renderer: {0}", (const char*)glGetString(GL_RENDER));
         DM_CORE_INFO("  Version: {0}", (const char*)glGetString(GL_VERSION));
+
+        OpenGLBindless::load((GLADloadproc) glfwGetProcAddress);
     }
 
     void OpenGLContext::swapBuffers() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
         
         glfwSwapBuffers(m_windowHandle);
     }
+
+    void OpenGLContext::makeCurrent() {
+        glfwMakeContextCurrent(m_windowHandle);
+    }
+
+    void OpenGLContext::releaseCurrent() {
+        glfwMakeContextCurrent(nullptr);
+    }
+
+    Scope<GraphicsContext> OpenGLContext::createSharedContext() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        // GLFW only creates contexts together with a window, so the shared one gets an invisible 1x1 window
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        GLFWwindow *hiddenWindow = glfwCreateWindow(1, 1, "Deimos shared context", nullptr, m_windowHandle);
+        glfwDefaultWindowHints();
+        DM_CORE_ASSERT(hiddenWindow, "Could not create a shared context!");
+
+        // glad's function pointers are process wide, so the shared context doesn't need init()
+        Scope<OpenGLContext> context = createScope<OpenGLContext>(hiddenWindow);
+        context->m_ownsWindow = true;
+        return context;
+    }
 }
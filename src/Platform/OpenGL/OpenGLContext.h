@@ -10,11 +10,18 @@ namespace Deimos {
     {
     public:
         OpenGLContext(GLFWwindow* windowHandle);
+        virtual ~OpenGLContext() override;
 
         virtual void init() override;
         virtual void swapBuffers() override;
+
+        virtual void makeCurrent() override;
+        virtual void releaseCurrent() override;
+
+        virtual Scope<GraphicsContext> createSharedContext() override;
     private:
         GLFWwindow* m_windowHandle;
+        bool m_ownsWindow = false; // the hidden window of a shared context
     };
 }
 
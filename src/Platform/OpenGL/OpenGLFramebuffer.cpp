@@ -0,0 +1,138 @@
+#include "dmpch.h"
+#include "OpenGLFramebuffer.h"
+
+#include <glad/glad.h>
+
+namespace Deimos {
+    static const uint32_t s_maxFramebufferSize = 8192;
+
+    uint32_t OpenGLFramebuffer::s_backBufferID = 0;
+
+    static GLenum framebufferFormatToGL(FramebufferTextureFormat format) {
+        switch (format) {
+            case FramebufferTextureFormat::RGBA8:           return GL_RGBA8;
+            case FramebufferTextureFormat::RGBA16F:         return GL_RGBA16F;
+            case FramebufferTextureFormat::Depth24Stencil8: return GL_DEPTH24_STENCIL8;
+            case FramebufferTextureFormat::None:            break;
+        }
+        DM_CORE_ASSERT(false, "Unknown FramebufferTextureFormat!");
+        return 0;
+    }
+
+    static uint32_t createAttachment(FramebufferTextureFormat format, const FramebufferSpecification &spec) {
+        uint32_t id;
+        GLenum internalFormat = framebufferFormatToGL(format);
+
+        if (spec.samples > 1) {
+            glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &id);
+            glTextureStorage2DMultisample(id, spec.samples, internalFormat, spec.width, spec.height, GL_FALSE);
+            return id;
+        }
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &id);
+        glTextureStorage2D(id, 1, internalFormat, spec.width, spec.height);
+
+        glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return id;
+    }
+
+    OpenGLFramebuffer::OpenGLFramebuffer(const FramebufferSpecification &spec) : m_specification(spec) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        invalidate();
+    }
+
+    OpenGLFramebuffer::~OpenGLFramebuffer() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        release();
+    }
+
+    void OpenGLFramebuffer::invalidate() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        if (m_rendererID)
+            release();
+
+        glCreateFramebuffers(1, &m_rendererID);
+
+        m_colorAttachment = createAttachment(m_specification.colorFormat, m_specification);
+        glNamedFramebufferTexture(m_rendererID, GL_COLOR_ATTACHMENT0, m_colorAttachment, 0);
+
+        if (m_specification.depthFormat != FramebufferTextureFormat::None) {
+            m_depthAttachment = createAttachment(m_specification.depthFormat, m_specification);
+            glNamedFramebufferTexture(m_rendererID, GL_DEPTH_STENCIL_ATTACHMENT, m_depthAttachment, 0);
+        }
+
+        DM_CORE_ASSERT(glCheckNamedFramebufferStatus(m_rendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
+                       "Framebuffer is incomplete!");
+    }
+
+    void OpenGLFramebuffer::release() {
+        glDeleteFramebuffers(1, &m_rendererID);
+        glDeleteTextures(1, &m_colorAttachment);
+        if (m_depthAttachment)
+            glDeleteTextures(1, &m_depthAttachment);
+
+        m_rendererID = m_colorAttachment = m_depthAttachment = 0;
+    }
+
+    void OpenGLFramebuffer::bind() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        // viewport is client state, reading it back doesn't stall the pipeline
+        glGetIntegerv(GL_VIEWPORT, m_previousViewport);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_rendererID);
+        glViewport(0, 0, m_specification.width, m_specification.height);
+    }
+
+    void OpenGLFramebuffer::unbind() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, s_backBufferID);
+        glViewport(m_previousViewport[0], m_previousViewport[1], m_previousViewport[2], m_previousViewport[3]);
+    }
+
+    void OpenGLFramebuffer::resize(uint32_t width, uint32_t height) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        if (width == 0 || height == 0 || width > s_maxFramebufferSize || height > s_maxFramebufferSize) {
+            DM_CORE_WARN("Attempted to resize framebuffer to {0}, {1}", width, height);
+            return;
+        }
+        m_specification.width = width;
+        m_specification.height = height;
+        invalidate();
+    }
+
+    void OpenGLFramebuffer::blitTo(const Ref<Framebuffer> &target) const {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        uint32_t targetID = target ? target->getRendererID() : s_backBufferID;
+        uint32_t targetWidth = target ? target->getSpecification().width : m_specification.width;
+        uint32_t targetHeight = target ? target->getSpecification().height : m_specification.height;
+
+        // a multisampled source can only be resolved 1:1, so only single-sampled blits are filtered
+        GLenum filter = m_specification.samples > 1 ? GL_NEAREST : GL_LINEAR;
+        glBlitNamedFramebuffer(m_rendererID, targetID,
+                               0, 0, m_specification.width, m_specification.height,
+                               0, 0, targetWidth, targetHeight,
+                               GL_COLOR_BUFFER_BIT, filter);
+    }
+
+    void OpenGLFramebuffer::readPixels(uint32_t x, uint32_t y, uint32_t width, uint32_t height, void *data) const {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        DM_CORE_ASSERT(m_specification.samples == 1, "Resolve a multisampled framebuffer with blitTo before reading it!");
+        DM_CORE_ASSERT(x + width <= m_specification.width && y + height <= m_specification.height, "Read is out of bounds!");
+
+        glNamedFramebufferReadBuffer(m_rendererID, GL_COLOR_ATTACHMENT0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_rendererID);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, s_backBufferID);
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef ENGINE_OPENGLFRAMEBUFFER_H
+#define ENGINE_OPENGLFRAMEBUFFER_H
+
+#include "Deimos/Renderer/Framebuffer.h"
+
+namespace Deimos {
+    class OpenGLFramebuffer : public Framebuffer {
+    public:
+        OpenGLFramebuffer(const FramebufferSpecification& spec);
+        virtual ~OpenGLFramebuffer() override;
+
+        virtual void bind() override;
+        virtual void unbind() override;
+
+        virtual void resize(uint32_t width, uint32_t height) override;
+
+        virtual void blitTo(const Ref<Framebuffer>& target) const override;
+        virtual void readPixels(uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* data) const override;
+
+        virtual uint32_t getColorAttachmentRendererID() const override { return m_colorAttachment; }
+        virtual uint32_t getDepthAttachmentRendererID() const override { return m_depthAttachment; }
+        virtual uint32_t getRendererID() const override { return m_rendererID; }
+
+        virtual const FramebufferSpecification& getSpecification() const override { return m_specification; }
+
+        // the framebuffer unbind() returns to; a surfaceless context has no window back buffer, so it provides its own
+        static void setBackBuffer(uint32_t rendererID) { s_backBufferID = rendererID; }
+        static uint32_t getBackBuffer() { return s_backBufferID; }
+    private:
+        void invalidate();
+        void release();
+    private:
+        uint32_t m_rendererID = 0;
+        uint32_t m_colorAttachment = 0, m_depthAttachment = 0;
+        FramebufferSpecification m_specification;
+        int32_t m_previousViewport[4] = {};
+
+        static uint32_t s_backBufferID;
+    };
+}
+
+
+#endif //ENGINE_OPENGLFRAMEBUFFER_H
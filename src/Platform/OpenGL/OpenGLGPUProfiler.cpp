@@ -0,0 +1,103 @@
+#include "dmpch.h"
+#include "OpenGLGPUProfiler.h"
+
+#include <glad/glad.h>
+
+namespace Deimos {
+    // queries are only polled once they are this many frames old, by then the GPU has almost always finished them
+    static const uint64_t s_readbackLatency = 3;
+    static const uint64_t s_calibrationInterval = 600; // frames, keeps CPU and GPU clocks from drifting apart
+    static const uint32_t s_queryBlockSize = 64;
+
+    OpenGLGPUProfiler::OpenGLGPUProfiler() {
+        calibrate();
+    }
+
+    OpenGLGPUProfiler::~OpenGLGPUProfiler() {
+        if (!m_allQueries.empty())
+            glDeleteQueries((GLsizei) m_allQueries.size(), m_allQueries.data());
+    }
+
+    void OpenGLGPUProfiler::calibrate() {
+        GLint64 gpuNs = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+        auto now = std::chrono::steady_clock::now();
+
+        m_gpuBaseNs = gpuNs;
+        m_cpuBaseUs = FloatingPointMicroseconds{ now.time_since_epoch() }.count();
+        m_lastCalibrationFrame = m_frame;
+    }
+
+    uint32_t OpenGLGPUProfiler::acquireQuery() {
+        if (m_freeQueries.empty()) {
+            std::array<GLuint, s_queryBlockSize> block{};
+            glGenQueries(s_queryBlockSize, block.data());
+            m_freeQueries.insert(m_freeQueries.end(), block.begin(), block.end());
+            m_allQueries.insert(m_allQueries.end(), block.begin(), block.end());
+        }
+        uint32_t query = m_freeQueries.back();
+        m_freeQueries.pop_back();
+        return query;
+    }
+
+    uint32_t OpenGLGPUProfiler::beginScopeImpl(const char *name) {
+        // timestamps rather than GL_TIME_ELAPSED, because elapsed-time queries can't be nested
+        PendingScope scope{ name, acquireQuery(), acquireQuery(), m_frame, false };
+        glQueryCounter(scope.beginQuery, GL_TIMESTAMP);
+
+        m_pending.push_back(scope);
+        return (uint32_t) (m_firstPendingID + m_pending.size() - 1);
+    }
+
+    void OpenGLGPUProfiler::endScopeImpl(uint32_t scope) {
+        uint64_t index = scope - (uint32_t) m_firstPendingID; // wraps together with the 32 bit id
+        DM_CORE_ASSERT(index < m_pending.size(), "GPU scope was already collected!");
+
+        PendingScope &pending = m_pending[index];
+        glQueryCounter(pending.endQuery, GL_TIMESTAMP);
+        pending.ended = true;
+    }
+
+    void OpenGLGPUProfiler::collectImpl(bool wait) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        // scopes in flight are fine, the mapping is only applied at readback
+        if (m_frame - m_lastCalibrationFrame >= s_calibrationInterval)
+            calibrate();
+
+        Instrumentor &instrumentor = Instrumentor::get();
+        while (!m_pending.empty()) {
+            PendingScope &scope = m_pending.front();
+            if (!scope.ended)
+                break;
+
+            if (!wait) {
+                if (m_frame - scope.frame < s_readbackLatency)
+                    break;
+
+                GLint available = GL_FALSE;
+                glGetQueryObjectiv(scope.endQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available)
+                    break;
+            }
+
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(scope.beginQuery, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(scope.endQuery, GL_QUERY_RESULT, &end);
+
+            if (instrumentor.isRecording()) {
+                double startUs = m_cpuBaseUs + (double) ((int64_t) begin - m_gpuBaseNs) / 1000.0;
+                double durationUs = (double) (end - begin) / 1000.0;
+                instrumentor.writeGPUProfile(scope.name, startUs, durationUs);
+            }
+
+            m_freeQueries.push_back(scope.beginQuery);
+            m_freeQueries.push_back(scope.endQuery);
+            m_pending.pop_front();
+            ++m_firstPendingID;
+        }
+
+        if (!wait)
+            ++m_frame;
+    }
+}
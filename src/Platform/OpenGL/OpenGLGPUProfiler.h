@@ -0,0 +1,43 @@
+#ifndef ENGINE_OPENGLGPUPROFILER_H
+#define ENGINE_OPENGLGPUPROFILER_H
+
+#include "Deimos/Debug/GPUProfiler.h"
+
+#include <deque>
+
+namespace Deimos {
+    class OpenGLGPUProfiler : public GPUProfiler {
+    public:
+        OpenGLGPUProfiler();
+        virtual ~OpenGLGPUProfiler() override;
+    protected:
+        virtual uint32_t beginScopeImpl(const char* name) override;
+        virtual void endScopeImpl(uint32_t scope) override;
+        virtual void collectImpl(bool wait) override;
+    private:
+        uint32_t acquireQuery();
+        void calibrate();
+    private:
+        struct PendingScope {
+            const char* name;
+            uint32_t beginQuery, endQuery;
+            uint64_t frame;
+            bool ended;
+        };
+
+        std::vector<uint32_t> m_freeQueries;
+        std::vector<uint32_t> m_allQueries;
+        // scopes are kept in issue order, so readback can stop at the first one that isn't finished
+        std::deque<PendingScope> m_pending;
+        uint64_t m_firstPendingID = 0; // scope id of m_pending.front()
+        uint64_t m_frame = 0;
+
+        // GPU timestamp (ns) and CPU time (us) sampled at the same moment
+        int64_t m_gpuBaseNs = 0;
+        double m_cpuBaseUs = 0.0;
+        uint64_t m_lastCalibrationFrame = 0;
+    };
+}
+
+
+#endif //ENGINE_OPENGLGPUPROFILER_H
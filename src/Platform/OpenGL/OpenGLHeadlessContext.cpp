@@ -0,0 +1,162 @@
+#ifdef DM_PLATFORM_LINUX
+
+#include "dmpch.h"
+#include "OpenGLHeadlessContext.h"
+#include "OpenGLFramebuffer.h"
+#include "OpenGLBindless.h"
+
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+namespace Deimos {
+    // direct state access is used throughout the renderer, so 4.5 is the minimum
+    static const EGLint s_contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 4,
+        EGL_CONTEXT_MINOR_VERSION, 5,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+        EGL_NONE
+    };
+
+    static EGLDisplay getDisplay() {
+        // prefer the surfaceless platform, it needs neither X11 nor a GPU device node
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+        EGLDisplay display = EGL_NO_DISPLAY;
+        if (getPlatformDisplay)
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display == EGL_NO_DISPLAY)
+            display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        return display;
+    }
+
+    static bool findConfig(EGLDisplay display, EGLConfig &config) {
+        const EGLint configAttribs[] = {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_NONE
+        };
+        EGLint configCount = 0;
+        return eglChooseConfig(display, configAttribs, &config, 1, &configCount) && configCount > 0;
+    }
+
+    static EGLConfig chooseConfig(EGLDisplay display) {
+        EGLConfig config = nullptr;
+        [[maybe_unused]] bool found = findConfig(display, config);
+        DM_CORE_ASSERT(found, "No EGL config supports desktop OpenGL!");
+        return config;
+    }
+
+    OpenGLHeadlessContext::OpenGLHeadlessContext(uint32_t width, uint32_t height)
+        : m_width(width), m_height(height) {
+    }
+
+    OpenGLHeadlessContext::~OpenGLHeadlessContext() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        if (m_shared) {
+            eglDestroyContext(m_display, m_context);
+            return;
+        }
+
+        m_backBuffer.reset(); // GL objects must go before the context
+        OpenGLFramebuffer::setBackBuffer(0);
+
+        if (m_display) {
+            eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (m_context)
+                eglDestroyContext(m_display, m_context);
+            eglTerminate(m_display);
+        }
+    }
+
+    void OpenGLHeadlessContext::init() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        EGLDisplay display = getDisplay();
+        DM_CORE_ASSERT(display != EGL_NO_DISPLAY, "Could not get an EGL display!");
+
+        EGLint major, minor;
+        [[maybe_unused]] EGLBoolean success = eglInitialize(display, &major, &minor);
+        DM_CORE_ASSERT(success, "Could not initialize EGL!");
+        m_display = display;
+
+        success = eglBindAPI(EGL_OPENGL_API);
+        DM_CORE_ASSERT(success, "EGL does not support desktop OpenGL!");
+
+        EGLContext context = eglCreateContext(display, chooseConfig(display), EGL_NO_CONTEXT, s_contextAttribs);
+        DM_CORE_ASSERT(context != EGL_NO_CONTEXT, "Could not create an EGL context!");
+        m_context = context;
+
+        success = eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+        DM_CORE_ASSERT(success, "Surfaceless contexts are not supported (EGL_KHR_surfaceless_context)!");
+
+        [[maybe_unused]] int status = gladLoadGLLoader((GLADloadproc) eglGetProcAddress);
+        DM_CORE_ASSERT(status, "Failed to initialize Glad!");
+
+        DM_CORE_INFO("OpenGL Info (headless EGL {0}.{1}):", major, minor);
+        DM_CORE_INFO("  Vendor: {0}", (const char*)glGetString(GL_VENDOR));
+        DM_CORE_INFO("  Renderer: {0}", (const char*)glGetString(GL_RENDERER));
+        DM_CORE_INFO("  Version: {0}", (const char*)glGetString(GL_VERSION));
+
+        OpenGLBindless::load((GLADloadproc) eglGetProcAddress);
+
+        FramebufferSpecification spec;
+        spec.width = m_width;
+        spec.height = m_height;
+        m_backBuffer = createScope<OpenGLFramebuffer>(spec);
+        OpenGLFramebuffer::setBackBuffer(m_backBuffer->getRendererID());
+        m_backBuffer->bind();
+    }
+
+    bool OpenGLHeadlessContext::isAvailable() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        EGLDisplay display = getDisplay();
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+            return false;
+
+        EGLConfig config = nullptr;
+        bool available = eglBindAPI(EGL_OPENGL_API) && findConfig(display, config);
+        if (available) {
+            EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, s_contextAttribs);
+            available = context != EGL_NO_CONTEXT;
+            if (available)
+                eglDestroyContext(display, context);
+        }
+        eglTerminate(display);
+        return available;
+    }
+
+    void OpenGLHeadlessContext::swapBuffers() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        // nothing to present, just hand the frame to the driver without waiting for it
+        glFlush();
+    }
+
+    void OpenGLHeadlessContext::makeCurrent() {
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context);
+    }
+
+    void OpenGLHeadlessContext::releaseCurrent() {
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+
+    Scope<GraphicsContext> OpenGLHeadlessContext::createSharedContext() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        EGLContext context = eglCreateContext(m_display, chooseConfig(m_display), m_context, s_contextAttribs);
+        DM_CORE_ASSERT(context != EGL_NO_CONTEXT, "Could not create a shared EGL context!");
+
+        Scope<OpenGLHeadlessContext> shared = createScope<OpenGLHeadlessContext>(1, 1);
+        shared->m_display = m_display;
+        shared->m_context = context;
+        shared->m_shared = true;
+        return shared;
+    }
+}
+
+#endif
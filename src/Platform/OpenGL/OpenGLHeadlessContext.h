@@ -0,0 +1,41 @@
+#ifndef ENGINE_OPENGLHEADLESSCONTEXT_H
+#define ENGINE_OPENGLHEADLESSCONTEXT_H
+
+#include "Deimos/Renderer/GraphicsContext.h"
+#include "Deimos/Core/Core.h"
+
+namespace Deimos {
+    class OpenGLFramebuffer;
+
+    // Surfaceless EGL context (Mesa llvmpipe works too), renders into an offscreen framebuffer
+    // instead of a window, so no display server is needed
+    class OpenGLHeadlessContext : public GraphicsContext {
+    public:
+        OpenGLHeadlessContext(uint32_t width, uint32_t height);
+        virtual ~OpenGLHeadlessContext();
+
+        virtual void init() override;
+        virtual void swapBuffers() override;
+
+        virtual void makeCurrent() override;
+        virtual void releaseCurrent() override;
+
+        virtual Scope<GraphicsContext> createSharedContext() override;
+
+        // whether init can succeed here: an EGL display with a desktop OpenGL 4.5 context. Asserts nothing
+        static bool isAvailable();
+
+        // the framebuffer that stands in for the window back buffer
+        OpenGLFramebuffer& getBackBuffer() { return *m_backBuffer; }
+    private:
+        uint32_t m_width, m_height;
+
+        void* m_display = nullptr;
+        void* m_context = nullptr;
+        bool m_shared = false; // shared contexts don't own the display
+        Scope<OpenGLFramebuffer> m_backBuffer;
+    };
+}
+
+
+#endif //ENGINE_OPENGLHEADLESSCONTEXT_H
@@ -0,0 +1,58 @@
+#include "dmpch.h"
+#include "OpenGLPixelUnpackRing.h"
+
+namespace Deimos {
+    OpenGLPixelUnpackRing::~OpenGLPixelUnpackRing() {
+        for (Slot &slot : m_slots) {
+            if (slot.fence)
+                glDeleteSync(slot.fence);
+            glDeleteBuffers(1, &slot.buffer);
+        }
+    }
+
+    void OpenGLPixelUnpackRing::stage(const void *data, uint32_t rowSize, uint32_t rows, uint32_t srcStride) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        m_current = (m_current + 1) % slotCount;
+        Slot &slot = m_slots[m_current];
+        GLsizeiptr size = (GLsizeiptr) rowSize * rows;
+
+        bool busy = false;
+        if (slot.fence) {
+            // timeout 0 only polls
+            GLenum status = glClientWaitSync(slot.fence, 0, 0);
+            busy = status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED;
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+
+        if (!slot.buffer)
+            glCreateBuffers(1, &slot.buffer);
+        if (slot.size < size) {
+            slot.size = size;
+            glNamedBufferData(slot.buffer, size, nullptr, GL_STREAM_DRAW);
+        } else if (busy) {
+            glNamedBufferData(slot.buffer, slot.size, nullptr, GL_STREAM_DRAW);
+            m_orphans++;
+        }
+
+        // the buffer is idle or fresh storage, nothing to synchronize with
+        auto *dst = (uint8_t*) glMapNamedBufferRange(slot.buffer, 0, size,
+                                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        DM_CORE_ASSERT(dst, "Failed to map pixel unpack buffer!");
+        if (srcStride == rowSize) {
+            memcpy(dst, data, (size_t) size);
+        } else {
+            for (uint32_t row = 0; row < rows; ++row)
+                memcpy(dst + (size_t) row * rowSize, (const uint8_t*) data + (size_t) row * srcStride, rowSize);
+        }
+        glUnmapNamedBuffer(slot.buffer);
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    }
+
+    void OpenGLPixelUnpackRing::submitted() {
+        m_slots[m_current].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+}
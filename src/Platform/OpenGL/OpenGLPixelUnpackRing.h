@@ -0,0 +1,41 @@
+#ifndef ENGINE_OPENGLPIXELUNPACKRING_H
+#define ENGINE_OPENGLPIXELUNPACKRING_H
+
+#include <glad/glad.h>
+
+namespace Deimos {
+    // Pixel unpack buffers used in turn for streamed texture updates. The copy into a buffer never waits for the GPU:
+    // a buffer that is still being read is orphaned, the driver hands out fresh storage and frees the old one later
+    class OpenGLPixelUnpackRing {
+    public:
+        static const uint32_t slotCount = 3;
+
+        OpenGLPixelUnpackRing() = default;
+        ~OpenGLPixelUnpackRing();
+
+        OpenGLPixelUnpackRing(const OpenGLPixelUnpackRing&) = delete;
+        OpenGLPixelUnpackRing& operator=(const OpenGLPixelUnpackRing&) = delete;
+
+        // copies rows of rowSize bytes, srcStride apart, into the next buffer and binds it to GL_PIXEL_UNPACK_BUFFER.
+        // The pixel transfer reads it from offset 0, tightly packed; call submitted() after it
+        void stage(const void* data, uint32_t rowSize, uint32_t rows, uint32_t srcStride);
+        // fences the transfer issued from the staged buffer and unbinds it
+        void submitted();
+
+        // uploads that found their buffer busy and orphaned it
+        inline uint64_t getOrphanCount() const { return m_orphans; }
+    private:
+        struct Slot {
+            GLuint buffer = 0;
+            GLsizeiptr size = 0;
+            GLsync fence = nullptr;
+        };
+
+        Slot m_slots[slotCount];
+        uint32_t m_current = 0;
+        uint64_t m_orphans = 0;
+    };
+}
+
+
+#endif //ENGINE_OPENGLPIXELUNPACKRING_H
@@ -1,17 +1,25 @@
 #include "dmpch.h"
 #include "OpenGLRendererAPI.h"
+#include "OpenGLBindless.h"
+#include "OpenGLTexture2D.h"
 
 #include <glad/glad.h>
 
 namespace Deimos {
     void OpenGLRendererAPI::init() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         glEnable(GL_DEPTH_TEST);
     }
 
+    void OpenGLRendererAPI::shutdown() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        OpenGLTexture2D::releaseUploadRing();
+    }
+
     void OpenGLRendererAPI::setClearColor(const glm::vec4 &color) {
         glClearColor(color.r, color.g, color.b, color.a);
     }
@@ -21,7 +29,7 @@ namespace Deimos {
     }
 
     void OpenGLRendererAPI::drawIndexed(const Ref<VertexArray> &vertexArray, uint32_t indexCount) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         uint32_t count = indexCount ? indexCount : vertexArray->getIndexBuffer()->getCount();
 
@@ -30,7 +38,7 @@ namespace Deimos {
     }
 
     void OpenGLRendererAPI::drawLine(const Ref<VertexArray> &vertexArray, float thickness) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glLineWidth(thickness);
         glDrawElements(GL_LINES, vertexArray->getIndexBuffer()->getCount(), GL_UNSIGNED_INT, nullptr);
@@ -40,4 +48,20 @@ namespace Deimos {
     void OpenGLRendererAPI::setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
         glViewport(x, y, width, height);
     }
-}
\ No newline at end of file
+
+    void OpenGLRendererAPI::finish() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        glFinish();
+    }
+
+    uint32_t OpenGLRendererAPI::getMaxTextureSlots() const {
+        GLint units = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &units);
+        return (uint32_t) units;
+    }
+
+    bool OpenGLRendererAPI::hasBindlessTextures() const {
+        return OpenGLBindless::isSupported();
+    }
+}
@@ -7,6 +7,7 @@ namespace Deimos {
     class OpenGLRendererAPI : public RendererAPI {
     public:
         virtual void init() override;
+        virtual void shutdown() override;
 
         virtual void setClearColor(const glm::vec4& color) override;
         virtual void clear() override;
@@ -15,6 +16,10 @@ namespace Deimos {
         virtual void drawLine(const Ref<VertexArray>& vertexArray, float thickness) override;
 
         virtual void setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+        virtual void finish() override;
+
+        virtual uint32_t getMaxTextureSlots() const override;
+        virtual bool hasBindlessTextures() const override;
     };
 }
 
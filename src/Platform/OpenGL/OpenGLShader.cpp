@@ -14,7 +14,7 @@ namespace Deimos {
     }
 
     OpenGLShader::OpenGLShader(const std::string &filepath) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         std::string src = readFile(filepath);
         std::unordered_map<GLenum, std::string> shaderSrc = preprocess(src);
@@ -30,7 +30,7 @@ namespace Deimos {
 
     OpenGLShader::OpenGLShader(const std::string &name, const std::string &vertexSrc, const std::string &fragmentSrc)
             : m_name(name) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         std::unordered_map<GLenum, std::string> shaderSrc;
         shaderSrc[GL_VERTEX_SHADER] = vertexSrc;
@@ -39,13 +39,13 @@ namespace Deimos {
     }
  
     OpenGLShader::~OpenGLShader() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glDeleteProgram(m_rendererID);
     }
 
     std::string OpenGLShader::readFile(const std::string &filepath) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         std::ifstream in(filepath, std::ios::in | std::ios::binary);
         std::string res;
@@ -61,7 +61,7 @@ namespace Deimos {
     }
 
     std::unordered_map<GLenum, std::string> OpenGLShader::preprocess(const std::string &source) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         std::unordered_map<GLenum, std::string> shaderSources;
 
@@ -88,7 +88,7 @@ namespace Deimos {
     }
 
     void OpenGLShader::compile(const std::unordered_map<GLenum, std::string> &shaderSources) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         GLuint program = glCreateProgram();
         DM_ASSERT(shaderSources.size() <= 2, "We only support 2 shader for now");
@@ -152,49 +152,49 @@ namespace Deimos {
     }
 
     void OpenGLShader::bind() const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glUseProgram(m_rendererID);
     }
 
     void OpenGLShader::unbind() const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glUseProgram(0);
     }
 
     void OpenGLShader::setInt(const std::string &name, int value) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         uploadUniformInt(name, value);
     }
 
     void OpenGLShader::setFloat(const std::string &name, float value) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         uploadUniformFloat(name, value);
     }
 
     void OpenGLShader::setFloat3(const std::string &name, const glm::vec3 &value) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         uploadUniformFloat3(name, value);
     }
 
     void OpenGLShader::setFloat4(const std::string &name, const glm::vec4 &value) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         uploadUniformFloat4(name, value);
     }
 
     void OpenGLShader::setMat4(const std::string &name, const glm::mat4 &value) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         uploadUniformMat4(name, value);
     }
 
     void OpenGLShader::setIntVec(const std::string &name, const int *value, int count) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         uploadUniformIntVec(name, value, count);
     }
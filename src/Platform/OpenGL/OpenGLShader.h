@@ -35,9 +35,11 @@ namespace Deimos {
         void uploadUniformMat3(const std::string& name, const glm::mat3& matrix);
 
         void uploadUniformIntVec(const std::string& name, const int* array, int count);
+
+        // splits a .glsl file into its "#type vertex" / "#type fragment" sections
+        static std::unordered_map<GLenum, std::string> preprocess(const std::string& source);
     private:
         std::string readFile(const std::string& filepath);
-        std::unordered_map<GLenum, std::string> preprocess(const std::string& source);
         void compile(const std::unordered_map<GLenum, std::string>& shaderSources);
     private:
         uint32_t m_rendererID;
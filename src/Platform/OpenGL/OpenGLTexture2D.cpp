@@ -1,67 +1,144 @@
+#include "dmpch.h"
 #include "OpenGLTexture2D.h"
-#include "stb_image/stb_image.h"
 
-namespace Deimos {
-    
-    OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height) : m_width(width), m_height(height) {
-        DM_PROFILE_FUNCTION();
+#include "Deimos/Renderer/Image.h"
+#include "Deimos/Renderer/CompressedImage.h"
+#include "Deimos/Renderer/MipmapGenerator.h"
+#include "OpenGLBindless.h"
 
-        m_internalFormat = GL_RGB8;
-        m_dataFormat = GL_RGBA;
+// S3TC is not core, GLAD is generated without extensions
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
 
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_rendererID);
-        glTextureStorage2D(m_rendererID, 1, m_internalFormat, width, height);
+namespace Deimos {
+    // uploads happen on the render thread only, one ring serves every texture so its buffers are reused
+    static Scope<OpenGLPixelUnpackRing> s_uploadRing;
 
-        glTextureParameteri(m_rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_rendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, const TextureSpecification &spec, bool loaded)
+        : m_loaded(loaded), m_specification(spec) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
-        glTextureParameteri(m_rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(m_rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        allocate(width, height, GL_RGBA8, GL_RGBA);
     }
 
-    OpenGLTexture2D::OpenGLTexture2D(const std::string &path) : m_path(path) {
-        DM_PROFILE_FUNCTION();
+    OpenGLTexture2D::OpenGLTexture2D(const std::string &path, const TextureSpecification &spec)
+        : m_path(path), m_loaded(true), m_specification(spec) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
-        int width, height, channels;
-        stbi_set_flip_vertically_on_load(1);
-        stbi_uc *data = nullptr;
+        if (CompressedImage::isContainer(path)) {
+            CompressedImage image = CompressedImage::load(path);
+            DM_CORE_ASSERT(image.isValid(), "Failed to load compressed texture!");
+            setCompressedImage(image);
+            return;
+        }
+
+        Image image;
         {
-            DM_PROFILE_SCOPE("stbi_load: (OpenGLTexture2d)");
-            data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+            DM_PROFILE_CATEGORY_SCOPE(GLWrapper, "stbi_load: (OpenGLTexture2d)");
+            ImageLoadOptions options;
+            options.expandToRGBA = true;
+            image = Image::load(path, options);
         }
-        DM_CORE_ASSERT(data, "Failed to load image!");
+        DM_CORE_ASSERT(image.isValid(), "Failed to load image!");
+
+        setImage(image);
+    }
+
+    OpenGLTexture2D::~OpenGLTexture2D() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        releaseStorage();
+    }
+
+    void OpenGLTexture2D::allocate(uint32_t width, uint32_t height, GLenum internalFormat, GLenum dataFormat) {
+        // storage is immutable, so a new size or format means a new texture object
+        releaseStorage();
+
         m_width = width;
         m_height = height;
+        m_internalFormat = internalFormat;
+        m_dataFormat = dataFormat;
 
-        if (channels == 4) {
-            m_internalFormat = GL_RGBA8;
-            m_dataFormat = GL_RGBA;
-        } else if (channels == 3) {
-            m_internalFormat = GL_RGB8;
-            m_dataFormat = GL_RGB;
+        m_levels = getLevelCount(width, height, m_specification);
+        m_rendererID = createStorage(m_width, m_height, m_levels, m_internalFormat, m_specification);
+    }
+
+    uint32_t OpenGLTexture2D::createStorage(uint32_t width, uint32_t height, uint32_t levels, GLenum internalFormat,
+                                            const TextureSpecification &spec) {
+        uint32_t rendererID;
+        glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+        glTextureStorage2D(rendererID, levels, internalFormat, width, height);
+
+        applySpecification(rendererID, levels, spec);
+        return rendererID;
+    }
+
+    static GLenum toGLWrap(TextureWrap wrap) {
+        switch (wrap) {
+            case TextureWrap::Repeat: return GL_REPEAT;
+            case TextureWrap::MirroredRepeat: return GL_MIRRORED_REPEAT;
+            case TextureWrap::ClampToEdge: return GL_CLAMP_TO_EDGE;
         }
+        DM_CORE_ASSERT(false, "Unknown TextureWrap!");
+        return GL_REPEAT;
+    }
 
-        DM_CORE_ASSERT(m_internalFormat & m_dataFormat, "Format is not supported!");
+    void OpenGLTexture2D::applySpecification(uint32_t rendererID, uint32_t levels, const TextureSpecification &spec) {
+        bool linear = spec.minFilter == TextureFilter::Linear;
+        GLenum minFilter = linear ? GL_LINEAR : GL_NEAREST;
+        if (levels > 1) {
+            if (spec.mipFilter == TextureFilter::Linear)
+                minFilter = linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
+            else
+                minFilter = linear ? GL_LINEAR_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_NEAREST;
+        }
 
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_rendererID);
-        glTextureStorage2D(m_rendererID, 1, m_internalFormat, m_width, m_height);
+        glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, spec.magFilter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST);
+        glTextureParameteri(rendererID, GL_TEXTURE_MAX_LEVEL, levels - 1);
 
-        glTextureParameteri(m_rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_rendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, toGLWrap(spec.wrapS));
+        glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, toGLWrap(spec.wrapT));
 
-        glTextureParameteri(m_rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(m_rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        // core since 4.6, queried once (the upload thread gets here too)
+        static const float s_maxAnisotropy = [] {
+            float value = 1.f;
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &value);
+            return value;
+        }();
+        glTextureParameterf(rendererID, GL_TEXTURE_MAX_ANISOTROPY, std::clamp(spec.maxAnisotropy, 1.f, std::max(1.f, s_maxAnisotropy)));
+    }
 
-        // load texture
-        glTextureSubImage2D(m_rendererID, 0, 0, 0, m_width, m_height, m_dataFormat, GL_UNSIGNED_BYTE, data);
+    uint32_t OpenGLTexture2D::getLevelCount(uint32_t width, uint32_t height, const TextureSpecification &spec) {
+        return spec.mipmaps == MipmapMode::None ? 1 : MipmapGenerator::getLevelCount(width, height);
+    }
 
-        stbi_image_free(data);
+    void OpenGLTexture2D::getFormats(uint32_t channels, GLenum &internalFormat, GLenum &dataFormat) {
+        internalFormat = dataFormat = 0;
+        if (channels == 4) {
+            internalFormat = GL_RGBA8;
+            dataFormat = GL_RGBA;
+        } else if (channels == 3) {
+            internalFormat = GL_RGB8;
+            dataFormat = GL_RGB;
+        }
+
+        DM_CORE_ASSERT(internalFormat & dataFormat, "Format is not supported!");
     }
 
-    OpenGLTexture2D::~OpenGLTexture2D() {
-        DM_PROFILE_FUNCTION();
+    void OpenGLTexture2D::adoptStorage(uint32_t rendererID, uint32_t width, uint32_t height, uint32_t levels, GLenum internalFormat, GLenum dataFormat) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
-        glDeleteTextures(1, &m_rendererID);
+        releaseStorage();
+        m_rendererID = rendererID;
+        m_width = width;
+        m_height = height;
+        m_levels = levels;
+        m_internalFormat = internalFormat;
+        m_dataFormat = dataFormat;
+        m_loaded = true;
     }
 
     uint32_t OpenGLTexture2D::getID() const {
@@ -69,17 +146,266 @@ namespace Deimos {
     }
 
     void OpenGLTexture2D::bind(uint32_t slot) const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
         
         glBindTextureUnit(slot, m_rendererID);
     }
 
     void OpenGLTexture2D::setData(void *data, uint32_t size) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
+        DM_CORE_ASSERT(m_dataFormat, "setData doesn't support compressed textures!");
         uint32_t bpp = m_dataFormat == GL_RGBA ? 4 : 3;
         DM_CORE_ASSERT(size == m_width * m_height * bpp, "Data must be entire texture!");
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glTextureSubImage2D(m_rendererID, 0, 0, 0, m_width, m_height, m_dataFormat, GL_UNSIGNED_BYTE, data);
+
+        if (m_levels == 1)
+            return;
+        if (m_specification.mipmaps == MipmapMode::GPU) {
+            glGenerateTextureMipmap(m_rendererID);
+            return;
+        }
+
+        std::vector<Image> mips = MipmapGenerator::generate((const uint8_t*) data, m_width, m_height, bpp);
+        for (uint32_t level = 1; level < m_levels; ++level) {
+            const Image &mip = mips[level - 1];
+            glTextureSubImage2D(m_rendererID, level, 0, 0, mip.getWidth(), mip.getHeight(), m_dataFormat, GL_UNSIGNED_BYTE, mip.getData());
+        }
+    }
+
+    void OpenGLTexture2D::validateRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const {
+        DM_CORE_ASSERT(m_dataFormat, "Sub region updates don't support compressed textures!");
+        DM_CORE_ASSERT(x + width <= m_width && y + height <= m_height, "Region is outside of the texture!");
+    }
+
+    void OpenGLTexture2D::setSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        validateRegion(x, y, width, height);
+        if (width == 0 || height == 0)
+            return;
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint) rowLength);
+        glTextureSubImage2D(m_rendererID, 0, x, y, width, height, m_dataFormat, GL_UNSIGNED_BYTE, data);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+        if (m_levels > 1)
+            glGenerateTextureMipmap(m_rendererID);
+    }
+
+    void OpenGLTexture2D::streamSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        validateRegion(x, y, width, height);
+        if (width == 0 || height == 0)
+            return;
+
+        if (!m_streamRing)
+            m_streamRing = createScope<OpenGLPixelUnpackRing>();
+
+        uint32_t bpp = m_dataFormat == GL_RGBA ? 4 : 3;
+        m_streamRing->stage(data, width * bpp, height, (rowLength ? rowLength : width) * bpp);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureSubImage2D(m_rendererID, 0, x, y, width, height, m_dataFormat, GL_UNSIGNED_BYTE, nullptr);
+        m_streamRing->submitted();
+
+        if (m_levels > 1)
+            glGenerateTextureMipmap(m_rendererID);
+    }
+
+    void OpenGLTexture2D::setImage(const Image &image) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        if (m_specification.mipmaps == MipmapMode::CPU && (image.getWidth() > 1 || image.getHeight() > 1)) {
+            setMipChain(image, MipmapGenerator::generate(image));
+            return;
+        }
+
+        GLenum internalFormat, dataFormat;
+        getFormats(image.getChannels(), internalFormat, dataFormat);
+        allocate(image.getWidth(), image.getHeight(), internalFormat, dataFormat);
+
+        upload(image, {});
+        if (m_levels > 1) // the mode is GPU here
+            glGenerateTextureMipmap(m_rendererID);
+
+        m_loaded = true;
+    }
+
+    void OpenGLTexture2D::setMipChain(const Image &image, const std::vector<Image> &mips) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        GLenum internalFormat, dataFormat;
+        getFormats(image.getChannels(), internalFormat, dataFormat);
+
+        releaseStorage();
+        m_width = image.getWidth();
+        m_height = image.getHeight();
+        m_internalFormat = internalFormat;
+        m_dataFormat = dataFormat;
+        m_levels = 1 + (uint32_t) mips.size();
+        m_rendererID = createStorage(m_width, m_height, m_levels, m_internalFormat, m_specification);
+
+        upload(image, mips);
+        m_loaded = true;
+    }
+
+    void OpenGLTexture2D::setCompressedImage(const CompressedImage &image) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        DM_CORE_ASSERT(image.isValid(), "Compressed image is empty!");
+        TextureFormat format = image.getFormat();
+        if (!isFormatSupported(format)) {
+            DM_CORE_WARN("Texture '{0}': the format is not sampled natively, the driver will decompress it", m_path);
+        }
+
+        releaseStorage();
+        m_width = image.getWidth();
+        m_height = image.getHeight();
+        m_internalFormat = getInternalFormat(format);
+        m_dataFormat = format == TextureFormat::RGBA8 ? GL_RGBA : format == TextureFormat::RGB8 ? GL_RGB : 0;
+        // a single level of a block format can't get a chain, there is nothing on the GPU to filter the blocks
+        bool generate = image.getLevelCount() == 1 && m_dataFormat && m_specification.mipmaps != MipmapMode::None;
+        m_levels = generate ? MipmapGenerator::getLevelCount(m_width, m_height) : image.getLevelCount();
+        m_rendererID = createStorage(m_width, m_height, m_levels, m_internalFormat, m_specification);
+
+        // straight from the image, which may be a view of a mapped pack, no staging copy. Rows of RGB levels
+        // aren't 4 byte aligned
+        GLint alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (uint32_t i = 0; i < image.getLevelCount(); ++i) {
+            const CompressedImage::Level &level = image.getLevel(i);
+            if (m_dataFormat)
+                glTextureSubImage2D(m_rendererID, i, 0, 0, level.width, level.height, m_dataFormat, GL_UNSIGNED_BYTE,
+                                    image.getLevelData(i));
+            else
+                glCompressedTextureSubImage2D(m_rendererID, i, 0, 0, level.width, level.height, m_internalFormat,
+                                              (GLsizei) level.size, image.getLevelData(i));
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+        if (generate)
+            glGenerateTextureMipmap(m_rendererID);
+        m_loaded = true;
+    }
+
+    size_t OpenGLTexture2D::getMemorySize() const {
+        size_t size = 0;
+        for (uint32_t level = 0; level < m_levels; ++level)
+            size += getLevelMemorySize(m_internalFormat, std::max(1u, m_width >> level), std::max(1u, m_height >> level));
+        return size;
+    }
+
+    size_t OpenGLTexture2D::getLevelMemorySize(GLenum internalFormat, uint32_t width, uint32_t height) {
+        size_t blocks = (size_t) ((width + 3) / 4) * ((height + 3) / 4);
+        switch (internalFormat) {
+            case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_RGB8_ETC2:
+                return blocks * 8;
+            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            case GL_COMPRESSED_RGBA_BPTC_UNORM:
+            case GL_COMPRESSED_RGBA8_ETC2_EAC:
+                return blocks * 16;
+            default:
+                return (size_t) width * height * 4;
+        }
+    }
+
+    GLenum OpenGLTexture2D::getInternalFormat(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::None: break;
+            case TextureFormat::RGB8: return GL_RGB8;
+            case TextureFormat::RGBA8: return GL_RGBA8;
+            case TextureFormat::BC1: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case TextureFormat::ETC2RGB: return GL_COMPRESSED_RGB8_ETC2;
+            case TextureFormat::ETC2RGBA: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        }
+        DM_CORE_ASSERT(false, "Unknown TextureFormat!");
+        return 0;
+    }
+
+    bool OpenGLTexture2D::isFormatSupported(TextureFormat format) {
+        if (format == TextureFormat::None)
+            return false;
+        if (!CompressedImage::isBlockCompressed(format))
+            return true;
+
+        // S3TC is an extension, the query below may still answer for it on drivers that don't expose it
+        if (format == TextureFormat::BC1 || format == TextureFormat::BC3) {
+            static const bool s_s3tc = [] {
+                GLint count = 0;
+                glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+                for (GLint i = 0; i < count; ++i) {
+                    if (!strcmp((const char*) glGetStringi(GL_EXTENSIONS, i), "GL_EXT_texture_compression_s3tc"))
+                        return true;
+                }
+                return false;
+            }();
+            if (!s_s3tc)
+                return false;
+        }
+
+        GLint supported = GL_FALSE, compressed = GL_FALSE;
+        GLenum internalFormat = getInternalFormat(format);
+        glGetInternalformativ(GL_TEXTURE_2D, internalFormat, GL_INTERNALFORMAT_SUPPORTED, 1, &supported);
+        glGetInternalformativ(GL_TEXTURE_2D, internalFormat, GL_TEXTURE_COMPRESSED, 1, &compressed);
+        return supported == GL_TRUE && compressed == GL_TRUE;
+    }
+
+    void OpenGLTexture2D::upload(const Image &image, const std::vector<Image> &mips) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        // the ring's buffers outlive the upload, so there is no allocation per texture. glTextureSubImage2D
+        // returns once the transfer is queued and the image may be freed right after, the GPU reads the buffer
+        if (!s_uploadRing)
+            s_uploadRing = createScope<OpenGLPixelUnpackRing>();
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (uint32_t level = 0; level <= mips.size(); ++level) {
+            const Image &source = level == 0 ? image : mips[level - 1];
+            uint32_t rowSize = source.getWidth() * source.getChannels();
+            s_uploadRing->stage(source.getData(), rowSize, source.getHeight(), rowSize);
+            glTextureSubImage2D(m_rendererID, level, 0, 0, source.getWidth(), source.getHeight(), m_dataFormat,
+                                GL_UNSIGNED_BYTE, nullptr);
+            s_uploadRing->submitted();
+        }
+    }
+
+    void OpenGLTexture2D::releaseUploadRing() {
+        s_uploadRing.reset();
+    }
+
+    void OpenGLTexture2D::setSpecification(const TextureSpecification &spec) {
+        m_specification = spec;
+        // a texture with a bindless handle is immutable, the settings apply with the next storage
+        if (m_bindlessHandle) {
+            DM_CORE_WARN("Texture '{0}': sampler settings can't change while it is used bindless", m_path);
+            return;
+        }
+        applySpecification(m_rendererID, m_levels, m_specification);
+    }
+
+    uint64_t OpenGLTexture2D::getBindlessHandle() const {
+        if (!m_bindlessHandle && OpenGLBindless::isSupported()) {
+            m_bindlessHandle = OpenGLBindless::getTextureHandle(m_rendererID);
+            OpenGLBindless::makeResident(m_bindlessHandle);
+        }
+        return m_bindlessHandle;
+    }
+
+    void OpenGLTexture2D::releaseStorage() {
+        if (m_bindlessHandle) {
+            OpenGLBindless::makeNonResident(m_bindlessHandle);
+            m_bindlessHandle = 0;
+        }
+        glDeleteTextures(1, &m_rendererID); // 0 is ignored
+        m_rendererID = 0;
     }
     
     bool OpenGLTexture2D::operator==(const Texture &other) {
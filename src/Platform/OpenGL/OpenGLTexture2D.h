@@ -2,13 +2,15 @@
 #define ENGINE_OPENGLTEXTURE2D_H
 
 #include "Deimos/Renderer/Texture.h"
+#include "OpenGLPixelUnpackRing.h"
 #include <glad/glad.h>
 
 namespace Deimos {
     class OpenGLTexture2D : public Texture2D {
     public:
-        OpenGLTexture2D(uint32_t width, uint32_t height);
-        OpenGLTexture2D(const std::string& path);
+        // loaded = false marks a placeholder waiting for setImage
+        OpenGLTexture2D(uint32_t width, uint32_t height, const TextureSpecification& spec = TextureSpecification(), bool loaded = true);
+        OpenGLTexture2D(const std::string& path, const TextureSpecification& spec = TextureSpecification());
         virtual ~OpenGLTexture2D() override;
 
         virtual uint32_t getID() const override;
@@ -18,16 +20,59 @@ namespace Deimos {
         virtual void bind(uint32_t slot = 0) const override;
 
         virtual void setData(void* data, uint32_t size) override;
+        virtual void setImage(const Image& image) override;
+        virtual void setMipChain(const Image& image, const std::vector<Image>& mips) override;
+        virtual void setCompressedImage(const CompressedImage& image) override;
+
+        virtual void setSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength = 0) override;
+        virtual void streamSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength = 0) override;
+
+        virtual const TextureSpecification& getSpecification() const override { return m_specification; }
+        virtual void setSpecification(const TextureSpecification& spec) override;
+
+        virtual bool isLoaded() const override { return m_loaded; }
+        virtual size_t getMemorySize() const override;
+        virtual uint64_t getBindlessHandle() const override;
 
         virtual bool operator==(const Texture& other) override;
+
+        // takes ownership of a texture object filled elsewhere (the upload thread) and drops the current one
+        void adoptStorage(uint32_t rendererID, uint32_t width, uint32_t height, uint32_t levels, GLenum internalFormat, GLenum dataFormat);
+
+        // texture object with immutable storage for the given number of levels, sampled as the specification says
+        static uint32_t createStorage(uint32_t width, uint32_t height, uint32_t levels, GLenum internalFormat,
+                                      const TextureSpecification& spec = TextureSpecification());
+        static void applySpecification(uint32_t rendererID, uint32_t levels, const TextureSpecification& spec);
+        // levels the storage gets under the specification, 1 without mipmaps
+        static uint32_t getLevelCount(uint32_t width, uint32_t height, const TextureSpecification& spec);
+        static void getFormats(uint32_t channels, GLenum& internalFormat, GLenum& dataFormat);
+        static GLenum getInternalFormat(TextureFormat format);
+        // size of one level in video memory, 3 channel formats are counted padded to 4 bytes like drivers store them
+        static size_t getLevelMemorySize(GLenum internalFormat, uint32_t width, uint32_t height);
+        static bool isFormatSupported(TextureFormat format);
+        // drops the staging buffers shared by every texture's upload, before the context goes away
+        static void releaseUploadRing();
+    private:
+        void releaseStorage();
+        void allocate(uint32_t width, uint32_t height, GLenum internalFormat, GLenum dataFormat);
+        // level 0 and the mips, each staged through the shared pixel unpack ring
+        void upload(const Image& image, const std::vector<Image>& mips);
+        void validateRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
     private:
         std::string m_path;
 
-        uint32_t m_rendererID;
+        uint32_t m_rendererID = 0;
         uint32_t m_width;
         uint32_t m_height;
+        uint32_t m_levels = 1;
+        mutable uint64_t m_bindlessHandle = 0; // created and made resident on first use
+        bool m_loaded;
+
+        TextureSpecification m_specification;
 
         GLenum m_internalFormat, m_dataFormat;
+
+        Scope<OpenGLPixelUnpackRing> m_streamRing; // created by the first streamSubData
     };
 }
 
@@ -0,0 +1,133 @@
+#include "dmpch.h"
+#include "OpenGLTexture2DArray.h"
+#include "OpenGLTexture2D.h"
+#include "OpenGLBindless.h"
+
+#include "Deimos/Renderer/Image.h"
+#include "Deimos/Renderer/MipmapGenerator.h"
+
+namespace Deimos {
+    OpenGLTexture2DArray::OpenGLTexture2DArray(uint32_t width, uint32_t height, uint32_t layers, const TextureSpecification &spec)
+        : m_width(width), m_height(height), m_layers(layers), m_specification(spec) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        allocate();
+    }
+
+    OpenGLTexture2DArray::OpenGLTexture2DArray(const std::vector<std::string> &paths, const TextureSpecification &spec)
+        : m_layers((uint32_t) paths.size()), m_specification(spec) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        DM_CORE_ASSERT(!paths.empty(), "Texture array needs at least one layer!");
+        ImageLoadOptions options;
+        options.expandToRGBA = true;
+        std::vector<Image> images = Image::loadBatch(paths, options);
+        for (uint32_t layer = 0; layer < m_layers; ++layer) {
+            const Image &image = images[layer];
+            DM_CORE_ASSERT(image.isValid(), "Failed to load image!");
+            if (layer == 0) {
+                m_width = image.getWidth();
+                m_height = image.getHeight();
+                allocate();
+            }
+
+            DM_CORE_ASSERT(image.getWidth() == m_width && image.getHeight() == m_height, "Texture array layers must have the same size!");
+            GLenum internalFormat, dataFormat;
+            OpenGLTexture2D::getFormats(image.getChannels(), internalFormat, dataFormat);
+            // GPU generated mips are built once for every layer at the end
+            uploadLayer(layer, image.getData(), dataFormat, image.getChannels(), false);
+        }
+
+        if (m_levels > 1 && m_specification.mipmaps == MipmapMode::GPU)
+            glGenerateTextureMipmap(m_rendererID);
+    }
+
+    OpenGLTexture2DArray::~OpenGLTexture2DArray() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        if (m_bindlessHandle)
+            OpenGLBindless::makeNonResident(m_bindlessHandle);
+        glDeleteTextures(1, &m_rendererID);
+    }
+
+    void OpenGLTexture2DArray::allocate() {
+        m_levels = OpenGLTexture2D::getLevelCount(m_width, m_height, m_specification);
+
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_rendererID);
+        glTextureStorage3D(m_rendererID, m_levels, GL_RGBA8, m_width, m_height, m_layers);
+        OpenGLTexture2D::applySpecification(m_rendererID, m_levels, m_specification);
+    }
+
+    void OpenGLTexture2DArray::bind(uint32_t slot) const {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        glBindTextureUnit(slot, m_rendererID);
+    }
+
+    void OpenGLTexture2DArray::setData(void *data, uint32_t size) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        uint32_t layerSize = m_width * m_height * 4;
+        DM_CORE_ASSERT(size == layerSize * m_layers, "Data must be entire texture array!");
+        for (uint32_t layer = 0; layer < m_layers; ++layer)
+            uploadLayer(layer, (const uint8_t*) data + (size_t) layer * layerSize, GL_RGBA, 4, false);
+
+        if (m_levels > 1 && m_specification.mipmaps == MipmapMode::GPU)
+            glGenerateTextureMipmap(m_rendererID);
+    }
+
+    void OpenGLTexture2DArray::setLayerData(uint32_t layer, const void *data, uint32_t size) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        DM_CORE_ASSERT(size == m_width * m_height * 4, "Data must be an entire layer!");
+        uploadLayer(layer, data, GL_RGBA, 4, true);
+    }
+
+    void OpenGLTexture2DArray::setLayerImage(uint32_t layer, const Image &image) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        DM_CORE_ASSERT(image.getWidth() == m_width && image.getHeight() == m_height, "Texture array layers must have the same size!");
+        GLenum internalFormat, dataFormat;
+        OpenGLTexture2D::getFormats(image.getChannels(), internalFormat, dataFormat);
+        uploadLayer(layer, image.getData(), dataFormat, image.getChannels(), true);
+    }
+
+    void OpenGLTexture2DArray::uploadLayer(uint32_t layer, const void *data, GLenum dataFormat, uint32_t channels, bool generateMipmaps) {
+        DM_CORE_ASSERT(layer < m_layers, "Texture array layer out of range!");
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureSubImage3D(m_rendererID, 0, 0, 0, layer, m_width, m_height, 1, dataFormat, GL_UNSIGNED_BYTE, data);
+        if (m_levels == 1)
+            return;
+
+        if (m_specification.mipmaps == MipmapMode::CPU) {
+            std::vector<Image> mips = MipmapGenerator::generate((const uint8_t*) data, m_width, m_height, channels);
+            for (uint32_t level = 1; level < m_levels; ++level) {
+                const Image &mip = mips[level - 1];
+                glTextureSubImage3D(m_rendererID, level, 0, 0, layer, mip.getWidth(), mip.getHeight(), 1, dataFormat,
+                                    GL_UNSIGNED_BYTE, mip.getData());
+            }
+        } else if (generateMipmaps) {
+            glGenerateTextureMipmap(m_rendererID); // rebuilds every layer
+        }
+    }
+
+    size_t OpenGLTexture2DArray::getMemorySize() const {
+        size_t size = 0;
+        for (uint32_t level = 0; level < m_levels; ++level)
+            size += OpenGLTexture2D::getLevelMemorySize(GL_RGBA8, std::max(1u, m_width >> level), std::max(1u, m_height >> level));
+        return size * m_layers;
+    }
+
+    uint64_t OpenGLTexture2DArray::getBindlessHandle() const {
+        if (!m_bindlessHandle && OpenGLBindless::isSupported()) {
+            m_bindlessHandle = OpenGLBindless::getTextureHandle(m_rendererID);
+            OpenGLBindless::makeResident(m_bindlessHandle);
+        }
+        return m_bindlessHandle;
+    }
+
+    bool OpenGLTexture2DArray::operator==(const Texture &other) {
+        return m_rendererID == other.getID();
+    }
+}
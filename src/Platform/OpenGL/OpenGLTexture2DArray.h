@@ -0,0 +1,48 @@
+#ifndef ENGINE_OPENGLTEXTURE2DARRAY_H
+#define ENGINE_OPENGLTEXTURE2DARRAY_H
+
+#include "Deimos/Renderer/Texture.h"
+#include <glad/glad.h>
+
+namespace Deimos {
+    class OpenGLTexture2DArray : public Texture2DArray {
+    public:
+        OpenGLTexture2DArray(uint32_t width, uint32_t height, uint32_t layers, const TextureSpecification& spec = TextureSpecification());
+        OpenGLTexture2DArray(const std::vector<std::string>& paths, const TextureSpecification& spec = TextureSpecification());
+        virtual ~OpenGLTexture2DArray() override;
+
+        virtual uint32_t getID() const override { return m_rendererID; }
+        virtual uint32_t getWidth() const override { return m_width; }
+        virtual uint32_t getHeight() const override { return m_height; }
+        virtual uint32_t getLayerCount() const override { return m_layers; }
+
+        virtual void bind(uint32_t slot = 0) const override;
+
+        // every layer at once
+        virtual void setData(void* data, uint32_t size) override;
+        virtual void setLayerData(uint32_t layer, const void* data, uint32_t size) override;
+        virtual void setLayerImage(uint32_t layer, const Image& image) override;
+
+        virtual const TextureSpecification& getSpecification() const override { return m_specification; }
+
+        virtual bool isLoaded() const override { return true; }
+        virtual size_t getMemorySize() const override;
+        virtual uint64_t getBindlessHandle() const override;
+
+        virtual bool operator==(const Texture& other) override;
+    private:
+        void allocate();
+        // level 0 of the layer, then its mips as the specification says
+        void uploadLayer(uint32_t layer, const void* data, GLenum dataFormat, uint32_t channels, bool generateMipmaps);
+    private:
+        uint32_t m_rendererID = 0;
+        uint32_t m_width = 0, m_height = 0, m_layers = 0;
+        uint32_t m_levels = 1;
+        mutable uint64_t m_bindlessHandle = 0;
+
+        TextureSpecification m_specification;
+    };
+}
+
+
+#endif //ENGINE_OPENGLTEXTURE2DARRAY_H
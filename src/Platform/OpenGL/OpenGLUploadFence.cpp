@@ -0,0 +1,47 @@
+#include "dmpch.h"
+#include "OpenGLUploadFence.h"
+
+namespace Deimos {
+    OpenGLUploadFence::~OpenGLUploadFence() {
+        if (m_fence)
+            glDeleteSync(m_fence);
+    }
+
+    void OpenGLUploadFence::expect() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_expected;
+        m_pending.store(true, std::memory_order_release);
+    }
+
+    void OpenGLUploadFence::publish(GLsync fence) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_fence)
+                glDeleteSync(m_fence); // superseded, the new fence signals after it anyway
+            m_fence = fence;
+            ++m_published;
+        }
+        m_condition.notify_all();
+    }
+
+    void OpenGLUploadFence::wait() {
+        if (!m_pending.load(std::memory_order_acquire))
+            return;
+
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        GLsync fence;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_published == m_expected; });
+            fence = m_fence;
+            m_fence = nullptr;
+            m_pending.store(false, std::memory_order_release);
+        }
+
+        if (fence) {
+            glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(fence);
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef ENGINE_OPENGLUPLOADFENCE_H
+#define ENGINE_OPENGLUPLOADFENCE_H
+
+#include <glad/glad.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace Deimos {
+    // Tracks uploads of one resource made on the upload thread. Only the latest fence is kept, fences of
+    // one context signal in order.
+    class OpenGLUploadFence {
+    public:
+        OpenGLUploadFence() = default;
+        ~OpenGLUploadFence();
+
+        OpenGLUploadFence(const OpenGLUploadFence&) = delete;
+        OpenGLUploadFence& operator=(const OpenGLUploadFence&) = delete;
+
+        // frame thread, when the upload is queued
+        void expect();
+        // upload thread, once the upload commands are flushed
+        void publish(GLsync fence);
+        // frame thread, before the resource is used. Blocks only while an upload isn't even submitted yet,
+        // otherwise the wait is put into the GPU command stream.
+        void wait();
+    private:
+        std::atomic<bool> m_pending{ false };
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        uint32_t m_expected = 0, m_published = 0;
+        GLsync m_fence = nullptr;
+    };
+}
+
+
+#endif //ENGINE_OPENGLUPLOADFENCE_H
@@ -0,0 +1,171 @@
+#include "dmpch.h"
+#include "OpenGLUploadQueue.h"
+
+namespace Deimos {
+    OpenGLUploadQueue::OpenGLUploadQueue(Scope<GraphicsContext> sharedContext) : m_context(std::move(sharedContext)) {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        m_thread = std::thread(&OpenGLUploadQueue::threadLoop, this);
+    }
+
+    OpenGLUploadQueue::~OpenGLUploadQueue() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+
+        // nothing will be copied anymore, don't leave a later bind() waiting for it
+        for (UploadJob &job : m_jobs) {
+            if (job.buffer)
+                job.buffer->getUploadFence().publish(nullptr);
+        }
+
+        // the objects are shared, so the frame context can clean up what never got swapped in
+        m_inFlight.insert(m_inFlight.end(), m_uploaded.begin(), m_uploaded.end());
+        for (UploadedTexture &uploaded : m_inFlight) {
+            glDeleteSync(uploaded.fence);
+            glDeleteTextures(1, &uploaded.rendererID);
+        }
+
+        m_context.reset(); // a GLFW window behind it must be destroyed on the main thread
+    }
+
+    void OpenGLUploadQueue::uploadTextureImpl(const Ref<Texture2D> &texture, Image image, std::vector<Image> mips) {
+        DM_CORE_ASSERT(image.isValid(), "Image is empty!");
+
+        UploadJob job;
+        job.texture = std::static_pointer_cast<OpenGLTexture2D>(texture);
+        job.image = std::move(image);
+        job.mips = std::move(mips);
+        job.specification = texture->getSpecification();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            job.id = m_nextJobID++;
+            DM_PROFILE_CATEGORY_ASYNC_BEGIN(GLWrapper, "Texture upload", job.id);
+            m_jobs.push_back(std::move(job));
+        }
+        m_condition.notify_one();
+    }
+
+    void OpenGLUploadQueue::uploadBufferImpl(const Ref<VertexBuffer> &buffer, const void *data, uint32_t size, uint32_t offset) {
+        UploadJob job;
+        job.buffer = std::static_pointer_cast<OpenGLVertexBuffer>(buffer);
+        DM_CORE_ASSERT(offset + size <= job.buffer->getSize(), "Upload is out of the buffer bounds!");
+
+        job.data.assign((const uint8_t*) data, (const uint8_t*) data + size);
+        job.offset = offset;
+        job.buffer->getUploadFence().expect();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            job.id = m_nextJobID++;
+            DM_PROFILE_CATEGORY_ASYNC_BEGIN(GLWrapper, "Buffer upload", job.id);
+            m_jobs.push_back(std::move(job));
+        }
+        m_condition.notify_one();
+    }
+
+    void OpenGLUploadQueue::updateImpl() {
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        {
+            std::lock_guard<std::mutex> lock(m_uploadedMutex);
+            m_inFlight.insert(m_inFlight.end(), m_uploaded.begin(), m_uploaded.end());
+            m_uploaded.clear();
+        }
+
+        // polling with a zero timeout never blocks, unfinished copies are checked again next frame
+        auto it = m_inFlight.begin();
+        while (it != m_inFlight.end()) {
+            GLenum status = glClientWaitSync(it->fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED) {
+                ++it;
+                continue;
+            }
+
+            glDeleteSync(it->fence);
+            if (Ref<OpenGLTexture2D> texture = it->texture.lock())
+                texture->adoptStorage(it->rendererID, it->width, it->height, it->levels, it->internalFormat, it->dataFormat);
+            else
+                glDeleteTextures(1, &it->rendererID);
+
+            it = m_inFlight.erase(it);
+        }
+    }
+
+    void OpenGLUploadQueue::threadLoop() {
+        DM_PROFILE_THREAD_NAME("Upload");
+        m_context->makeCurrent();
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        while (true) {
+            UploadJob job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+                if (m_stopping)
+                    break;
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            if (job.buffer) {
+                DM_PROFILE_CATEGORY_SCOPE(GLWrapper, "OpenGLUploadQueue buffer upload");
+
+                glNamedBufferSubData(job.buffer->getRendererID(), job.offset, (GLsizeiptr) job.data.size(), job.data.data());
+                GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                glFlush(); // the fence must reach the GPU before another context can wait on it
+                job.buffer->getUploadFence().publish(fence);
+
+                m_bytesUploaded += job.data.size();
+                DM_PROFILE_CATEGORY_ASYNC_END(GLWrapper, "Buffer upload", job.id);
+                DM_PROFILE_CATEGORY_COUNTER(GLWrapper, "Bytes uploaded", m_bytesUploaded);
+                continue;
+            }
+
+            if (job.texture.expired()) {
+                DM_PROFILE_CATEGORY_ASYNC_END(GLWrapper, "Texture upload", job.id);
+                continue;
+            }
+
+            DM_PROFILE_CATEGORY_SCOPE(GLWrapper, "OpenGLUploadQueue texture upload");
+
+            GLenum internalFormat, dataFormat;
+            OpenGLTexture2D::getFormats(job.image.getChannels(), internalFormat, dataFormat);
+
+            uint32_t width = job.image.getWidth(), height = job.image.getHeight();
+            bool gpuMipmaps = job.mips.empty() && job.specification.mipmaps != MipmapMode::None;
+            uint32_t levels = gpuMipmaps ? OpenGLTexture2D::getLevelCount(width, height, job.specification)
+                                         : 1 + (uint32_t) job.mips.size();
+
+            uint32_t rendererID = OpenGLTexture2D::createStorage(width, height, levels, internalFormat, job.specification);
+            glTextureSubImage2D(rendererID, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, job.image.getData());
+            for (uint32_t i = 0; i < job.mips.size(); ++i) {
+                const Image &mip = job.mips[i];
+                glTextureSubImage2D(rendererID, i + 1, 0, 0, mip.getWidth(), mip.getHeight(), dataFormat, GL_UNSIGNED_BYTE, mip.getData());
+            }
+            if (gpuMipmaps && levels > 1)
+                glGenerateTextureMipmap(rendererID);
+
+            GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            {
+                std::lock_guard<std::mutex> lock(m_uploadedMutex);
+                m_uploaded.push_back({ job.texture, rendererID, width, height, levels, internalFormat, dataFormat, fence });
+            }
+
+            m_bytesUploaded += job.image.getSize();
+            for (const Image &mip : job.mips)
+                m_bytesUploaded += mip.getSize();
+            DM_PROFILE_CATEGORY_ASYNC_END(GLWrapper, "Texture upload", job.id);
+            DM_PROFILE_CATEGORY_COUNTER(GLWrapper, "Bytes uploaded", m_bytesUploaded);
+        }
+
+        m_context->releaseCurrent();
+    }
+}
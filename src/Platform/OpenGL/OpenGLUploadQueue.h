@@ -0,0 +1,66 @@
+#ifndef ENGINE_OPENGLUPLOADQUEUE_H
+#define ENGINE_OPENGLUPLOADQUEUE_H
+
+#include "Deimos/Renderer/UploadQueue.h"
+
+#include "OpenGLBuffer.h"
+#include "OpenGLTexture2D.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Deimos {
+    class OpenGLUploadQueue : public UploadQueue {
+    public:
+        OpenGLUploadQueue(Scope<GraphicsContext> sharedContext);
+        virtual ~OpenGLUploadQueue() override;
+    protected:
+        virtual void uploadTextureImpl(const Ref<Texture2D>& texture, Image image, std::vector<Image> mips) override;
+        virtual void uploadBufferImpl(const Ref<VertexBuffer>& buffer, const void* data, uint32_t size, uint32_t offset) override;
+        virtual void updateImpl() override;
+    private:
+        void threadLoop();
+    private:
+        struct UploadJob {
+            std::weak_ptr<OpenGLTexture2D> texture;
+            Image image;
+            std::vector<Image> mips;
+            TextureSpecification specification; // copied on submit, the texture is only touched on the frame thread
+
+            Ref<OpenGLVertexBuffer> buffer; // held, the upload thread writes into its storage
+            std::vector<uint8_t> data;
+            uint32_t offset = 0;
+
+            uint64_t id = 0; // pairs the async profile events from submit to upload
+        };
+
+        // texture storage created on the upload thread, swapped in once its fence has signaled
+        struct UploadedTexture {
+            std::weak_ptr<OpenGLTexture2D> texture;
+            uint32_t rendererID;
+            uint32_t width, height, levels;
+            GLenum internalFormat, dataFormat;
+            GLsync fence;
+        };
+
+        Scope<GraphicsContext> m_context;
+        std::thread m_thread;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<UploadJob> m_jobs;
+        uint64_t m_nextJobID = 0;
+        bool m_stopping = false;
+
+        uint64_t m_bytesUploaded = 0; // upload thread
+
+        std::mutex m_uploadedMutex;
+        std::vector<UploadedTexture> m_uploaded;   // written by the upload thread
+        std::vector<UploadedTexture> m_inFlight;   // frame thread only
+    };
+}
+
+
+#endif //ENGINE_OPENGLUPLOADQUEUE_H
@@ -2,6 +2,7 @@
 #include "OpenGLVertexArray.h"
 
 #include <../vendor/GLAD/include/glad/glad.h>
+#include "OpenGLBuffer.h"
 
 namespace Deimos {
 
@@ -25,31 +26,35 @@ namespace Deimos {
     }
 
     OpenGLVertexArray::OpenGLVertexArray() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glCreateVertexArrays(1, &m_rendererID);
     }
 
     OpenGLVertexArray::~OpenGLVertexArray() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glDeleteVertexArrays(1, &m_rendererID);
     }
 
     void OpenGLVertexArray::bind() const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
+
+        // draws read the buffers without binding them, so pending uploads are waited on here
+        for (const Ref<VertexBuffer> &vertexBuffer : m_vertexBuffers)
+            std::static_pointer_cast<OpenGLVertexBuffer>(vertexBuffer)->getUploadFence().wait();
 
         glBindVertexArray(m_rendererID);
     }
 
     void OpenGLVertexArray::unbind() const {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
 
         glBindVertexArray(0);
     }
 
     void OpenGLVertexArray::addVertexBuffer(const Ref<VertexBuffer> &vertexBuffer) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
         auto layout1 = vertexBuffer->getLayout();
 
         DM_CORE_ASSERT(vertexBuffer->getLayout().getElements().size(), "Vertex Buffer has no layout!");
@@ -71,7 +76,7 @@ namespace Deimos {
     }
 
     void OpenGLVertexArray::setIndexBuffer(const Ref<IndexBuffer> &indexBuffer) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(GLWrapper);
         
         glBindVertexArray(m_rendererID);
         indexBuffer->bind();
@@ -0,0 +1,53 @@
+#ifdef DM_PLATFORM_WINDOWS
+
+#include "dmpch.h"
+#include "WindowsMappedFile.h"
+
+#include <windows.h>
+
+namespace Deimos {
+    Scope<MappedFile> MappedFile::open(const std::string &path) {
+        DM_PROFILE_CATEGORY_FUNCTION(Assets);
+
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            DM_CORE_ERROR("Could not open '{0}' (error {1})", path, GetLastError());
+            return nullptr;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            DM_CORE_ERROR("Could not map '{0}': empty or unreadable", path);
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file); // the mapping keeps the file referenced
+        if (!mapping) {
+            DM_CORE_ERROR("Could not map '{0}' (error {1})", path, GetLastError());
+            return nullptr;
+        }
+
+        const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!data) {
+            DM_CORE_ERROR("Could not map '{0}' (error {1})", path, GetLastError());
+            CloseHandle(mapping);
+            return nullptr;
+        }
+
+        return createScope<WindowsMappedFile>(mapping, data, (size_t) size.QuadPart);
+    }
+
+    WindowsMappedFile::WindowsMappedFile(void *mapping, const void *data, size_t size)
+        : m_mapping(mapping), m_data(data), m_size(size) {
+    }
+
+    WindowsMappedFile::~WindowsMappedFile() {
+        UnmapViewOfFile(m_data);
+        CloseHandle((HANDLE) m_mapping);
+    }
+}
+
+#endif
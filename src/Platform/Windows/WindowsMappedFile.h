@@ -0,0 +1,22 @@
+#ifndef ENGINE_WINDOWSMAPPEDFILE_H
+#define ENGINE_WINDOWSMAPPEDFILE_H
+
+#include "Deimos/Core/MappedFile.h"
+
+namespace Deimos {
+    class WindowsMappedFile : public MappedFile {
+    public:
+        WindowsMappedFile(void* mapping, const void* data, size_t size);
+        virtual ~WindowsMappedFile() override;
+
+        virtual const uint8_t* getData() const override { return (const uint8_t*) m_data; }
+        virtual size_t getSize() const override { return m_size; }
+    private:
+        void* m_mapping; // HANDLE
+        const void* m_data;
+        size_t m_size;
+    };
+}
+
+
+#endif //ENGINE_WINDOWSMAPPEDFILE_H
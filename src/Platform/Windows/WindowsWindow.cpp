@@ -10,6 +10,9 @@
 
 #include "Platform/OpenGL/OpenGLContext.h"
 
+#include <cstdio>
+#include <cstdlib>
+
 namespace Deimos {
     // static because should only be inited once no matter how many windows
     static uint8_t s_GLFWWindowCount = 0;
@@ -19,23 +22,33 @@ namespace Deimos {
     }
 
     Window *Window::create(const WindowProps &props) {
+        if (props.headless) {
+            // asserts are compiled out of release builds, which would quietly open a visible window instead
+            DM_CORE_ERROR("Headless windows are only available on Linux");
+            std::fprintf(stderr, "Headless window requested on Windows\n");
+            std::abort();
+        }
         return new WindowsWindow(props);
     }
 
+    bool Window::isHeadlessAvailable() {
+        return false;
+    }
+
     WindowsWindow::WindowsWindow(const WindowProps &props) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         init(props);
     }
 
     WindowsWindow::~WindowsWindow() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         shutdown();
     }
 
     void WindowsWindow::init(const Deimos::WindowProps &props) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         m_data.title = props.title;
         m_data.width = props.width;
@@ -55,7 +68,7 @@ namespace Deimos {
 
         {
             glfwWindowHint(GLFW_DECORATED, GLFW_TRUE);
-            DM_PROFILE_SCOPE("glfwCreateWindow");
+            DM_PROFILE_CATEGORY_SCOPE(Core, "glfwCreateWindow");
             m_window = glfwCreateWindow((int) props.width, (int) props.height, m_data.title.c_str(), nullptr, nullptr);
             ++s_GLFWWindowCount;
         }
@@ -144,14 +157,14 @@ namespace Deimos {
     }
 
     void WindowsWindow::onUpdate() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         glfwPollEvents(); // processes window events
         m_context->swapBuffers();
     }
 
     void WindowsWindow::shutdown() {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
         
         if(--s_GLFWWindowCount == 0)
             glfwTerminate();
@@ -160,7 +173,7 @@ namespace Deimos {
     }
 
     void WindowsWindow::setVSync(bool enabled) {
-        DM_PROFILE_FUNCTION();
+        DM_PROFILE_CATEGORY_FUNCTION(Core);
 
         if (enabled)
             glfwSwapInterval(1); // sets vertical synchronization with the refresh rate of a monitor
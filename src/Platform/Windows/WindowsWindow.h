@@ -17,6 +17,7 @@ namespace Deimos {
         inline unsigned int getWidth() const override { return m_data.width; }
         inline unsigned int getHeight() const override { return m_data.height; }
         inline void* getNativeWindow() const override { return m_window; }
+        inline GraphicsContext& getContext() override { return *m_context; }
 
         // Window attributes
         inline void setEventCallback(const eventCallbackFn &callback) override {
@@ -18,6 +18,7 @@
 
 #include "Deimos/Core/Log.h"
 #include "Deimos/Debug/Instrumentor.h"
+#include "Deimos/Debug/GPUProfiler.h"
 
 #ifdef DM_PLATFORM_WINDOWS
     #include <Windows.h>
@@ -0,0 +1,197 @@
+// The asset pack table of contents: lookups in a valid pack, then packs that are malformed or cut short, which
+// open has to reject before anything reads through the table
+
+#include "TestUtils.h"
+
+#include "Deimos/Assets/AssetPack.h"
+#include "Deimos/Core/Hash.h"
+#include "Deimos/Core/Log.h"
+
+using namespace Deimos;
+using namespace DeimosTests;
+
+struct PackEntry {
+    std::string name;
+    std::string data;
+    AssetPackFormat::EntryType type = AssetPackFormat::EntryType::Raw;
+    uint32_t params[4] = {};
+};
+
+// the layout DeimosAssetCooker writes: header, aligned entry data, the table sorted by name hash, the names
+static std::vector<uint8_t> buildPack(std::vector<PackEntry> entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const PackEntry &a, const PackEntry &b) { return fnv1a(a.name) < fnv1a(b.name); });
+
+    AssetPackFormat::Header header = {};
+    std::memcpy(header.magic, AssetPackFormat::magic, sizeof(header.magic));
+    header.version = AssetPackFormat::version;
+    header.entryCount = (uint32_t) entries.size();
+    header.alignment = AssetPackFormat::defaultAlignment;
+
+    std::vector<uint8_t> pack(sizeof(header));
+    std::vector<AssetPackFormat::Entry> toc;
+    std::string names;
+    for (const PackEntry &entry : entries) {
+        pack.resize((pack.size() + header.alignment - 1) / header.alignment * header.alignment);
+
+        AssetPackFormat::Entry tocEntry = {};
+        tocEntry.nameHash = fnv1a(entry.name);
+        tocEntry.offset = pack.size();
+        tocEntry.size = entry.data.size();
+        tocEntry.nameOffset = (uint32_t) names.size();
+        tocEntry.type = entry.type;
+        std::memcpy(tocEntry.params, entry.params, sizeof(tocEntry.params));
+        toc.push_back(tocEntry);
+
+        pack.insert(pack.end(), entry.data.begin(), entry.data.end());
+        names.append(entry.name.c_str(), entry.name.size() + 1);
+    }
+
+    pack.resize((pack.size() + alignof(AssetPackFormat::Entry) - 1) / alignof(AssetPackFormat::Entry) * alignof(AssetPackFormat::Entry));
+    header.tocOffset = pack.size();
+    pack.insert(pack.end(), (const uint8_t*) toc.data(), (const uint8_t*) (toc.data() + toc.size()));
+    header.namesOffset = pack.size();
+    pack.insert(pack.end(), names.begin(), names.end());
+    std::memcpy(pack.data(), &header, sizeof(header));
+    return pack;
+}
+
+static std::vector<PackEntry> makeEntries() {
+    std::vector<PackEntry> entries(3);
+    entries[0].name = "config/settings.ini";
+    entries[0].data = "vsync=1\n";
+    entries[1].name = "textures/white.rgba";
+    entries[1].data = std::string(4 * 4 * 4, '\xff');
+    entries[1].type = AssetPackFormat::EntryType::Texture;
+    entries[1].params[0] = (uint32_t) TextureFormat::RGBA8;
+    entries[1].params[1] = entries[1].params[2] = 4;
+    entries[1].params[3] = 1;
+    entries[2].name = "readme.txt";
+    entries[2].data = "packed by the test";
+    return entries;
+}
+
+static Scope<AssetPack> open(const TempDirectory &directory, const std::vector<uint8_t> &pack) {
+    std::string path = directory.file("test.dmpak");
+    if (!writeFile(path, pack))
+        return nullptr;
+    return AssetPack::open(path);
+}
+
+// the toc entry of a name, for corrupting it in place
+static size_t entryOffset(const std::vector<uint8_t> &pack, const std::string &name) {
+    AssetPackFormat::Header header;
+    std::memcpy(&header, pack.data(), sizeof(header));
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        size_t offset = header.tocOffset + i * sizeof(AssetPackFormat::Entry);
+        uint64_t hash;
+        std::memcpy(&hash, pack.data() + offset, sizeof(hash));
+        if (hash == fnv1a(name))
+            return offset;
+    }
+    return 0;
+}
+
+static int findsEntries() {
+    TempDirectory directory("DeimosAssetPackTest");
+    std::vector<PackEntry> entries = makeEntries();
+    Scope<AssetPack> pack = open(directory, buildPack(entries));
+    CHECK(pack);
+    CHECK(pack->getEntryCount() == entries.size());
+
+    for (const PackEntry &entry : entries) {
+        const AssetPackFormat::Entry *found = pack->find(entry.name);
+        CHECK(found);
+        CHECK(found->type == entry.type);
+        CHECK(found->size == entry.data.size());
+        CHECK(std::memcmp(pack->getData(*found), entry.data.data(), entry.data.size()) == 0);
+        CHECK(entry.name == pack->getName(*found));
+        CHECK(found->offset % AssetPackFormat::defaultAlignment == 0);
+    }
+    CHECK(!pack->contains("missing.txt"));
+    CHECK(!pack->contains(""));
+    CHECK(!pack->contains("readme.txt/"));
+    return 0;
+}
+
+static int truncated() {
+    TempDirectory directory("DeimosAssetPackTest");
+    std::vector<uint8_t> pack = buildPack(makeEntries());
+    CHECK(open(directory, pack));
+
+    // the names are last, every cut loses at least the terminator of the last one
+    for (size_t size = 0; size < pack.size(); ++size)
+        CHECK(!open(directory, std::vector<uint8_t>(pack.begin(), pack.begin() + size)));
+    return 0;
+}
+
+static int invalidHeader() {
+    TempDirectory directory("DeimosAssetPackTest");
+    const std::vector<uint8_t> pack = buildPack(makeEntries());
+    auto with = [&pack](size_t offset, auto value) {
+        std::vector<uint8_t> copy = pack;
+        writeAt(copy, offset, value);
+        return copy;
+    };
+
+    // Header: magic, version at 4, entry count at 8, alignment at 12, toc offset at 16, names offset at 24
+    CHECK(!open(directory, with(0, 'X')));
+    CHECK(!open(directory, with(4, AssetPackFormat::version + 1)));
+    CHECK(!open(directory, with(8, (uint32_t) 0x1000)));
+    CHECK(!open(directory, with(8, (uint32_t) 0xFFFFFFFF)));
+    CHECK(!open(directory, with(16, (uint64_t) pack.size() + 64)));
+    CHECK(!open(directory, with(16, (uint64_t) 0xFFFFFFFFFFFFFF00ull)));
+    CHECK(!open(directory, with(16, (uint64_t) sizeof(AssetPackFormat::Header) + 1))); // misaligned
+    CHECK(!open(directory, with(24, (uint64_t) pack.size() + 1)));
+    CHECK(!open(directory, with(24, (uint64_t) 0xFFFFFFFFFFFFFF00ull)));
+    return 0;
+}
+
+static int invalidEntries() {
+    TempDirectory directory("DeimosAssetPackTest");
+    const std::vector<uint8_t> pack = buildPack(makeEntries());
+    size_t readme = entryOffset(pack, "readme.txt"), texture = entryOffset(pack, "textures/white.rgba");
+    CHECK(readme && texture);
+    auto with = [&pack](size_t offset, auto value) {
+        std::vector<uint8_t> copy = pack;
+        writeAt(copy, offset, value);
+        return copy;
+    };
+
+    // Entry: hash, offset at 8, size at 16, name offset at 24, type at 28, params from 32
+    CHECK(!open(directory, with(readme + 8, (uint64_t) pack.size())));
+    CHECK(!open(directory, with(readme + 8, (uint64_t) 0xFFFFFFFFFFFFFF00ull)));
+    CHECK(!open(directory, with(readme + 16, (uint64_t) pack.size())));
+    CHECK(!open(directory, with(readme + 16, (uint64_t) 0xFFFFFFFFFFFFFFFFull)));
+    CHECK(!open(directory, with(readme + 24, (uint32_t) 0xFFFFFFFF)));
+    // the hashes must stay sorted for the binary search
+    std::vector<uint8_t> unsorted = pack;
+    AssetPackFormat::Header header;
+    std::memcpy(&header, pack.data(), sizeof(header));
+    std::swap_ranges(unsorted.begin() + header.tocOffset, unsorted.begin() + header.tocOffset + sizeof(AssetPackFormat::Entry),
+                     unsorted.begin() + header.tocOffset + sizeof(AssetPackFormat::Entry));
+    CHECK(!open(directory, unsorted));
+
+    // the last name loses its terminator
+    std::vector<uint8_t> unterminated = pack;
+    unterminated.back() = 'x';
+    CHECK(!open(directory, unterminated));
+
+    // texture params: format, width, height and level count
+    CHECK(!open(directory, with(texture + 32, (uint32_t) TextureFormat::None)));
+    CHECK(!open(directory, with(texture + 32, (uint32_t) 100)));
+    CHECK(!open(directory, with(texture + 36, (uint32_t) 0)));
+    CHECK(!open(directory, with(texture + 44, (uint32_t) 0)));
+    CHECK(!open(directory, with(texture + 44, (uint32_t) 4)));
+    return 0;
+}
+
+int main() {
+    Log::init();
+
+    RUN_TEST(findsEntries);
+    RUN_TEST(truncated);
+    RUN_TEST(invalidHeader);
+    RUN_TEST(invalidEntries);
+    return 0;
+}
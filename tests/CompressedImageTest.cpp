@@ -0,0 +1,223 @@
+// KTX2 and DDS containers: round trips, the flip of top-down KTX2 files, then headers that are malformed or cut
+// short, which must fail cleanly instead of reading past the data
+
+#include "TestUtils.h"
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Renderer/CompressedImage.h"
+
+using namespace Deimos;
+using namespace DeimosTests;
+
+// offsets into a KTX2 file: the header follows the 12 byte identifier, the level index follows the header
+static const size_t s_ktx2Width = 20, s_ktx2Height = 24, s_ktx2Faces = 36, s_ktx2LevelCount = 40;
+static const size_t s_ktx2LevelIndex = 80;
+// offsets into a DDS file, past the magic number
+static const size_t s_ddsHeight = 12, s_ddsWidth = 16, s_ddsMipCount = 28, s_ddsPixelFormatFlags = 80, s_ddsFourCC = 84;
+
+static CompressedImage makeImage(TextureFormat format, uint32_t width, uint32_t height, uint32_t levelCount) {
+    CompressedImage image(format, width, height);
+    uint8_t value = 1;
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        std::vector<uint8_t> level(CompressedImage::getLevelSize(format, std::max(1u, width >> i), std::max(1u, height >> i)));
+        for (uint8_t &byte : level)
+            byte = value++;
+        image.addLevel(level.data(), level.size());
+    }
+    return image;
+}
+
+static bool sameLevels(const CompressedImage &a, const CompressedImage &b) {
+    if (a.getFormat() != b.getFormat() || a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight()
+        || a.getLevelCount() != b.getLevelCount())
+        return false;
+    for (uint32_t i = 0; i < a.getLevelCount(); ++i) {
+        if (a.getLevel(i).size != b.getLevel(i).size
+            || std::memcmp(a.getLevelData(i), b.getLevelData(i), a.getLevel(i).size) != 0)
+            return false;
+    }
+    return true;
+}
+
+static CompressedImage load(const std::vector<uint8_t> &data) {
+    return CompressedImage::loadFromMemory(data.data(), data.size());
+}
+
+static std::vector<uint8_t> withField(const std::vector<uint8_t> &data, size_t offset, uint32_t value) {
+    std::vector<uint8_t> copy = data;
+    writeAt(copy, offset, value);
+    return copy;
+}
+
+static int ktx2RoundTrip() {
+    TempDirectory directory("DeimosCompressedImageTest");
+    for (TextureFormat format : { TextureFormat::RGBA8, TextureFormat::BC1, TextureFormat::BC3, TextureFormat::BC7 }) {
+        CompressedImage image = makeImage(format, 16, 8, 5);
+        std::string path = directory.file("roundtrip.ktx2");
+        CHECK(image.writeKTX2(path));
+
+        CompressedImage loaded = load(readFile(path));
+        CHECK(loaded.isValid());
+        CHECK(sameLevels(image, loaded));
+    }
+    return 0;
+}
+
+static int ddsRoundTrip() {
+    TempDirectory directory("DeimosCompressedImageTest");
+    for (TextureFormat format : { TextureFormat::RGBA8, TextureFormat::BC1, TextureFormat::BC3, TextureFormat::BC7 }) {
+        CompressedImage image = makeImage(format, 16, 8, 5);
+        std::string path = directory.file("roundtrip.dds");
+        CHECK(image.writeDDS(path));
+
+        CompressedImage loaded = load(readFile(path));
+        CHECK(loaded.isValid());
+        CHECK(sameLevels(image, loaded));
+    }
+    return 0;
+}
+
+// the writer tags its files "ru", turning that into "rd" makes the loader flip them
+static bool makeTopDown(std::vector<uint8_t> &data) {
+    static const char key[] = "KTXorientation";
+    auto it = std::search(data.begin(), data.end(), key, key + sizeof(key));
+    if (it == data.end() || data.end() - it < (std::ptrdiff_t) sizeof(key) + 2)
+        return false;
+    *(it + sizeof(key) + 1) = 'd';
+    return true;
+}
+
+static int ktx2TopDownIsFlipped() {
+    TempDirectory directory("DeimosCompressedImageTest");
+    std::string path = directory.file("topdown.ktx2");
+
+    CompressedImage pixels = makeImage(TextureFormat::RGBA8, 4, 3, 1);
+    CHECK(pixels.writeKTX2(path));
+    std::vector<uint8_t> data = readFile(path);
+    CHECK(makeTopDown(data));
+    CompressedImage flipped = load(data);
+    CHECK(flipped.isValid());
+    const size_t rowSize = 4 * 4;
+    for (uint32_t y = 0; y < 3; ++y)
+        CHECK(std::memcmp(flipped.getLevelData(0) + y * rowSize, pixels.getLevelData(0) + (2 - y) * rowSize, rowSize) == 0);
+
+    // one BC1 block: the endpoints stay, the index bytes of the four rows are reversed
+    CompressedImage block(TextureFormat::BC1, 4, 4);
+    const uint8_t blockData[8] = { 1, 2, 3, 4, 0x11, 0x22, 0x33, 0x44 };
+    block.addLevel(blockData, sizeof(blockData));
+    CHECK(block.writeKTX2(path));
+    data = readFile(path);
+    CHECK(makeTopDown(data));
+    CompressedImage flippedBlock = load(data);
+    CHECK(flippedBlock.isValid());
+    const uint8_t expected[8] = { 1, 2, 3, 4, 0x44, 0x33, 0x22, 0x11 };
+    CHECK(std::memcmp(flippedBlock.getLevelData(0), expected, sizeof(expected)) == 0);
+
+    // BC7 blocks can't be flipped, and neither can BC1 levels whose rows would split a block
+    CHECK(makeImage(TextureFormat::BC7, 8, 8, 1).writeKTX2(path));
+    data = readFile(path);
+    CHECK(makeTopDown(data));
+    CHECK(!load(data).isValid());
+
+    CHECK(makeImage(TextureFormat::BC1, 4, 6, 1).writeKTX2(path));
+    data = readFile(path);
+    CHECK(makeTopDown(data));
+    CHECK(!load(data).isValid());
+    return 0;
+}
+
+// the end of the last level in the file, everything before it is needed
+static size_t ktx2DataEnd(const std::vector<uint8_t> &data) {
+    uint32_t levelCount = 0;
+    std::memcpy(&levelCount, data.data() + s_ktx2LevelCount, 4);
+    size_t end = 0;
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        uint64_t offset, length;
+        std::memcpy(&offset, data.data() + s_ktx2LevelIndex + i * 24, 8);
+        std::memcpy(&length, data.data() + s_ktx2LevelIndex + i * 24 + 8, 8);
+        end = std::max(end, (size_t) (offset + length));
+    }
+    return end;
+}
+
+static int truncated() {
+    TempDirectory directory("DeimosCompressedImageTest");
+    CompressedImage image = makeImage(TextureFormat::BC3, 16, 16, 5);
+
+    CHECK(image.writeKTX2(directory.file("truncated.ktx2")));
+    std::vector<uint8_t> data = readFile(directory.file("truncated.ktx2"));
+    size_t end = ktx2DataEnd(data);
+    CHECK(end <= data.size());
+    for (size_t size = 0; size < end; ++size)
+        CHECK(!CompressedImage::loadFromMemory(data.data(), size).isValid());
+
+    CHECK(image.writeDDS(directory.file("truncated.dds")));
+    data = readFile(directory.file("truncated.dds"));
+    for (size_t size = 0; size < data.size(); ++size)
+        CHECK(!CompressedImage::loadFromMemory(data.data(), size).isValid());
+    return 0;
+}
+
+static int ktx2InvalidHeader() {
+    TempDirectory directory("DeimosCompressedImageTest");
+    CHECK(makeImage(TextureFormat::RGBA8, 8, 8, 4).writeKTX2(directory.file("header.ktx2")));
+    const std::vector<uint8_t> data = readFile(directory.file("header.ktx2"));
+    CHECK(load(data).isValid());
+
+    CHECK(!load(withField(data, 12, 12345)).isValid()); // VkFormat
+    CHECK(!load(withField(data, s_ktx2Width, 0)).isValid());
+    CHECK(!load(withField(data, s_ktx2Height, 0)).isValid());
+    CHECK(!load(withField(data, s_ktx2Faces, 6)).isValid());
+    // longer than the chain down to 1x1, and more levels than the index holds
+    CHECK(!load(withField(data, s_ktx2LevelCount, 5)).isValid());
+    CHECK(!load(withField(data, s_ktx2LevelCount, 0xFFFFFFFF)).isValid());
+    // a larger picture than the levels were sized for
+    CHECK(!load(withField(data, s_ktx2Width, 16)).isValid());
+
+    // a level offset and length that wrap around when added
+    std::vector<uint8_t> level = data;
+    writeAt(level, s_ktx2LevelIndex, (uint64_t) 0xFFFFFFFFFFFFFF00ull);
+    writeAt(level, s_ktx2LevelIndex + 8, (uint64_t) 0x200);
+    CHECK(!load(level).isValid());
+    level = data;
+    writeAt(level, s_ktx2LevelIndex + 8, (uint64_t) 0xFFFFFFFFFFFFFFFFull);
+    CHECK(!load(level).isValid());
+
+    // key/value data pointing outside the file isn't read, the orientation falls back to top-down
+    std::vector<uint8_t> keyValue = withField(data, 56, 0xFFFFFF00);
+    writeAt(keyValue, 60, (uint32_t) 0x200);
+    CHECK(load(keyValue).isValid());
+    return 0;
+}
+
+static int ddsInvalidHeader() {
+    TempDirectory directory("DeimosCompressedImageTest");
+    CHECK(makeImage(TextureFormat::BC1, 8, 8, 4).writeDDS(directory.file("header.dds")));
+    const std::vector<uint8_t> data = readFile(directory.file("header.dds"));
+    CHECK(load(data).isValid());
+
+    CHECK(!load(withField(data, s_ddsWidth, 0)).isValid());
+    CHECK(!load(withField(data, s_ddsHeight, 0)).isValid());
+    CHECK(!load(withField(data, s_ddsMipCount, 5)).isValid());
+    CHECK(!load(withField(data, s_ddsMipCount, 0xFFFFFFFF)).isValid());
+    CHECK(!load(withField(data, s_ddsWidth, 0x10000)).isValid());
+    CHECK(!load(withField(data, s_ddsPixelFormatFlags, 0)).isValid());
+    CHECK(!load(withField(data, s_ddsFourCC, 0x12345678)).isValid());
+
+    std::vector<uint8_t> notAContainer = data;
+    notAContainer[0] = 'X';
+    CHECK(!load(notAContainer).isValid());
+    return 0;
+}
+
+int main() {
+    Log::init();
+
+    RUN_TEST(ktx2RoundTrip);
+    RUN_TEST(ddsRoundTrip);
+    RUN_TEST(ktx2TopDownIsFlipped);
+    RUN_TEST(truncated);
+    RUN_TEST(ktx2InvalidHeader);
+    RUN_TEST(ddsInvalidHeader);
+    return 0;
+}
@@ -0,0 +1,148 @@
+// FrameHistogram percentiles over its rolling window and the FrameClock's fixed step accounting. Deltas are given
+// to the clock by hand, only the frame rate limit is measured against the real clock
+
+#include "TestUtils.h"
+
+#include "Deimos/Core/FrameClock.h"
+#include "Deimos/Core/Log.h"
+#include "Deimos/Debug/FrameStats.h"
+
+#include <cmath>
+
+using namespace Deimos;
+
+static bool isNear(float value, float expected, float tolerance) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+static int histogramEmpty() {
+    FrameHistogram histogram(16);
+    CHECK(histogram.getCount() == 0);
+    CHECK(histogram.getPercentile(0.5f) == 0.f);
+    CHECK(histogram.getMax() == 0.f);
+    CHECK(histogram.getMean() == 0.f);
+    CHECK(histogram.getSummary().samples == 0);
+    return 0;
+}
+
+static int histogramPercentiles() {
+    FrameHistogram histogram(100);
+    for (int i = 100; i >= 1; --i)
+        histogram.add((float) i);
+
+    // accurate to half a bucket, max and mean are exact
+    const float tolerance = FrameHistogram::bucketWidth;
+    FrameTimeSummary summary = histogram.getSummary();
+    CHECK(summary.samples == 100);
+    CHECK(isNear(summary.p50, 50.f, tolerance));
+    CHECK(isNear(summary.p95, 95.f, tolerance));
+    CHECK(isNear(summary.p99, 99.f, tolerance));
+    CHECK(summary.max == 100.f);
+    CHECK(isNear(summary.mean, 50.5f, 1e-4f));
+    CHECK(isNear(histogram.getPercentile(0.f), 1.f, tolerance));
+    CHECK(histogram.getPercentile(1.f) == 100.f);
+    return 0;
+}
+
+static int histogramWindow() {
+    // only the last four samples count, the ones they pushed out leave the buckets too
+    FrameHistogram histogram(4);
+    for (float sample : { 90.f, 80.f, 70.f, 60.f, 1.f, 2.f, 3.f, 4.f })
+        histogram.add(sample);
+    CHECK(histogram.getCount() == 4);
+    CHECK(histogram.getMax() == 4.f);
+    CHECK(isNear(histogram.getMean(), 2.5f, 1e-4f));
+    CHECK(isNear(histogram.getPercentile(1.f), 4.f, FrameHistogram::bucketWidth));
+
+    histogram.reset();
+    CHECK(histogram.getCount() == 0);
+    CHECK(histogram.getPercentile(0.5f) == 0.f);
+    histogram.add(5.f);
+    CHECK(histogram.getMax() == 5.f);
+    return 0;
+}
+
+static int histogramOutliers() {
+    // past the last bucket, and values that belong in none
+    FrameHistogram histogram(8);
+    histogram.add(10.f);
+    histogram.add(500.f);
+    histogram.add(-1.f);
+    histogram.add(NAN);
+    CHECK(histogram.getCount() == 4);
+    CHECK(histogram.getPercentile(1.f) == 500.f);
+    CHECK(histogram.getPercentile(0.25f) <= FrameHistogram::bucketWidth);
+    return 0;
+}
+
+// powers of two keep the arithmetic exact
+static int fixedStep() {
+    FrameClock clock;
+    clock.setFixedStep(0.125f);
+    CHECK(clock.isFixedStepEnabled());
+
+    clock.tick(0.3125f);
+    CHECK(clock.getSubstepCount() == 2);
+    CHECK(clock.getInterpolationAlpha() == 0.5f);
+
+    clock.tick(0.0625f);
+    CHECK(clock.getSubstepCount() == 1);
+    CHECK(clock.getInterpolationAlpha() == 0.f);
+
+    clock.tick(0.f);
+    CHECK(clock.getSubstepCount() == 0);
+    CHECK(clock.getFrameCount() == 3);
+    CHECK(clock.getTime() == 0.375);
+    return 0;
+}
+
+static int fixedStepDropsBacklog() {
+    FrameClock clock;
+    clock.setFixedStep(0.125f, 4);
+
+    // 16 steps due, 4 run and the rest is dropped instead of slowing down the following frames
+    clock.tick(2.f);
+    CHECK(clock.getSubstepCount() == 4);
+    CHECK(clock.getInterpolationAlpha() == 0.f);
+
+    clock.tick(0.0625f);
+    CHECK(clock.getSubstepCount() == 0);
+    CHECK(clock.getInterpolationAlpha() == 0.5f);
+
+    clock.setFixedStep(0.f);
+    clock.tick(1.f);
+    CHECK(!clock.isFixedStepEnabled());
+    CHECK(clock.getSubstepCount() == 0);
+    CHECK(clock.getDelta() == 1.f);
+    return 0;
+}
+
+static int frameRateLimit() {
+    FrameClock clock;
+    clock.setFrameRateLimit(200.f);
+
+    // the period is 5 ms, ten of them can't be over sooner than 45 ms (the first starts from now)
+    FrameClock::Clock::time_point start = FrameClock::Clock::now();
+    for (int i = 0; i < 10; ++i)
+        clock.limit();
+    double elapsed = std::chrono::duration<double>(FrameClock::Clock::now() - start).count();
+    CHECK(elapsed >= 0.045);
+
+    clock.setMaxDelta(0.001f);
+    clock.tick();
+    CHECK(clock.getDelta() <= 0.001f);
+    return 0;
+}
+
+int main() {
+    Log::init();
+
+    RUN_TEST(histogramEmpty);
+    RUN_TEST(histogramPercentiles);
+    RUN_TEST(histogramWindow);
+    RUN_TEST(histogramOutliers);
+    RUN_TEST(fixedStep);
+    RUN_TEST(fixedStepDropsBacklog);
+    RUN_TEST(frameRateLimit);
+    return 0;
+}
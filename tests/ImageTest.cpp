@@ -0,0 +1,172 @@
+// QOI and raw (.dmraw) decoding: round trips, then headers that are malformed or cut short, which must fail
+// cleanly instead of reading past the data
+
+#include "TestUtils.h"
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Renderer/Image.h"
+
+using namespace Deimos;
+using namespace DeimosTests;
+
+static const size_t s_rawHeaderSize = 32;
+static const size_t s_qoiHeaderSize = 14, s_qoiEndMarkerSize = 8;
+
+// noisy enough that the QOI encoder writes literal pixels instead of runs
+static Image makeImage(uint32_t width, uint32_t height, uint32_t channels) {
+    Image image(width, height, channels);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < image.getSize(); ++i) {
+        state = state * 1664525u + 1013904223u;
+        image.getData()[i] = (uint8_t) (state >> 24);
+    }
+    return image;
+}
+
+static bool samePixels(const Image &a, const Image &b) {
+    return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight() && a.getChannels() == b.getChannels()
+           && std::memcmp(a.getData(), b.getData(), a.getSize()) == 0;
+}
+
+static Image load(const std::vector<uint8_t> &data, size_t size, bool flipVertically = false) {
+    return Image::loadFromMemory(data.data(), size, flipVertically);
+}
+
+static int qoiRoundTrip() {
+    TempDirectory directory("DeimosImageTest");
+    for (uint32_t channels : { 3u, 4u }) {
+        Image image = makeImage(7, 5, channels);
+        std::string path = directory.file("roundtrip.qoi");
+        CHECK(image.writeQOI(path));
+
+        // QOI is stored top row first, the writer takes the image as bottom row first like everything in memory
+        std::vector<uint8_t> data = readFile(path);
+        Image loaded = load(data, data.size(), true);
+        CHECK(loaded.isValid());
+        CHECK(samePixels(image, loaded));
+    }
+    return 0;
+}
+
+static int qoiTruncated() {
+    TempDirectory directory("DeimosImageTest");
+    Image image = makeImage(7, 5, 4);
+    std::string path = directory.file("truncated.qoi");
+    CHECK(image.writeQOI(path));
+    std::vector<uint8_t> data = readFile(path);
+
+    // a cut into the last few ops can still decode garbage from the end marker's bytes, anything short of the
+    // chunks has to fail, and no prefix may read past its end
+    for (size_t size = 0; size < data.size(); ++size) {
+        std::vector<uint8_t> prefix(data.begin(), data.begin() + size);
+        Image loaded = load(prefix, prefix.size());
+        if (size < s_qoiHeaderSize + s_qoiEndMarkerSize || size <= data.size() / 2)
+            CHECK(!loaded.isValid());
+    }
+    return 0;
+}
+
+static int qoiInvalidHeader() {
+    TempDirectory directory("DeimosImageTest");
+    Image image = makeImage(4, 4, 4);
+    std::string path = directory.file("header.qoi");
+    CHECK(image.writeQOI(path));
+    const std::vector<uint8_t> data = readFile(path);
+
+    auto withByte = [&data](size_t offset, uint8_t value) {
+        std::vector<uint8_t> copy = data;
+        copy[offset] = value;
+        return copy;
+    };
+
+    // width and height are big endian at 4 and 8, the channel count at 12
+    std::vector<uint8_t> zeroWidth = data;
+    std::memset(zeroWidth.data() + 4, 0, 4);
+    CHECK(!load(zeroWidth, zeroWidth.size()).isValid());
+
+    // 65535 x 65535 is over the QOI pixel limit, the buffer size must not be computed from it
+    std::vector<uint8_t> huge = data;
+    std::memset(huge.data() + 4, 0, 8);
+    huge[6] = huge[7] = huge[10] = huge[11] = 0xFF;
+    CHECK(!load(huge, huge.size()).isValid());
+
+    CHECK(!load(withByte(12, 2), data.size()).isValid());
+    CHECK(!load(withByte(12, 5), data.size()).isValid());
+    return 0;
+}
+
+static int rawRoundTrip() {
+    TempDirectory directory("DeimosImageTest");
+    for (uint32_t channels = 1; channels <= 4; ++channels) {
+        Image image = makeImage(5, 3, channels);
+        std::string path = directory.file("roundtrip.dmraw");
+        CHECK(image.writeRaw(path));
+
+        // written with the GL row order, loading it flipped is a plain copy
+        std::vector<uint8_t> data = readFile(path);
+        CHECK(data.size() == s_rawHeaderSize + image.getSize());
+        Image loaded = load(data, data.size(), true);
+        CHECK(loaded.isValid());
+        CHECK(samePixels(image, loaded));
+    }
+    return 0;
+}
+
+static int rawTruncated() {
+    TempDirectory directory("DeimosImageTest");
+    Image image = makeImage(5, 3, 4);
+    std::string path = directory.file("truncated.dmraw");
+    CHECK(image.writeRaw(path));
+    std::vector<uint8_t> data = readFile(path);
+
+    for (size_t size = 0; size < data.size(); ++size) {
+        std::vector<uint8_t> prefix(data.begin(), data.begin() + size);
+        CHECK(!load(prefix, prefix.size()).isValid());
+    }
+    return 0;
+}
+
+static int rawInvalidHeader() {
+    TempDirectory directory("DeimosImageTest");
+    Image image = makeImage(4, 4, 4);
+    std::string path = directory.file("header.dmraw");
+    CHECK(image.writeRaw(path));
+    const std::vector<uint8_t> data = readFile(path);
+
+    // version at 4, then width, height and channels
+    auto withField = [&data](size_t offset, uint32_t value) {
+        std::vector<uint8_t> copy = data;
+        writeAt(copy, offset, value);
+        return copy;
+    };
+
+    CHECK(!load(withField(4, 2), data.size()).isValid());
+    CHECK(!load(withField(8, 0), data.size()).isValid());
+    CHECK(!load(withField(12, 0), data.size()).isValid());
+    CHECK(!load(withField(16, 0), data.size()).isValid());
+    CHECK(!load(withField(16, 5), data.size()).isValid());
+
+    // sizes computed from these wrap around in 32 bits, and stay over the pixel limit in 64
+    std::vector<uint8_t> huge = withField(8, 0x10000);
+    writeAt(huge, 12, (uint32_t) 0x10000);
+    CHECK(!load(huge, huge.size()).isValid());
+    huge = withField(8, 0xFFFFFFFF);
+    writeAt(huge, 12, (uint32_t) 0xFFFFFFFF);
+    CHECK(!load(huge, huge.size()).isValid());
+
+    // more pixels than the file holds
+    CHECK(!load(withField(12, 5), data.size()).isValid());
+    return 0;
+}
+
+int main() {
+    Log::init();
+
+    RUN_TEST(qoiRoundTrip);
+    RUN_TEST(qoiTruncated);
+    RUN_TEST(qoiInvalidHeader);
+    RUN_TEST(rawRoundTrip);
+    RUN_TEST(rawTruncated);
+    RUN_TEST(rawInvalidHeader);
+    return 0;
+}
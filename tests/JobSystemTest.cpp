@@ -0,0 +1,163 @@
+// JobSystem scheduling: every index of a parallelFor runs exactly once, dependencies hold jobs back, main thread
+// jobs run on the main thread, waits nest inside jobs and shutdown drains whatever is still queued
+
+#include "TestUtils.h"
+
+#include "Deimos/Core/JobSystem.h"
+#include "Deimos/Core/Log.h"
+
+#include <atomic>
+#include <memory>
+
+using namespace Deimos;
+
+static int threadIndices() {
+    CHECK(JobSystem::getThreadCount() == 4);
+    CHECK(JobSystem::getThreadIndex() == 0);
+
+    std::atomic<int32_t> lowest{ INT32_MAX }, highest{ INT32_MIN };
+    JobCounter counter;
+    for (int i = 0; i < 64; ++i) {
+        JobSystem::run([&lowest, &highest]() {
+            int32_t index = JobSystem::getThreadIndex();
+            lowest = std::min(lowest.load(), index);
+            highest = std::max(highest.load(), index);
+        }, &counter);
+    }
+    JobSystem::wait(counter);
+    CHECK(lowest >= 0);
+    CHECK(highest < (int32_t) JobSystem::getThreadCount());
+    return 0;
+}
+
+static int parallelForCoversEveryIndex() {
+    for (uint32_t count : { 0u, 1u, 7u, 1000u, 100000u }) {
+        std::unique_ptr<std::atomic<uint32_t>[]> visits(new std::atomic<uint32_t>[count + 1]);
+        for (uint32_t i = 0; i < count; ++i)
+            visits[i] = 0;
+
+        JobSystem::parallelFor(count, [&visits](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+                visits[i]++;
+        }, 16);
+        for (uint32_t i = 0; i < count; ++i)
+            CHECK(visits[i] == 1);
+
+        JobCounter counter;
+        JobSystem::parallelFor(count, [&visits](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+                visits[i]++;
+        }, counter, 16);
+        JobSystem::wait(counter);
+        for (uint32_t i = 0; i < count; ++i)
+            CHECK(visits[i] == 2);
+    }
+    return 0;
+}
+
+static int dependencies() {
+    // each stage only starts once the one before it is done, so it sees all of its writes. A counter can drop
+    // to zero while jobs are still being given to it, so every stage is queued whole before the next one
+    const uint32_t width = 32;
+    std::atomic<uint32_t> stage{ 0 };
+    std::atomic<uint32_t> outOfOrder{ 0 };
+    JobCounter first, second, third;
+    for (uint32_t i = 0; i < width; ++i)
+        JobSystem::run([&]() { stage++; }, &first);
+    for (uint32_t i = 0; i < width; ++i) {
+        JobSystem::run([&]() {
+            if (stage.load() < width)
+                outOfOrder++;
+            stage++;
+        }, &second, &first);
+    }
+    for (uint32_t i = 0; i < width; ++i) {
+        JobSystem::run([&]() {
+            if (stage.load() < 2 * width)
+                outOfOrder++;
+        }, &third, &second);
+    }
+    JobSystem::wait(third);
+    CHECK(first.isDone() && second.isDone());
+    CHECK(stage == 2 * width);
+    CHECK(outOfOrder == 0);
+    return 0;
+}
+
+static int mainThreadJobs() {
+    std::atomic<uint32_t> elsewhere{ 0 }, ran{ 0 };
+    JobCounter counter;
+    for (int i = 0; i < 16; ++i) {
+        // queued from workers as well, they still end up on the main thread
+        JobSystem::run([&]() {
+            JobSystem::runOnMainThread([&]() {
+                if (JobSystem::getThreadIndex() != 0)
+                    elsewhere++;
+                ran++;
+            }, &counter);
+        }, &counter);
+    }
+    JobSystem::wait(counter);
+    CHECK(ran == 16);
+    CHECK(elsewhere == 0);
+
+    // without a wait they run in update
+    JobSystem::runOnMainThread([&ran]() { ran++; });
+    JobSystem::update();
+    CHECK(ran == 17);
+    return 0;
+}
+
+static int nestedWaits() {
+    // more waiting jobs than threads, the waits have to run other jobs instead of blocking their thread
+    std::atomic<uint32_t> leaves{ 0 };
+    JobCounter outer;
+    for (int i = 0; i < 16; ++i) {
+        JobSystem::run([&leaves]() {
+            JobCounter inner;
+            for (int j = 0; j < 16; ++j)
+                JobSystem::run([&leaves]() { leaves++; }, &inner);
+            JobSystem::wait(inner);
+        }, &outer);
+    }
+    JobSystem::wait(outer);
+    CHECK(leaves == 256);
+    return 0;
+}
+
+static int shutdownDrainsQueue() {
+    // nothing waits on these, shutdown still runs them and the jobs they queue
+    std::atomic<uint32_t> ran{ 0 };
+    for (int i = 0; i < 32; ++i) {
+        JobSystem::run([&ran]() {
+            ran++;
+            JobSystem::run([&ran]() { ran++; });
+            JobSystem::runOnMainThread([&ran]() { ran++; });
+        });
+    }
+    JobSystem::shutdown();
+    CHECK(ran == 96);
+
+    JobSystem::init(3);
+    return 0;
+}
+
+static int runTests() {
+    RUN_TEST(threadIndices);
+    RUN_TEST(parallelForCoversEveryIndex);
+    RUN_TEST(dependencies);
+    RUN_TEST(mainThreadJobs);
+    RUN_TEST(nestedWaits);
+    RUN_TEST(shutdownDrainsQueue);
+    return 0;
+}
+
+int main() {
+    Log::init();
+    JobSystem::init(3);
+
+    // the workers are stopped after a failed check too, the process would hang on exit otherwise
+    int result = runTests();
+    JobSystem::shutdown();
+    return result;
+}
@@ -0,0 +1,71 @@
+#ifndef ENGINE_TESTUTILS_H
+#define ENGINE_TESTUTILS_H
+
+// Shared by the test executables: each test is a function returning 0 on success, main runs them in order
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// ctest reports a test that exits with it as skipped, see SKIP_RETURN_CODE in CMakeLists.txt
+#define DM_TEST_SKIPPED 77
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            return 1; \
+        } \
+    } while (0)
+
+#define RUN_TEST(test) \
+    do { \
+        std::printf("%s\n", #test); \
+        std::fflush(stdout); \
+        if (test() != 0) \
+            return 1; \
+    } while (0)
+
+namespace DeimosTests {
+    // a fresh directory under the system temp directory, removed with the object
+    class TempDirectory {
+    public:
+        explicit TempDirectory(const std::string& name)
+            : m_path(std::filesystem::temp_directory_path() / name) {
+            std::filesystem::remove_all(m_path);
+            std::filesystem::create_directories(m_path);
+        }
+        ~TempDirectory() {
+            std::error_code error;
+            std::filesystem::remove_all(m_path, error);
+        }
+
+        std::string file(const std::string& name) const { return (m_path / name).string(); }
+    private:
+        std::filesystem::path m_path;
+    };
+
+    inline std::vector<uint8_t> readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    inline bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+        std::ofstream file(path, std::ios::binary);
+        file.write((const char*) data.data(), (std::streamsize) data.size());
+        return (bool) file;
+    }
+
+    template<typename T>
+    inline void writeAt(std::vector<uint8_t>& data, size_t offset, T value) {
+        std::memcpy(data.data() + offset, &value, sizeof(value));
+    }
+}
+
+
+#endif //ENGINE_TESTUTILS_H
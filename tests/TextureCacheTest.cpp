@@ -0,0 +1,68 @@
+// A texture drawn in an ended scene is referenced by nobody but the cache, so trimming over the budget evicts it.
+// Needs a headless GL context, skipped where none can be created
+
+#include "TestUtils.h"
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Core/Window.h"
+#include "Deimos/Renderer/Image.h"
+#include "Deimos/Renderer/OrthographicCamera.h"
+#include "Deimos/Renderer/Renderer.h"
+#include "Deimos/Renderer/Renderer2D.h"
+#include "Deimos/Renderer/TextureCache.h"
+
+using namespace Deimos;
+
+static bool writeImage(const std::string &path, uint8_t value) {
+    Image image(16, 16, 4);
+    std::memset(image.getData(), value, image.getSize());
+    return image.writeQOI(path);
+}
+
+static int drawnTextureIsEvicted(const std::string &drawnPath, const std::string &heldPath) {
+    Ref<Texture2D> drawn = TextureCache::get(drawnPath);
+    CHECK(drawn);
+
+    OrthographicCamera camera(-1.6f, 1.6f, -0.9f, 0.9f);
+    Renderer2D::beginScene(camera);
+    Renderer2D::drawQuad({ 0.f, 0.f }, { 1.f, 1.f }, drawn);
+    Renderer2D::endScene();
+    drawn.reset();
+
+    Ref<Texture2D> held = TextureCache::get(heldPath);
+    CHECK(held);
+    CHECK(TextureCache::getStats().residentTextures == 2);
+
+    TextureCache::setBudget(held->getMemorySize());
+    CHECK(TextureCache::getStats().evictions == 1);
+    CHECK(TextureCache::getStats().residentTextures == 1);
+    CHECK(TextureCache::get(heldPath) == held);
+    return 0;
+}
+
+int main() {
+    Log::init();
+    if (!Window::isHeadlessAvailable()) {
+        std::printf("skipped: no headless OpenGL 4.5 context available\n");
+        return DM_TEST_SKIPPED;
+    }
+
+    DeimosTests::TempDirectory directory("DeimosTextureCacheTest");
+    std::string drawnPath = directory.file("drawn.qoi");
+    std::string heldPath = directory.file("held.qoi");
+    if (!writeImage(drawnPath, 0x40) || !writeImage(heldPath, 0xc0)) {
+        std::printf("could not write the test images to %s\n", drawnPath.c_str());
+        return 1;
+    }
+
+    Scope<Window> window(Window::create(WindowProps("TextureCacheTest", 64, 64, true)));
+    Renderer::init();
+    Renderer2D::init();
+
+    int result = drawnTextureIsEvicted(drawnPath, heldPath);
+
+    TextureCache::clear();
+    Renderer2D::shutdown();
+    Renderer::shutdown();
+    return result;
+}
@@ -0,0 +1,245 @@
+// Offline asset cooker: writes a directory of assets into one .dmpak archive that Deimos::AssetPack maps at runtime.
+// Images are decoded to RGBA8 (with an optional mip chain), KTX2 / DDS containers keep their blocks, .glsl files are
+// split into their stages, everything else is stored as is
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Core/Hash.h"
+#include "Deimos/Core/JobSystem.h"
+#include "Deimos/Assets/AssetPackFormat.h"
+#include "Deimos/Renderer/CompressedImage.h"
+#include "Deimos/Renderer/MipmapGenerator.h"
+#include "Platform/OpenGL/OpenGLShader.h"
+
+using namespace Deimos;
+namespace fs = std::filesystem;
+
+struct CookedEntry {
+    std::string name;
+    AssetPackFormat::EntryType type = AssetPackFormat::EntryType::Raw;
+    uint32_t params[4] = {};
+    std::vector<uint8_t> data;
+};
+
+static void printUsage() {
+    std::printf("usage: DeimosAssetCooker [--mipmaps] [--align N] <output.dmpak> <directories or files...>\n"
+                "  entries are named by their path relative to the given directory (or the file name), e.g. textures/Logo.png\n");
+}
+
+static bool readFile(const fs::path& path, std::vector<uint8_t>& bytes) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in)
+        return false;
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static bool isImage(const std::string& extension) {
+    static const char* extensions[] = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".gif", ".hdr", ".pic", ".pnm", ".ppm", ".pgm", ".qoi", ".dmraw" };
+    for (const char* ext : extensions) {
+        if (extension == ext)
+            return true;
+    }
+    return false;
+}
+
+static bool cookImage(const fs::path& path, bool mipmaps, CookedEntry& entry) {
+    Image image = Image::load(path.string());
+    if (!image.isValid())
+        return false;
+    image.expandToRGBA(); // the same conversion the runtime loader applies
+
+    std::vector<Image> mips;
+    if (mipmaps)
+        mips = MipmapGenerator::generate(image);
+
+    entry.type = AssetPackFormat::EntryType::Texture;
+    entry.params[0] = (uint32_t) TextureFormat::RGBA8;
+    entry.params[1] = image.getWidth();
+    entry.params[2] = image.getHeight();
+    entry.params[3] = 1 + (uint32_t) mips.size();
+    entry.data.assign(image.getData(), image.getData() + image.getSize());
+    for (const Image& mip : mips)
+        entry.data.insert(entry.data.end(), mip.getData(), mip.getData() + mip.getSize());
+    return true;
+}
+
+static bool cookContainer(const fs::path& path, CookedEntry& entry) {
+    CompressedImage image = CompressedImage::load(path.string());
+    if (!image.isValid())
+        return false;
+
+    entry.type = AssetPackFormat::EntryType::Texture;
+    entry.params[0] = (uint32_t) image.getFormat();
+    entry.params[1] = image.getWidth();
+    entry.params[2] = image.getHeight();
+    entry.params[3] = image.getLevelCount();
+    entry.data.assign(image.getData(), image.getData() + image.getSize());
+    return true;
+}
+
+static bool cookShader(const fs::path& path, CookedEntry& entry) {
+    std::vector<uint8_t> bytes;
+    if (!readFile(path, bytes))
+        return false;
+
+    std::unordered_map<GLenum, std::string> sources = OpenGLShader::preprocess(std::string(bytes.begin(), bytes.end()));
+    if (!sources.count(GL_VERTEX_SHADER) || !sources.count(GL_FRAGMENT_SHADER)) {
+        std::fprintf(stderr, "'%s' needs a vertex and a fragment section\n", path.string().c_str());
+        return false;
+    }
+
+    const std::string& vertex = sources[GL_VERTEX_SHADER];
+    const std::string& fragment = sources[GL_FRAGMENT_SHADER];
+    entry.type = AssetPackFormat::EntryType::Shader;
+    entry.params[0] = (uint32_t) vertex.size();
+    entry.params[1] = (uint32_t) fragment.size();
+    entry.data.assign(vertex.begin(), vertex.end());
+    entry.data.insert(entry.data.end(), fragment.begin(), fragment.end());
+    return true;
+}
+
+static bool cook(const fs::path& path, const std::string& name, bool mipmaps, CookedEntry& entry) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char) std::tolower(c); });
+
+    entry.name = name;
+    if (CompressedImage::isContainer(path.string()))
+        return cookContainer(path, entry);
+    if (isImage(extension))
+        return cookImage(path, mipmaps, entry);
+    if (extension == ".glsl")
+        return cookShader(path, entry);
+    return readFile(path, entry.data);
+}
+
+static void pad(std::ofstream& out, uint64_t& offset, uint64_t alignment) {
+    static const char zeros[256] = {};
+    while (offset % alignment) {
+        uint64_t count = std::min<uint64_t>(alignment - offset % alignment, sizeof(zeros));
+        out.write(zeros, (std::streamsize) count);
+        offset += count;
+    }
+}
+
+static bool writePack(const std::string& path, std::vector<CookedEntry>& entries, uint32_t alignment) {
+    std::sort(entries.begin(), entries.end(), [](const CookedEntry& a, const CookedEntry& b) {
+        return fnv1a(a.name) < fnv1a(b.name);
+    });
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (fnv1a(entries[i - 1].name) == fnv1a(entries[i].name)) {
+            std::fprintf(stderr, "'%s' and '%s' have the same name hash\n", entries[i - 1].name.c_str(), entries[i].name.c_str());
+            return false;
+        }
+    }
+
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    if (!out) {
+        std::fprintf(stderr, "could not write '%s'\n", path.c_str());
+        return false;
+    }
+
+    AssetPackFormat::Header header = {};
+    memcpy(header.magic, AssetPackFormat::magic, sizeof(header.magic));
+    header.version = AssetPackFormat::version;
+    header.entryCount = (uint32_t) entries.size();
+    header.alignment = alignment;
+    out.write((const char*) &header, sizeof(header));
+    uint64_t offset = sizeof(header);
+
+    std::vector<AssetPackFormat::Entry> toc(entries.size());
+    std::string names;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        pad(out, offset, alignment);
+        toc[i].nameHash = fnv1a(entries[i].name);
+        toc[i].offset = offset;
+        toc[i].size = entries[i].data.size();
+        toc[i].nameOffset = (uint32_t) names.size();
+        toc[i].type = entries[i].type;
+        memcpy(toc[i].params, entries[i].params, sizeof(toc[i].params));
+        names += entries[i].name;
+        names += '\0';
+
+        out.write((const char*) entries[i].data.data(), (std::streamsize) entries[i].data.size());
+        offset += entries[i].data.size();
+    }
+
+    pad(out, offset, alignof(AssetPackFormat::Entry));
+    header.tocOffset = offset;
+    out.write((const char*) toc.data(), (std::streamsize) (toc.size() * sizeof(AssetPackFormat::Entry)));
+    offset += toc.size() * sizeof(AssetPackFormat::Entry);
+    header.namesOffset = offset;
+    out.write(names.data(), (std::streamsize) names.size());
+
+    out.seekp(0);
+    out.write((const char*) &header, sizeof(header));
+    return (bool) out;
+}
+
+int main(int argc, char **argv) {
+    Deimos::Log::init();
+
+    bool mipmaps = false;
+    uint32_t alignment = AssetPackFormat::defaultAlignment;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--mipmaps")) {
+            mipmaps = true;
+        } else if (!std::strcmp(argv[i], "--align") && i + 1 < argc) {
+            alignment = (uint32_t) std::strtoul(argv[++i], nullptr, 10);
+        } else if (argv[i][0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            positional.emplace_back(argv[i]);
+        }
+    }
+
+    // the table of contents that follows the data has to stay 8 byte aligned
+    if (positional.size() < 2 || alignment < 8 || (alignment & (alignment - 1))) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<std::pair<fs::path, std::string>> inputs;
+    for (size_t i = 1; i < positional.size(); ++i) {
+        fs::path root(positional[i]);
+        if (fs::is_directory(root)) {
+            for (const fs::directory_entry& file : fs::recursive_directory_iterator(root)) {
+                if (file.is_regular_file())
+                    inputs.emplace_back(file.path(), file.path().lexically_relative(root).generic_string());
+            }
+        } else {
+            inputs.emplace_back(root, root.filename().generic_string());
+        }
+    }
+
+    JobSystem::init();
+    std::vector<CookedEntry> entries(inputs.size());
+    uint32_t counts[3] = {};
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!cook(inputs[i].first, inputs[i].second, mipmaps, entries[i])) {
+            std::fprintf(stderr, "could not cook '%s'\n", inputs[i].first.string().c_str());
+            JobSystem::shutdown();
+            return 1;
+        }
+        counts[(uint32_t) entries[i].type]++;
+    }
+    JobSystem::shutdown();
+
+    if (!writePack(positional[0], entries, alignment))
+        return 1;
+
+    std::printf("cooked %zu entries (%u textures, %u shaders, %u raw) into %s (%ju bytes)\n", entries.size(),
+                counts[(uint32_t) AssetPackFormat::EntryType::Texture], counts[(uint32_t) AssetPackFormat::EntryType::Shader],
+                counts[(uint32_t) AssetPackFormat::EntryType::Raw], positional[0].c_str(), (uintmax_t) fs::file_size(positional[0]));
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Offline atlas packer: packs images into RGBA pages and writes the pages with a .atlas manifest,
+// the result is loaded with Deimos::TextureAtlas::load
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Renderer/TextureAtlasBuilder.h"
+
+static void printUsage() {
+    std::printf("usage: DeimosAtlasPacker [--page-size N] [--padding N] [--no-bleed] <output base path> <images...>\n"
+                "  writes <output>.atlas and <output>_<page>.tga, sprites are named after the file without extension\n");
+}
+
+// "assets/ui/button.png" -> "button"
+static std::string spriteName(const std::string& path) {
+    size_t begin = path.find_last_of("/\\") + 1;
+    size_t end = path.find_last_of('.');
+    if (end == std::string::npos || end < begin)
+        end = path.size();
+    return path.substr(begin, end - begin);
+}
+
+int main(int argc, char **argv) {
+    Deimos::Log::init();
+
+    Deimos::TextureAtlasSpecification spec;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--page-size") && i + 1 < argc) {
+            spec.pageSize = (uint32_t) std::strtoul(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--padding") && i + 1 < argc) {
+            spec.padding = (uint32_t) std::strtoul(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--no-bleed")) {
+            spec.bleed = false;
+        } else if (argv[i][0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            positional.emplace_back(argv[i]);
+        }
+    }
+
+    if (positional.size() < 2 || spec.pageSize == 0) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<Deimos::Image> images;
+    std::vector<Deimos::TextureAtlasBuilder::Entry> entries;
+    images.reserve(positional.size() - 1);
+    for (size_t i = 1; i < positional.size(); ++i) {
+        Deimos::Image image = Deimos::Image::load(positional[i]);
+        if (!image.isValid()) {
+            std::fprintf(stderr, "could not load '%s'\n", positional[i].c_str());
+            return 1;
+        }
+        images.push_back(std::move(image));
+    }
+    for (size_t i = 0; i < images.size(); ++i) {
+        entries.push_back({ spriteName(positional[i + 1]), &images[i] });
+    }
+
+    Deimos::TextureAtlasBuilder builder(spec);
+    uint32_t placed = builder.add(entries);
+    if (placed != entries.size()) {
+        std::fprintf(stderr, "%zu of %zu sprites could not be packed\n", entries.size() - placed, entries.size());
+        return 1;
+    }
+
+    if (!builder.save(positional[0])) {
+        std::fprintf(stderr, "could not write '%s'\n", positional[0].c_str());
+        return 1;
+    }
+
+    std::printf("packed %u sprites into %u page(s) of %ux%u\n", placed, builder.getPageCount(), spec.pageSize, spec.pageSize);
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Minimal microbenchmark harness in the spirit of Google Benchmark: benchmarks register themselves with
+// DM_BENCHMARK, run their measured loop under `while (state.keepRunning())` and the runner picks an iteration
+// count that fills the minimum time, repeats it and reports the median time per iteration
+
+#ifndef DEIMOS_BENCHMARK_H
+#define DEIMOS_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace Deimos::Bench {
+    class State {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit State(uint64_t iterations) : m_iterations(iterations), m_remaining(iterations) {
+        }
+
+        // the first call starts the clock, the one returning false stops it
+        inline bool keepRunning() {
+            if (m_remaining != 0) {
+                if (m_remaining-- == m_iterations)
+                    m_start = Clock::now();
+                return true;
+            }
+            m_elapsed += Clock::now() - m_start;
+            return false;
+        }
+
+        // for work inside the loop that isn't part of the measurement
+        inline void pauseTiming() { m_elapsed += Clock::now() - m_start; }
+        inline void resumeTiming() { m_start = Clock::now(); }
+
+        inline uint64_t getIterations() const { return m_iterations; }
+        inline double getElapsedSeconds() const { return std::chrono::duration<double>(m_elapsed).count(); }
+    private:
+        uint64_t m_iterations;
+        uint64_t m_remaining;
+        Clock::time_point m_start;
+        Clock::duration m_elapsed{ 0 };
+    };
+
+    using BenchmarkFn = void (*)(State&);
+
+    struct BenchmarkInfo {
+        const char* name;
+        BenchmarkFn fn;
+        bool needsGL; // run with a headless context and Renderer2D initialised
+    };
+
+    std::vector<BenchmarkInfo>& getBenchmarks();
+
+    struct Registrar {
+        Registrar(const char* name, BenchmarkFn fn, bool needsGL) {
+            getBenchmarks().push_back({ name, fn, needsGL });
+        }
+    };
+
+    // keeps the compiler from dropping a computation whose result is otherwise unused
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile void* sink = &value;
+        (void) sink;
+#endif
+    }
+}
+
+#define DM_BENCHMARK_REGISTER(function, name, needsGL) \
+    static void function(::Deimos::Bench::State& state); \
+    static ::Deimos::Bench::Registrar function##Registrar(name, function, needsGL); \
+    static void function(::Deimos::Bench::State& state)
+
+#define DM_BENCHMARK(function, name) DM_BENCHMARK_REGISTER(function, name, false)
+#define DM_BENCHMARK_GL(function, name) DM_BENCHMARK_REGISTER(function, name, true)
+
+#endif //DEIMOS_BENCHMARK_H
@@ -0,0 +1,224 @@
+// Benchmarks that need no graphics context: events, layers, buffer layouts, shader preprocessing and the profiler
+
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Core/LayerStack.h"
+#include "Deimos/Events/ApplicationEvent.h"
+#include "Deimos/Events/KeyEvent.h"
+#include "Deimos/Debug/Instrumentor.h"
+#include "Deimos/Renderer/Buffer.h"
+#include "Platform/OpenGL/OpenGLShader.h"
+
+using namespace Deimos;
+
+// ----- BufferLayout -----
+
+DM_BENCHMARK(bufferLayoutQuadVertex, "BufferLayout/construct Renderer2D quad vertex") {
+    while (state.keepRunning()) {
+        BufferLayout layout = {
+            { ShaderDataType::Float3, "a_position" },
+            { ShaderDataType::Float4, "a_color" },
+            { ShaderDataType::Float2, "a_texCoord" },
+            { ShaderDataType::Float,  "a_texID" },
+            { ShaderDataType::Float,  "a_texLayer" }
+        };
+        Bench::doNotOptimize(layout.getStride());
+    }
+}
+
+DM_BENCHMARK(bufferLayoutPosition, "BufferLayout/construct position only") {
+    while (state.keepRunning()) {
+        BufferLayout layout = { { ShaderDataType::Float3, "a_position" } };
+        Bench::doNotOptimize(layout.getStride());
+    }
+}
+
+// ----- EventDispatcher -----
+
+namespace {
+    // handlers bound the way Application::onEvent binds its own
+    struct EventTarget {
+        uint64_t handled = 0;
+
+        bool onWindowClose(WindowCloseEvent &/*e*/) { handled++; return true; }
+        bool onWindowResize(WindowResizeEvent &e) { handled += e.getWidth(); return false; }
+
+        void onEvent(Event &e) {
+            EventDispatcher dispatcher(e);
+            dispatcher.dispatch<WindowCloseEvent>(std::bind(&EventTarget::onWindowClose, this, std::placeholders::_1));
+            dispatcher.dispatch<WindowResizeEvent>(std::bind(&EventTarget::onWindowResize, this, std::placeholders::_1));
+        }
+    };
+}
+
+DM_BENCHMARK(eventDispatchMatch, "EventDispatcher/dispatch, second handler matches") {
+    EventTarget target;
+    WindowResizeEvent event(1280, 720);
+    while (state.keepRunning())
+        target.onEvent(event);
+    Bench::doNotOptimize(target.handled);
+}
+
+DM_BENCHMARK(eventDispatchMiss, "EventDispatcher/dispatch, no handler matches") {
+    EventTarget target;
+    KeyPressedEvent event(65, 0);
+    while (state.keepRunning())
+        target.onEvent(event);
+    Bench::doNotOptimize(target.handled);
+}
+
+// ----- LayerStack -----
+
+namespace {
+    class CountingLayer : public Layer {
+    public:
+        CountingLayer(uint64_t &updates) : Layer("CountingLayer"), m_updates(updates) {}
+
+        void onUpdate(Timestep /*timestep*/) override { m_updates++; }
+    private:
+        uint64_t &m_updates;
+    };
+}
+
+static void iterateLayerStack(Bench::State &state, uint32_t layers, uint32_t overlays) {
+    uint64_t updates = 0;
+    LayerStack stack;
+    for (uint32_t i = 0; i < layers; ++i)
+        stack.pushLayer(new CountingLayer(updates));
+    for (uint32_t i = 0; i < overlays; ++i)
+        stack.pushOverlay(new CountingLayer(updates));
+
+    Timestep timestep(1.f / 60.f);
+    while (state.keepRunning()) {
+        for (Layer *layer : stack)
+            layer->onUpdate(timestep);
+    }
+    Bench::doNotOptimize(updates);
+}
+
+DM_BENCHMARK(layerStack4, "LayerStack/onUpdate over 3 layers + 1 overlay") {
+    iterateLayerStack(state, 3, 1);
+}
+
+DM_BENCHMARK(layerStack32, "LayerStack/onUpdate over 30 layers + 2 overlays") {
+    iterateLayerStack(state, 30, 2);
+}
+
+// ----- OpenGLShader::preprocess -----
+
+static const std::string s_shaderSource = R"(
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec4 a_color;
+layout(location = 2) in vec2 a_texCoord;
+layout(location = 3) in float a_texID;
+layout(location = 4) in float a_texLayer;
+
+uniform mat4 u_viewProjection;
+
+out vec4 v_color;
+out vec2 v_texCoord;
+out flat float v_texID;
+out flat float v_texLayer;
+
+void main() {
+    v_color = a_color;
+    v_texCoord = a_texCoord;
+    v_texID = a_texID;
+    v_texLayer = a_texLayer;
+    gl_Position = u_viewProjection * vec4(a_position, 1.0);
+}
+
+#type fragment
+#version 450 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_color;
+in vec2 v_texCoord;
+in flat float v_texID;
+in flat float v_texLayer;
+
+uniform sampler2D u_textures[16];
+uniform sampler2DArray u_textureArray;
+
+void main() {
+    if (v_texLayer >= 0.0)
+        color = texture(u_textureArray, vec3(v_texCoord, v_texLayer)) * v_color;
+    else
+        color = texture(u_textures[int(v_texID)], v_texCoord) * v_color;
+}
+)";
+
+DM_BENCHMARK(shaderPreprocess, "OpenGLShader/preprocess two stages") {
+    while (state.keepRunning()) {
+        auto sources = OpenGLShader::preprocess(s_shaderSource);
+        Bench::doNotOptimize(sources.size());
+    }
+}
+
+// ----- Instrumentor -----
+
+DM_BENCHMARK(instrumentorIdle, "Instrumentor/scope, not recording") {
+    while (state.keepRunning()) {
+        DM_PROFILE_SCOPE("bench scope");
+    }
+}
+
+// the writer thread gets a moment to empty the buffer every few thousand scopes, otherwise the cheaper path of
+// dropping events on a full buffer would be measured
+static void recordWithSession(Bench::State &state, bool counter) {
+    std::string path = (std::filesystem::temp_directory_path() / "DeimosBench-trace.json").string();
+    Instrumentor::get().beginSession("DeimosBench", path);
+
+    uint64_t i = 0;
+    while (state.keepRunning()) {
+        if (counter) {
+            DM_PROFILE_COUNTER("bench counter", i);
+        } else {
+            DM_PROFILE_SCOPE("bench scope");
+        }
+        if ((++i & 4095) == 0) {
+            state.pauseTiming();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            state.resumeTiming();
+        }
+    }
+
+    Instrumentor::get().endSession();
+    std::remove(path.c_str());
+}
+
+DM_BENCHMARK(instrumentorRecording, "Instrumentor/scope, recording") {
+    recordWithSession(state, false);
+}
+
+DM_BENCHMARK(instrumentorCounter, "Instrumentor/counter, recording") {
+    recordWithSession(state, true);
+}
+
+DM_BENCHMARK(instrumentorMasked, "Instrumentor/scope, recording with its category masked out") {
+    std::string path = (std::filesystem::temp_directory_path() / "DeimosBench-trace.json").string();
+    Instrumentor &instrumentor = Instrumentor::get();
+    uint32_t mask = instrumentor.getCategoryMask();
+    instrumentor.setCategoryMask(mask & ~(uint32_t) ProfileCategory::User);
+    instrumentor.beginSession("DeimosBench", path);
+
+    while (state.keepRunning()) {
+        DM_PROFILE_SCOPE("bench scope");
+    }
+
+    instrumentor.endSession();
+    instrumentor.setCategoryMask(mask);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,114 @@
+// Renderer2D benchmarks, one primitive per iteration. The batch flushes whenever it fills up, so the time includes
+// the vertex generation and a share of the draw call that submits it
+
+#include <vector>
+
+#include "Benchmark.h"
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Renderer/OrthographicCamera.h"
+#include "Deimos/Renderer/Renderer2D.h"
+#include "Deimos/Renderer/SubTexture2D.h"
+#include "Deimos/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+using namespace Deimos;
+
+static const glm::vec4 s_color = { 0.8f, 0.2f, 0.3f, 1.0f };
+
+// positions vary a little so nothing about the vertices is constant
+static inline glm::vec2 positionOf(uint64_t i) {
+    return { (float) (i & 63) * 0.01f - 0.3f, (float) ((i >> 6) & 63) * 0.01f - 0.3f };
+}
+
+template<typename Draw>
+static void drawEach(Bench::State &state, Draw &&draw) {
+    OrthographicCamera camera(-1.6f, 1.6f, -0.9f, 0.9f);
+    Renderer2D::beginScene(camera);
+    uint64_t i = 0;
+    while (state.keepRunning())
+        draw(i++);
+    Renderer2D::endScene();
+}
+
+DM_BENCHMARK_GL(drawQuadColor, "Renderer2D/drawQuad color") {
+    drawEach(state, [](uint64_t i) { Renderer2D::drawQuad(positionOf(i), { 0.1f, 0.1f }, s_color); });
+}
+
+DM_BENCHMARK_GL(drawRotatedQuadColor, "Renderer2D/drawRotatedQuad color") {
+    drawEach(state, [](uint64_t i) { Renderer2D::drawRotatedQuad(positionOf(i), { 0.1f, 0.1f }, s_color, (float) (i & 255) * 0.1f); });
+}
+
+DM_BENCHMARK_GL(drawTriangle, "Renderer2D/drawTriangle") {
+    drawEach(state, [](uint64_t i) { Renderer2D::drawTriangle(positionOf(i), { 0.1f, 0.1f }, s_color); });
+}
+
+DM_BENCHMARK_GL(drawLine, "Renderer2D/drawLine") {
+    drawEach(state, [](uint64_t i) {
+        glm::vec2 start = positionOf(i);
+        Renderer2D::drawLine(start, start + glm::vec2(0.2f, 0.1f), 0.01f, s_color);
+    });
+}
+
+DM_BENCHMARK_GL(drawCircle32, "Renderer2D/drawCircle 32 vertices") {
+    drawEach(state, [](uint64_t i) { Renderer2D::drawCircle(positionOf(i), 0.05f, 32, s_color); });
+}
+
+DM_BENCHMARK_GL(drawOval, "Renderer2D/drawOval") {
+    drawEach(state, [](uint64_t i) { Renderer2D::drawOval(positionOf(i), 0.1f, 0.05f, (float) (i & 255) * 0.1f, s_color); });
+}
+
+DM_BENCHMARK_GL(drawPolygon8, "Renderer2D/drawPolygon 8 vertices") {
+    std::vector<glm::vec3> vertices;
+    for (int v = 0; v < 8; ++v) {
+        float angle = (float) v / 8.f * 6.2831853f;
+        vertices.emplace_back(0.1f * glm::cos(angle), 0.1f * glm::sin(angle), 0.f);
+    }
+    drawEach(state, [&](uint64_t i) {
+        vertices[0].x = 0.1f + (float) (i & 7) * 0.001f;
+        Renderer2D::drawPolygon(vertices.data(), (int) vertices.size(), s_color);
+    });
+}
+
+DM_BENCHMARK_GL(drawBezier, "Renderer2D/drawBezier") {
+    drawEach(state, [](uint64_t i) {
+        glm::vec2 start = positionOf(i);
+        Renderer2D::drawBezier({ start, 0.f }, { start.x + 0.1f, start.y + 0.2f, 0.f }, { start.x + 0.2f, start.y, 0.f }, s_color);
+    });
+}
+
+// ----- texture slot lookup -----
+
+static void drawTextured(Bench::State &state, uint32_t textureCount) {
+    std::vector<Ref<Texture>> textures;
+    for (uint32_t t = 0; t < textureCount; ++t)
+        textures.push_back(Texture2D::create(1, 1));
+
+    drawEach(state, [&](uint64_t i) { Renderer2D::drawQuad(positionOf(i), { 0.1f, 0.1f }, textures[i % textureCount]); });
+}
+
+DM_BENCHMARK_GL(drawQuadTexture1, "Renderer2D/drawQuad texture, 1 texture bound") {
+    drawTextured(state, 1);
+}
+
+DM_BENCHMARK_GL(drawQuadTexture8, "Renderer2D/drawQuad texture, cycling 8 textures") {
+    drawTextured(state, 8);
+}
+
+DM_BENCHMARK_GL(drawQuadTexture15, "Renderer2D/drawQuad texture, cycling 15 textures") {
+    // with the white texture these fill 16 slots, the fewest GL guarantees. The slot path gets up to 32 units minus
+    // the array slots from the device, so whether this flushes depends on it, and bindless never runs out of slots
+    drawTextured(state, 15);
+}
+
+DM_BENCHMARK_GL(drawQuadSubTexture, "Renderer2D/drawQuad subtexture") {
+    Ref<Texture2D> sheet = Texture2D::create(64, 64);
+    Ref<SubTexture2D> cell = SubTexture2D::createFromPixels(sheet, { 16.f, 16.f }, { 16.f, 16.f });
+    drawEach(state, [&](uint64_t i) { Renderer2D::drawQuad(positionOf(i), { 0.1f, 0.1f }, cell); });
+}
+
+DM_BENCHMARK_GL(drawQuadTextureArray, "Renderer2D/drawQuad texture array layer") {
+    Ref<Texture2DArray> array = Texture2DArray::create(4, 4, 8);
+    drawEach(state, [&](uint64_t i) { Renderer2D::drawQuad(positionOf(i), { 0.1f, 0.1f }, array, (uint32_t) (i & 7)); });
+}
@@ -0,0 +1,180 @@
+// Microbenchmarks of the engine's hot paths. Prints a table and writes the results as JSON (the layout of Google
+// Benchmark's, so its compare.py can diff two runs). Renderer benchmarks draw into a headless context
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Core/Window.h"
+#include "Deimos/Debug/Instrumentor.h"
+#include "Deimos/Renderer/PixelKernels.h"
+#include "Deimos/Renderer/Renderer.h"
+#include "Deimos/Renderer/Renderer2D.h"
+
+using namespace Deimos;
+
+namespace Deimos::Bench {
+    std::vector<BenchmarkInfo> &getBenchmarks() {
+        static std::vector<BenchmarkInfo> benchmarks;
+        return benchmarks;
+    }
+}
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations;
+    uint32_t repetitions;
+    double median, min, max; // nanoseconds per iteration
+};
+
+static void printUsage() {
+    std::printf("usage: DeimosBench [--filter TEXT] [--min-time SECONDS] [--repetitions N] [--out FILE] [--no-gl] [--list]\n"
+                "  runs every benchmark whose name contains TEXT, each repetition lasts at least SECONDS (0.1),\n"
+                "  the median of N (5) repetitions is reported, JSON goes to FILE (DeimosBench.json)\n");
+}
+
+static double runOnce(const Bench::BenchmarkInfo &benchmark, uint64_t iterations) {
+    Bench::State state(iterations);
+    benchmark.fn(state);
+    return state.getElapsedSeconds();
+}
+
+static BenchResult run(const Bench::BenchmarkInfo &benchmark, double minTime, uint32_t repetitions) {
+    // grows the count until one run fills the minimum time
+    uint64_t iterations = 1;
+    double seconds = runOnce(benchmark, iterations);
+    while (seconds < minTime && iterations < (1ull << 40)) {
+        double scale = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+        iterations = std::max(iterations + 1, (uint64_t) ((double) iterations * std::min(scale, 10.0)));
+        seconds = runOnce(benchmark, iterations);
+    }
+
+    std::vector<double> times;
+    for (uint32_t i = 0; i < repetitions; ++i)
+        times.push_back(runOnce(benchmark, iterations) * 1e9 / (double) iterations);
+    std::sort(times.begin(), times.end());
+
+    return { benchmark.name, iterations, repetitions, times[times.size() / 2], times.front(), times.back() };
+}
+
+static std::string escape(const std::string &text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+static bool writeJson(const std::string &path, const char *executable, const std::vector<BenchResult> &results) {
+    std::ofstream out(path);
+    if (!out) {
+        DM_CORE_ERROR("Could not open '{0}' for writing", path);
+        return false;
+    }
+
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"executable\": \"" << escape(executable) << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\",\n";
+#else
+    out << "    \"library_build_type\": \"debug\",\n";
+#endif
+    out << "    \"profile_level\": " << DM_PROFILE_LEVEL << ",\n";
+    out << "    \"simd\": \"" << PixelKernels::getLevelName(PixelKernels::getSupportedLevel()) << "\"\n";
+    out << "  },\n  \"benchmarks\": [\n";
+    // only wall time is measured, cpu_time repeats it for tools that expect both
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &result = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"run_type\": \"iteration\", \"repetitions\": %u, \"iterations\": %llu, "
+                      "\"real_time\": %.3f, \"cpu_time\": %.3f, \"min_time_ns\": %.3f, \"max_time_ns\": %.3f, \"time_unit\": \"ns\"}%s\n",
+                      escape(result.name).c_str(), result.repetitions, (unsigned long long) result.iterations,
+                      result.median, result.median, result.min, result.max, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return (bool) out;
+}
+
+int main(int argc, char **argv) {
+    Deimos::Log::init();
+
+    std::string filter;
+    std::string outPath = "DeimosBench.json";
+    double minTime = 0.1;
+    uint32_t repetitions = 5;
+    bool useGL = true, list = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (!std::strcmp(argv[i], "--min-time") && i + 1 < argc) {
+            minTime = std::max(0.001, std::strtod(argv[++i], nullptr));
+        } else if (!std::strcmp(argv[i], "--repetitions") && i + 1 < argc) {
+            repetitions = std::max(1u, (uint32_t) std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--no-gl")) {
+            useGL = false;
+        } else if (!std::strcmp(argv[i], "--list")) {
+            list = true;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::vector<Bench::BenchmarkInfo> selected;
+    for (const Bench::BenchmarkInfo &benchmark : Bench::getBenchmarks()) {
+        if ((useGL || !benchmark.needsGL) && std::string(benchmark.name).find(filter) != std::string::npos)
+            selected.push_back(benchmark);
+    }
+    std::sort(selected.begin(), selected.end(), [](const auto &a, const auto &b) { return std::strcmp(a.name, b.name) < 0; });
+
+    if (list) {
+        for (const Bench::BenchmarkInfo &benchmark : selected)
+            std::printf("%s%s\n", benchmark.name, benchmark.needsGL ? " (gl)" : "");
+        return 0;
+    }
+
+    // one context for every renderer benchmark, as an application would have
+    Scope<Window> window;
+    if (std::any_of(selected.begin(), selected.end(), [](const auto &benchmark) { return benchmark.needsGL; })) {
+        window.reset(Window::create(WindowProps("DeimosBench", 1280, 720, true)));
+        Renderer::init();
+        Renderer2D::init();
+    }
+
+    std::printf("%-60s %14s %12s %12s %12s\n", "benchmark", "iterations", "median ns", "min ns", "max ns");
+    std::vector<BenchResult> results;
+    for (const Bench::BenchmarkInfo &benchmark : selected) {
+        BenchResult result = run(benchmark, minTime, repetitions);
+        std::printf("%-60s %14llu %12.2f %12.2f %12.2f\n", result.name.c_str(), (unsigned long long) result.iterations,
+                    result.median, result.min, result.max);
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+
+    if (window) {
+        Renderer2D::shutdown();
+        Renderer::shutdown();
+    }
+    return writeJson(outPath, argv[0], results) ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+// Decode throughput benchmark: times the pixel kernels at every SIMD level the CPU supports (checked against the
+// scalar result), then decodes the given images as textures are loaded, on one core and across the job system
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Core/JobSystem.h"
+#include "Deimos/Renderer/Image.h"
+#include "Deimos/Renderer/PixelKernels.h"
+
+using namespace Deimos;
+
+static void printUsage() {
+    std::printf("usage: DeimosDecodeBench [--threads N] [--iterations N] [images...]\n"
+                "  without images only the kernels are measured, N threads defaults to the hardware concurrency\n");
+}
+
+// best of the runs, in seconds
+static double timeBest(uint32_t iterations, const std::function<void()>& fn) {
+    double best = 1e30;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+static double megabytesPerSecond(size_t bytes, double seconds) {
+    return (double) bytes / (1024.0 * 1024.0) / seconds;
+}
+
+static bool benchKernels(uint32_t iterations) {
+    const uint32_t width = 2048, height = 2048;
+    const size_t pixelCount = (size_t) width * height;
+
+    std::mt19937 random(1234);
+    std::vector<uint8_t> rgb(pixelCount * 3);
+    std::vector<uint8_t> alphaSource(pixelCount * 4);
+    for (uint8_t& value : rgb)
+        value = (uint8_t) random();
+    for (uint8_t& value : alphaSource)
+        value = (uint8_t) random();
+
+    // scalar results to compare the SIMD kernels with
+    PixelKernels::setLevel(SimdLevel::Scalar);
+    std::vector<uint8_t> expected(pixelCount * 4);
+    std::vector<uint8_t> expectedPremultiplied = alphaSource;
+    PixelKernels::premultiplyAlpha(expectedPremultiplied.data(), pixelCount);
+
+    bool ok = true;
+    std::vector<uint8_t> rgba(pixelCount * 4);
+    std::printf("%-8s %14s %14s %14s   (MB/s of input, 1 core, %ux%u)\n", "kernel", "flip", "rgb->rgba", "premultiply", width, height);
+    for (int level = 0; level <= (int) PixelKernels::getSupportedLevel(); ++level) {
+        PixelKernels::setLevel((SimdLevel) level);
+
+        double flip = timeBest(iterations, [&] { PixelKernels::flipVertically(rgb.data(), (size_t) width * 3, height); });
+        double expand = timeBest(iterations, [&] { PixelKernels::expandRGBToRGBA(rgb.data(), rgba.data(), pixelCount); });
+        // the flips leave rgb upside down or not, the reference is taken from whatever it is now
+        PixelKernels::setLevel(SimdLevel::Scalar);
+        PixelKernels::expandRGBToRGBA(rgb.data(), expected.data(), pixelCount);
+        PixelKernels::setLevel((SimdLevel) level);
+        PixelKernels::expandRGBToRGBA(rgb.data(), rgba.data(), pixelCount);
+        if (memcmp(rgba.data(), expected.data(), rgba.size()) != 0) {
+            std::fprintf(stderr, "%s rgb->rgba differs from the scalar kernel\n", PixelKernels::getLevelName((SimdLevel) level));
+            ok = false;
+        }
+
+        double premultiply = timeBest(iterations, [&] {
+            memcpy(rgba.data(), alphaSource.data(), rgba.size());
+            PixelKernels::premultiplyAlpha(rgba.data(), pixelCount);
+        });
+        if (memcmp(rgba.data(), expectedPremultiplied.data(), rgba.size()) != 0) {
+            std::fprintf(stderr, "%s premultiply differs from the scalar kernel\n", PixelKernels::getLevelName((SimdLevel) level));
+            ok = false;
+        }
+
+        std::printf("%-8s %14.0f %14.0f %14.0f\n", PixelKernels::getLevelName((SimdLevel) level),
+                    megabytesPerSecond(rgb.size(), flip), megabytesPerSecond(rgb.size(), expand),
+                    megabytesPerSecond(rgba.size(), premultiply));
+    }
+
+    PixelKernels::setLevel(PixelKernels::getSupportedLevel());
+    return ok;
+}
+
+static void benchDecode(const std::vector<std::string>& paths, uint32_t threads, uint32_t iterations) {
+    ImageLoadOptions options;
+    options.expandToRGBA = true; // as textures are loaded
+
+    size_t decodedBytes = 0;
+    for (const Image& image : Image::loadBatch(paths, options))
+        decodedBytes += image.getSize();
+    if (!decodedBytes) {
+        std::fprintf(stderr, "none of the images could be decoded\n");
+        return;
+    }
+
+    std::printf("\ndecoding %zu image(s), %.1f MB of RGBA (%s kernels)\n", paths.size(), decodedBytes / (1024.0 * 1024.0),
+                PixelKernels::getLevelName(PixelKernels::getLevel()));
+    std::printf("%-8s %14s %14s\n", "cores", "MB/s", "MB/s per core");
+    std::vector<uint32_t> coreCounts = { 1 };
+    if (threads > 1)
+        coreCounts.push_back(threads);
+
+    for (uint32_t cores : coreCounts) {
+        // the calling thread decodes too, so cores - 1 workers. Without the job system the batch runs inline
+        if (cores > 1)
+            JobSystem::init(cores - 1);
+        double seconds = timeBest(iterations, [&] { Image::loadBatch(paths, options); });
+        JobSystem::shutdown();
+        double total = megabytesPerSecond(decodedBytes, seconds);
+        std::printf("%-8u %14.1f %14.1f\n", cores, total, total / cores);
+    }
+}
+
+int main(int argc, char **argv) {
+    Deimos::Log::init();
+
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t iterations = 5;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) {
+            threads = std::max(1u, (uint32_t) std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--iterations") && i + 1 < argc) {
+            iterations = std::max(1u, (uint32_t) std::strtoul(argv[++i], nullptr, 10));
+        } else if (argv[i][0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            paths.emplace_back(argv[i]);
+        }
+    }
+
+    bool ok = benchKernels(iterations);
+    if (!paths.empty())
+        benchDecode(paths, threads, iterations);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+// Offline image converter: rewrites images as QOI or raw (.dmraw) files, which Texture2D loads without stb_image.
+// Several inputs can be converted in one run, each output is named after its input with the new extension
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Core/JobSystem.h"
+#include "Deimos/Renderer/Image.h"
+
+using namespace Deimos;
+namespace fs = std::filesystem;
+
+static void printUsage() {
+    std::printf("usage: DeimosImageConverter [--format qoi|raw] [--premultiply] [--out-dir DIR] <images...>\n"
+                "  qoi is the default, raw files are stored as RGBA8, the outputs go next to the inputs without --out-dir\n");
+}
+
+int main(int argc, char **argv) {
+    Log::init();
+
+    bool raw = false;
+    ImageLoadOptions options;
+    fs::path outputDirectory;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--format") && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (name == "qoi") raw = false;
+            else if (name == "raw") raw = true;
+            else {
+                std::fprintf(stderr, "unknown format '%s'\n", name.c_str());
+                return 1;
+            }
+        } else if (!std::strcmp(argv[i], "--premultiply")) {
+            options.premultiplyAlpha = true;
+        } else if (!std::strcmp(argv[i], "--out-dir") && i + 1 < argc) {
+            outputDirectory = argv[++i];
+        } else if (argv[i][0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            inputs.emplace_back(argv[i]);
+        }
+    }
+
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+    if (!outputDirectory.empty())
+        fs::create_directories(outputDirectory);
+
+    // raw files are uploaded as they are, so they hold what the texture loaders would produce. Premultiplying
+    // needs the alpha channel as well
+    options.expandToRGBA = raw || options.premultiplyAlpha;
+
+    // the calling thread decodes too
+    JobSystem::init();
+    std::vector<Image> images = Image::loadBatch(inputs, options);
+    JobSystem::shutdown();
+
+    int failed = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const Image &image = images[i];
+        if (!image.isValid()) {
+            std::fprintf(stderr, "could not load '%s'\n", inputs[i].c_str());
+            ++failed;
+            continue;
+        }
+
+        fs::path output = fs::path(inputs[i]).replace_extension(raw ? ".dmraw" : ".qoi");
+        if (!outputDirectory.empty())
+            output = outputDirectory / output.filename();
+        if (!(raw ? image.writeRaw(output.string()) : image.writeQOI(output.string()))) {
+            std::fprintf(stderr, "could not write '%s'\n", output.string().c_str());
+            ++failed;
+            continue;
+        }
+
+        std::printf("%s: %ux%u, %u channel(s), %ju bytes\n", output.string().c_str(), image.getWidth(), image.getHeight(),
+                    image.getChannels(), (uintmax_t) fs::file_size(output));
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,398 @@
+// Throughput stress test: draws procedurally generated scenes of one primitive type and raises the count each step
+// until the frame-time target is missed, then narrows down the highest count that holds it. Reports the sustained
+// primitives per frame and per second for every primitive type and texture backend, as a table and as JSON
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Core/Window.h"
+#include "Deimos/Debug/FrameStats.h"
+#include "Deimos/Events/ApplicationEvent.h"
+#include "Deimos/Renderer/OrthographicCamera.h"
+#include "Deimos/Renderer/RenderCommand.h"
+#include "Deimos/Renderer/Renderer.h"
+#include "Deimos/Renderer/Renderer2D.h"
+#include "Deimos/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+using namespace Deimos;
+
+enum class PrimitiveType {
+    Quad, RotatedQuad, TexturedQuad, Circle, Line, Polygon
+};
+
+static const char *s_typeNames[] = { "quad", "rotated", "textured", "circle", "line", "polygon" };
+static const uint32_t s_typeCount = 6;
+
+static const int s_circleVertices = 32;
+static const int s_polygonVertices = 6;
+
+struct StressSettings {
+    float targetMs = 1000.f / 60.f; // the p95 frame time has to stay at or below it
+    uint32_t startCount = 1000;
+    uint32_t maxCount = 4'000'000;
+    float growth = 2.f;
+    uint32_t refineSteps = 4; // bisections between the last passing and the first failing count
+    uint32_t warmupFrames = 10;
+    uint32_t frames = 60;     // measured per step
+    uint32_t textureCount = 8;
+    float size = 0.02f;       // world units, the view is 2 units high
+    bool headless = false;
+    std::vector<PrimitiveType> types;
+    std::vector<bool> backends; // bindless or not
+    std::string outPath = "DeimosStress.json";
+};
+
+struct StepResult {
+    uint32_t count = 0;
+    FrameTimeSummary frameTime;
+    uint32_t drawCalls = 0; // per frame
+};
+
+struct StressResult {
+    PrimitiveType type = PrimitiveType::Quad;
+    std::string backend;
+    StepResult sustained; // count 0 when even the first step missed the target
+    bool capped = false;  // maxCount still held the target
+};
+
+static void printUsage() {
+    std::printf("usage: DeimosStress [--target-ms MS] [--start N] [--max N] [--growth FACTOR] [--refine STEPS]\n"
+                "                    [--frames N] [--warmup N] [--textures N] [--size UNITS] [--types LIST]\n"
+                "                    [--backend slots|bindless|all] [--headless] [--out FILE]\n"
+                "  ramps each primitive type (quad,rotated,textured,circle,line,polygon) from N (1000) by FACTOR (2)\n"
+                "  until the p95 frame time of N (60) frames goes over MS (16.67), then refines the sustained count\n");
+}
+
+// one scene per step, the same seed each time so the steps only differ in count
+class StressScene {
+public:
+    StressScene(PrimitiveType type, uint32_t count, float size, float aspect,
+                const std::vector<Ref<Texture>> &textures) : m_type(type), m_size(size), m_textures(textures) {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(-aspect, aspect), y(-1.f, 1.f), unit(0.f, 1.f);
+
+        m_instances.resize(count);
+        for (Instance &instance : m_instances) {
+            instance.position = { x(random), y(random) };
+            instance.color = { unit(random), unit(random), unit(random), 1.f };
+            instance.rotation = unit(random) * 6.2831853f;
+            instance.texture = (uint32_t) (unit(random) * (float) textures.size()) % (uint32_t) textures.size();
+        }
+
+        // polygons take absolute vertices
+        if (type == PrimitiveType::Polygon) {
+            m_polygonVertices.reserve((size_t) count * s_polygonVertices);
+            for (const Instance &instance : m_instances) {
+                for (int v = 0; v < s_polygonVertices; v++) {
+                    float angle = instance.rotation + (float) v / s_polygonVertices * 6.2831853f;
+                    m_polygonVertices.emplace_back(instance.position.x + size * 0.5f * std::cos(angle),
+                                                   instance.position.y + size * 0.5f * std::sin(angle), 0.f);
+                }
+            }
+        }
+    }
+
+    void draw() const {
+        glm::vec2 size(m_size);
+        for (size_t i = 0; i < m_instances.size(); i++) {
+            const Instance &instance = m_instances[i];
+            switch (m_type) {
+                case PrimitiveType::Quad:
+                    Renderer2D::drawQuad(instance.position, size, instance.color);
+                    break;
+                case PrimitiveType::RotatedQuad:
+                    Renderer2D::drawRotatedQuad(instance.position, size, instance.color, instance.rotation);
+                    break;
+                case PrimitiveType::TexturedQuad:
+                    Renderer2D::drawQuad(instance.position, size, m_textures[instance.texture], 1.f, instance.color);
+                    break;
+                case PrimitiveType::Circle:
+                    Renderer2D::drawCircle(instance.position, m_size * 0.5f, s_circleVertices, instance.color);
+                    break;
+                case PrimitiveType::Line: {
+                    glm::vec2 direction(std::cos(instance.rotation), std::sin(instance.rotation));
+                    Renderer2D::drawLine(instance.position, instance.position + direction * m_size * 2.f, 1.f, instance.color);
+                    break;
+                }
+                case PrimitiveType::Polygon:
+                    Renderer2D::drawPolygon(&m_polygonVertices[i * s_polygonVertices], s_polygonVertices, instance.color);
+                    break;
+            }
+        }
+    }
+private:
+    struct Instance {
+        glm::vec2 position;
+        glm::vec4 color;
+        float rotation;
+        uint32_t texture;
+    };
+
+    PrimitiveType m_type;
+    float m_size;
+    const std::vector<Ref<Texture>> &m_textures;
+    std::vector<Instance> m_instances;
+    std::vector<glm::vec3> m_polygonVertices;
+};
+
+class StressRunner {
+public:
+    StressRunner(Window &window, const StressSettings &settings, bool &closed)
+        : m_window(window), m_settings(settings), m_closed(closed) {
+        m_aspect = (float) window.getWidth() / (float) window.getHeight();
+    }
+
+    // frames are timed from clear to the end of the swap, with vsync off the driver queues a few frames at most,
+    // so over the measured frames the CPU and GPU costs both show. A headless swap only flushes and nothing
+    // paces the GPU, those frames wait for it to finish
+    StepResult runStep(PrimitiveType type, uint32_t count, const std::vector<Ref<Texture>> &textures) {
+        StressScene scene(type, count, m_settings.size, m_aspect, textures);
+        OrthographicCamera camera(-m_aspect, m_aspect, -1.f, 1.f);
+
+        StepResult result;
+        result.count = count;
+        FrameHistogram frameTime(m_settings.frames);
+        for (uint32_t frame = 0; frame < m_settings.warmupFrames + m_settings.frames && !m_closed; frame++) {
+            FrameStats::Clock::time_point start = FrameStats::Clock::now();
+            Renderer2D::resetStats();
+
+            RenderCommand::setClearColor({ 0.1f, 0.1f, 0.1f, 1.f });
+            RenderCommand::clear();
+            Renderer2D::beginScene(camera);
+            scene.draw();
+            Renderer2D::endScene();
+            m_window.onUpdate();
+            if (m_settings.headless)
+                RenderCommand::finish();
+
+            if (frame >= m_settings.warmupFrames)
+                frameTime.add(FrameStats::elapsedMilliseconds(start));
+            result.drawCalls = Renderer2D::getStats().drawCalls;
+        }
+        result.frameTime = frameTime.getSummary();
+        return result;
+    }
+
+    bool holdsTarget(const StepResult &step) const {
+        return step.frameTime.samples && step.frameTime.p95 <= m_settings.targetMs;
+    }
+
+    StressResult ramp(PrimitiveType type, const std::string &backend, const std::vector<Ref<Texture>> &textures) {
+        StressResult result;
+        result.type = type;
+        result.backend = backend;
+        uint32_t count = m_settings.startCount;
+        uint32_t failedCount = 0;
+        while (!m_closed) {
+            StepResult step = runStep(type, count, textures);
+            log(type, step);
+            if (!holdsTarget(step)) {
+                failedCount = count;
+                break;
+            }
+            result.sustained = step;
+            if (count >= m_settings.maxCount) {
+                result.capped = true;
+                break;
+            }
+            // in double, a large --max times the factor doesn't fit in 32 bits
+            double grown = std::min((double) count * m_settings.growth, (double) m_settings.maxCount);
+            count = std::min(m_settings.maxCount, std::max(count + 1, (uint32_t) grown));
+        }
+
+        // bisect between the last count that held and the one that didn't
+        uint32_t low = result.sustained.count, high = failedCount;
+        for (uint32_t i = 0; i < m_settings.refineSteps && high > low + 1 && !m_closed; i++) {
+            uint32_t middle = low + (high - low) / 2;
+            StepResult step = runStep(type, middle, textures);
+            log(type, step);
+            if (holdsTarget(step)) {
+                result.sustained = step;
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        return result;
+    }
+private:
+    void log([[maybe_unused]] PrimitiveType type, [[maybe_unused]] const StepResult &step) const {
+        DM_CORE_TRACE("  {0} x{1}: p95 {2:.2f} ms, mean {3:.2f} ms, {4} draw calls", s_typeNames[(int) type], step.count,
+                      step.frameTime.p95, step.frameTime.mean, step.drawCalls);
+    }
+private:
+    Window &m_window;
+    const StressSettings &m_settings;
+    bool &m_closed;
+    float m_aspect;
+};
+
+static double primitivesPerSecond(const StepResult &step) {
+    return step.frameTime.mean > 0.f ? (double) step.count * 1000.0 / step.frameTime.mean : 0.0;
+}
+
+static bool writeJson(const std::string &path, const StressSettings &settings, const std::vector<StressResult> &results) {
+    std::ofstream out(path);
+    if (!out) {
+        DM_CORE_ERROR("Could not open '{0}' for writing", path);
+        return false;
+    }
+
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    char line[512];
+    std::snprintf(line, sizeof(line),
+                  "{\n  \"context\": {\"date\": \"%s\", \"api\": \"OpenGL\", \"targetMs\": %.3f, \"frames\": %u, "
+                  "\"textures\": %u, \"size\": %.4f, \"headless\": %s},\n  \"results\": [\n",
+                  date, settings.targetMs, settings.frames, settings.textureCount, settings.size,
+                  settings.headless ? "true" : "false");
+    out << line;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const StressResult &result = results[i];
+        const StepResult &step = result.sustained;
+        std::snprintf(line, sizeof(line),
+                      "    {\"type\": \"%s\", \"backend\": \"%s\", \"perFrame\": %u, \"perSecond\": %.0f, \"capped\": %s, "
+                      "\"p50\": %.3f, \"p95\": %.3f, \"mean\": %.3f, \"drawCalls\": %u}%s\n",
+                      s_typeNames[(int) result.type], result.backend.c_str(), step.count, primitivesPerSecond(step),
+                      result.capped ? "true" : "false", step.frameTime.p50, step.frameTime.p95, step.frameTime.mean,
+                      step.drawCalls, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return (bool) out;
+}
+
+static bool parseTypes(const char *list, std::vector<PrimitiveType> &types) {
+    std::string text = list;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = std::min(text.find(',', start), text.size());
+        std::string name = text.substr(start, end - start);
+        auto it = std::find_if(std::begin(s_typeNames), std::end(s_typeNames), [&](const char *typeName) { return name == typeName; });
+        if (it == std::end(s_typeNames))
+            return false;
+        types.push_back((PrimitiveType) (it - std::begin(s_typeNames)));
+        start = end + 1;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Deimos::Log::init();
+
+    StressSettings settings;
+    std::string backend = "all";
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--target-ms") && i + 1 < argc) {
+            settings.targetMs = std::max(0.1f, std::strtof(argv[++i], nullptr));
+        } else if (!std::strcmp(argv[i], "--start") && i + 1 < argc) {
+            settings.startCount = std::max(1u, (uint32_t) std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--max") && i + 1 < argc) {
+            settings.maxCount = std::max(1u, (uint32_t) std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--growth") && i + 1 < argc) {
+            settings.growth = std::max(1.05f, std::strtof(argv[++i], nullptr));
+        } else if (!std::strcmp(argv[i], "--refine") && i + 1 < argc) {
+            settings.refineSteps = (uint32_t) std::strtoul(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) {
+            settings.frames = std::max(1u, (uint32_t) std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--warmup") && i + 1 < argc) {
+            settings.warmupFrames = (uint32_t) std::strtoul(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--textures") && i + 1 < argc) {
+            settings.textureCount = std::max(1u, (uint32_t) std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--size") && i + 1 < argc) {
+            settings.size = std::max(0.001f, std::strtof(argv[++i], nullptr));
+        } else if (!std::strcmp(argv[i], "--types") && i + 1 < argc) {
+            if (!parseTypes(argv[++i], settings.types)) {
+                printUsage();
+                return 1;
+            }
+        } else if (!std::strcmp(argv[i], "--backend") && i + 1 < argc) {
+            backend = argv[++i];
+        } else if (!std::strcmp(argv[i], "--headless")) {
+            settings.headless = true;
+        } else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) {
+            settings.outPath = argv[++i];
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (settings.types.empty()) {
+        for (uint32_t i = 0; i < s_typeCount; i++)
+            settings.types.push_back((PrimitiveType) i);
+    }
+    settings.startCount = std::min(settings.startCount, settings.maxCount);
+
+    bool closed = false;
+    Scope<Window> window(Window::create(WindowProps("DeimosStress", 1280, 720, settings.headless)));
+    window->setEventCallback([&closed](Event &e) {
+        if (e.getEventType() == EventType::WindowsClose)
+            closed = true;
+    });
+    window->setVSync(false);
+    Renderer::init();
+
+    if (backend == "slots" || backend == "all")
+        settings.backends.push_back(false);
+    if ((backend == "bindless" || backend == "all") && RenderCommand::hasBindlessTextures())
+        settings.backends.push_back(true);
+    if (settings.backends.empty()) {
+        DM_CORE_ERROR("No texture backend to run, bindless textures are {0}supported",
+                      RenderCommand::hasBindlessTextures() ? "" : "not ");
+        return 1;
+    }
+
+    StressRunner runner(*window, settings, closed);
+    std::vector<StressResult> results;
+    for (bool bindless : settings.backends) {
+        Renderer2D::init(bindless);
+        std::string backendName = Renderer2D::usesBindlessTextures() ? "OpenGL bindless" : "OpenGL slots";
+
+        // small distinct textures, so the batch is bound by slots rather than bandwidth
+        std::vector<Ref<Texture>> textures;
+        for (uint32_t t = 0; t < settings.textureCount; t++) {
+            Ref<Texture2D> texture = Texture2D::create(4, 4);
+            std::vector<uint32_t> pixels(16, 0xff000000u | (t * 0x9E3779u & 0xffffffu));
+            texture->setData(pixels.data(), (uint32_t) (pixels.size() * sizeof(uint32_t)));
+            textures.push_back(texture);
+        }
+
+        for (PrimitiveType type : settings.types) {
+            if (closed)
+                break;
+            DM_CORE_INFO("{0}, {1}: ramping from {2}", backendName, s_typeNames[(int) type], settings.startCount);
+            results.push_back(runner.ramp(type, backendName, textures));
+        }
+
+        textures.clear();
+        Renderer2D::shutdown();
+    }
+    Renderer::shutdown();
+
+    std::printf("\nsustained at p95 <= %.2f ms\n", settings.targetMs);
+    std::printf("%-10s %-16s %12s %16s %10s %10s %10s\n", "primitive", "backend", "per frame", "per second", "p95 ms",
+                "mean ms", "draws");
+    for (const StressResult &result : results) {
+        const StepResult &step = result.sustained;
+        std::printf("%-10s %-16s %11u%s %16.0f %10.2f %10.2f %10u\n", s_typeNames[(int) result.type],
+                    result.backend.c_str(), step.count, result.capped ? "+" : " ", primitivesPerSecond(step),
+                    step.frameTime.p95, step.frameTime.mean, step.drawCalls);
+    }
+    if (std::any_of(results.begin(), results.end(), [](const StressResult &result) { return result.capped; }))
+        std::printf("+ still held the target at --max\n");
+
+    return writeJson(settings.outPath, settings, results) ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+#include "BlockEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace Deimos {
+    static inline uint16_t to565(const float color[3]) {
+        auto quantize = [](float value, int max) {
+            return (uint16_t) std::clamp((int) (value / 255.f * max + 0.5f), 0, max);
+        };
+        return (uint16_t) ((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+    }
+
+    static inline void from565(uint16_t color, int out[3]) {
+        int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+        out[0] = (r << 3) | (r >> 2);
+        out[1] = (g << 2) | (g >> 4);
+        out[2] = (b << 3) | (b >> 2);
+    }
+
+    // range fit: the endpoints are the extremes of the pixels projected on their principal axis
+    static void encodeColorBlock(const uint8_t rgba[64], bool allowTransparent, uint8_t out[8]) {
+        bool transparent[16];
+        bool anyTransparent = false;
+        int opaqueCount = 0;
+        float mean[3] = {};
+        for (int i = 0; i < 16; ++i) {
+            transparent[i] = allowTransparent && rgba[i * 4 + 3] < 128;
+            anyTransparent |= transparent[i];
+            if (transparent[i])
+                continue;
+            for (int c = 0; c < 3; ++c)
+                mean[c] += rgba[i * 4 + c];
+            ++opaqueCount;
+        }
+
+        if (opaqueCount == 0) {
+            // equal endpoints select the 3 color mode, index 3 is transparent black
+            memset(out, 0, 4);
+            memset(out + 4, 0xFF, 4);
+            return;
+        }
+        for (float &value : mean)
+            value /= (float) opaqueCount;
+
+        float covariance[6] = {}; // rr rg rb gg gb bb
+        for (int i = 0; i < 16; ++i) {
+            if (transparent[i])
+                continue;
+            float d[3] = { rgba[i * 4] - mean[0], rgba[i * 4 + 1] - mean[1], rgba[i * 4 + 2] - mean[2] };
+            covariance[0] += d[0] * d[0]; covariance[1] += d[0] * d[1]; covariance[2] += d[0] * d[2];
+            covariance[3] += d[1] * d[1]; covariance[4] += d[1] * d[2]; covariance[5] += d[2] * d[2];
+        }
+
+        float axis[3] = { 1.f, 1.f, 1.f };
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            float next[3] = {
+                covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+            };
+            float length = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+            if (length < 1e-6f)
+                break; // flat block, any axis does
+            for (int c = 0; c < 3; ++c)
+                axis[c] = next[c] / length;
+        }
+
+        float minProjection = 1e30f, maxProjection = -1e30f;
+        for (int i = 0; i < 16; ++i) {
+            if (transparent[i])
+                continue;
+            float projection = (rgba[i * 4] - mean[0]) * axis[0] + (rgba[i * 4 + 1] - mean[1]) * axis[1]
+                               + (rgba[i * 4 + 2] - mean[2]) * axis[2];
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+
+        float axisLength = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        float high[3], low[3];
+        for (int c = 0; c < 3; ++c) {
+            high[c] = mean[c] + axis[c] * maxProjection / axisLength;
+            low[c] = mean[c] + axis[c] * minProjection / axisLength;
+        }
+
+        uint16_t color0 = to565(high), color1 = to565(low);
+        // 4 color mode needs color0 > color1, the 3 color mode (with transparency) color0 <= color1
+        if (anyTransparent ? color0 > color1 : color0 < color1)
+            std::swap(color0, color1);
+
+        int palette[4][3];
+        from565(color0, palette[0]);
+        from565(color1, palette[1]);
+        int paletteSize = 4;
+        if (anyTransparent || color0 == color1) {
+            for (int c = 0; c < 3; ++c)
+                palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            paletteSize = 3;
+        } else {
+            for (int c = 0; c < 3; ++c) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+        }
+
+        uint32_t indices = 0;
+        for (int i = 0; i < 16; ++i) {
+            uint32_t best = 3;
+            if (!transparent[i]) {
+                int bestDistance = INT32_MAX;
+                for (int p = 0; p < paletteSize; ++p) {
+                    int dr = rgba[i * 4] - palette[p][0], dg = rgba[i * 4 + 1] - palette[p][1], db = rgba[i * 4 + 2] - palette[p][2];
+                    int distance = dr * dr + dg * dg + db * db;
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = (uint32_t) p;
+                    }
+                }
+            }
+            indices |= best << (i * 2);
+        }
+
+        memcpy(out, &color0, 2);
+        memcpy(out + 2, &color1, 2);
+        memcpy(out + 4, &indices, 4);
+    }
+
+    void encodeBC1Block(const uint8_t rgba[64], uint8_t out[8]) {
+        encodeColorBlock(rgba, true, out);
+    }
+
+    void encodeBC3Block(const uint8_t rgba[64], uint8_t out[16]) {
+        uint8_t alpha0 = 0, alpha1 = 255;
+        for (int i = 0; i < 16; ++i) {
+            alpha0 = std::max(alpha0, rgba[i * 4 + 3]);
+            alpha1 = std::min(alpha1, rgba[i * 4 + 3]);
+        }
+
+        // alpha0 > alpha1 selects 8 interpolated values
+        int palette[8] = { alpha0, alpha1 };
+        for (int i = 2; i < 8; ++i)
+            palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+
+        uint64_t indices = 0;
+        if (alpha0 != alpha1) {
+            for (int i = 0; i < 16; ++i) {
+                uint64_t best = 0;
+                int bestDistance = 256;
+                for (int p = 0; p < 8; ++p) {
+                    int distance = std::abs(rgba[i * 4 + 3] - palette[p]);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = (uint64_t) p;
+                    }
+                }
+                indices |= best << (i * 3);
+            }
+        }
+
+        out[0] = alpha0;
+        out[1] = alpha1;
+        for (int i = 0; i < 6; ++i)
+            out[2 + i] = (uint8_t) (indices >> (i * 8));
+
+        encodeColorBlock(rgba, false, out + 8);
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef ENGINE_BLOCKENCODER_H
+#define ENGINE_BLOCKENCODER_H
+
+#include <cstdint>
+
+namespace Deimos {
+    // Block compression encoders of the texture encoder tool. Input is a 4x4 block of RGBA pixels, row by row
+    // (the first row is the bottom one, like the rest of the engine's image data)
+
+    // BC1 (DXT1), pixels with alpha below 128 become transparent, 8 bytes of output
+    void encodeBC1Block(const uint8_t rgba[64], uint8_t out[8]);
+    // BC3 (DXT5), interpolated alpha and an opaque BC1 color block, 16 bytes of output
+    void encodeBC3Block(const uint8_t rgba[64], uint8_t out[16]);
+}
+
+
+#endif //ENGINE_BLOCKENCODER_H
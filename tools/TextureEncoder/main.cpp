@@ -0,0 +1,122 @@
+// Offline texture encoder: converts images into KTX2 / DDS containers that Texture2D uploads without decoding.
+// Encodes BC1 and BC3 (and plain RGBA8), BC7 and ETC2 containers from other encoders are loaded but not produced here
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+#include "Deimos/Core/Log.h"
+#include "Deimos/Core/JobSystem.h"
+#include "Deimos/Renderer/CompressedImage.h"
+#include "Deimos/Renderer/MipmapGenerator.h"
+
+#include "BlockEncoder.h"
+
+using namespace Deimos;
+
+static void printUsage() {
+    std::printf("usage: DeimosTextureEncoder [--format bc1|bc3|rgba8] [--mipmaps] <input image> <output.ktx2|output.dds>\n"
+                "  bc3 is the default, --mipmaps stores a full chain built with a box filter. Rows are written bottom\n"
+                "  first as the engine uploads them, DDS files from other tools are top-down and load upside down\n");
+}
+
+// one level into blocks, edge blocks repeat the last row / column
+static std::vector<uint8_t> encodeLevel(const Image& level, TextureFormat format) {
+    if (format == TextureFormat::RGBA8)
+        return std::vector<uint8_t>(level.getData(), level.getData() + level.getSize());
+
+    const uint32_t width = level.getWidth(), height = level.getHeight();
+    const uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    const uint32_t blockSize = CompressedImage::getBlockSize(format);
+    std::vector<uint8_t> out((size_t) blocksX * blocksY * blockSize);
+
+    JobSystem::parallelFor(blocksY, [&](uint32_t begin, uint32_t end) {
+        uint8_t block[64];
+        for (uint32_t by = begin; by < end; ++by) {
+            for (uint32_t bx = 0; bx < blocksX; ++bx) {
+                for (uint32_t y = 0; y < 4; ++y) {
+                    uint32_t sy = std::min(by * 4 + y, height - 1);
+                    for (uint32_t x = 0; x < 4; ++x) {
+                        uint32_t sx = std::min(bx * 4 + x, width - 1);
+                        memcpy(block + (y * 4 + x) * 4, level.getData() + ((size_t) sy * width + sx) * 4, 4);
+                    }
+                }
+
+                uint8_t *dst = out.data() + ((size_t) by * blocksX + bx) * blockSize;
+                if (format == TextureFormat::BC1)
+                    encodeBC1Block(block, dst);
+                else
+                    encodeBC3Block(block, dst);
+            }
+        }
+    }, 4);
+    return out;
+}
+
+int main(int argc, char **argv) {
+    Log::init();
+
+    TextureFormat format = TextureFormat::BC3;
+    bool mipmaps = false;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--format") && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (name == "bc1") format = TextureFormat::BC1;
+            else if (name == "bc3") format = TextureFormat::BC3;
+            else if (name == "rgba8") format = TextureFormat::RGBA8;
+            else {
+                std::fprintf(stderr, "unknown format '%s'\n", name.c_str());
+                return 1;
+            }
+        } else if (!std::strcmp(argv[i], "--mipmaps")) {
+            mipmaps = true;
+        } else if (argv[i][0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            positional.emplace_back(argv[i]);
+        }
+    }
+
+    if (positional.size() != 2 || !CompressedImage::isContainer(positional[1])) {
+        printUsage();
+        return 1;
+    }
+
+    // bottom row first, the blocks are uploaded as stored
+    Image base = Image::load(positional[0]);
+    if (!base.isValid()) {
+        std::fprintf(stderr, "could not load '%s'\n", positional[0].c_str());
+        return 1;
+    }
+    base.expandToRGBA(); // the same conversion the runtime loader applies
+
+    JobSystem::init();
+    std::vector<Image> mips;
+    if (mipmaps)
+        mips = MipmapGenerator::generate(base);
+
+    CompressedImage result(format, base.getWidth(), base.getHeight());
+    std::vector<uint8_t> level = encodeLevel(base, format);
+    result.addLevel(level.data(), level.size());
+    for (const Image &mip : mips) {
+        level = encodeLevel(mip, format);
+        result.addLevel(level.data(), level.size());
+    }
+    JobSystem::shutdown();
+
+    const std::string &output = positional[1];
+    bool ktx2 = output.size() >= 5 && (output.compare(output.size() - 5, 5, ".ktx2") == 0 || output.compare(output.size() - 5, 5, ".KTX2") == 0);
+    if (!(ktx2 ? result.writeKTX2(output) : result.writeDDS(output))) {
+        std::fprintf(stderr, "could not write '%s'\n", output.c_str());
+        return 1;
+    }
+
+    std::printf("%s: %ux%u, %u level(s), %zu bytes\n", output.c_str(), result.getWidth(), result.getHeight(),
+                result.getLevelCount(), result.getSize());
+    return 0;
+}